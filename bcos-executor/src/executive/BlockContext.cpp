@@ -62,6 +62,14 @@ BlockContext::BlockContext(std::shared_ptr<storage::StateStorageInterface> stora
         _current->version(), _schedule, _isWasm, _isAuthCheck)
 {}
 
+BlockContext::Ptr BlockContext::fork(std::shared_ptr<storage::StateStorageInterface> storage) const
+{
+    auto blockContext = std::make_shared<BlockContext>(std::move(storage), m_hashImpl,
+        m_blockNumber, m_blockHash, m_timeStamp, m_blockVersion, m_schedule, m_isWasm,
+        m_isAuthCheck);
+    blockContext->setTxGasLimit(m_txGasLimit);
+    return blockContext;
+}
 
 ExecutiveFlowInterface::Ptr BlockContext::getExecutiveFlow(std::string codeAddress)
 {
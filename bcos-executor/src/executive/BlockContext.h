@@ -62,6 +62,10 @@ public:
         const protocol::Transaction::ConstPtr& _tx)>;
     virtual ~BlockContext(){};
 
+    // the context of the same block over another state, such as the private state of an
+    // optimistic transaction
+    BlockContext::Ptr fork(std::shared_ptr<storage::StateStorageInterface> storage) const;
+
     std::shared_ptr<storage::StateStorageInterface> storage() { return m_storage; }
 
     uint64_t txGasLimit() const { return m_txGasLimit; }
@@ -0,0 +1,163 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the read set of an optimistically executed transaction
+ * @file ReadSetStorage.h
+ * @date: 2022-08-08
+ */
+
+#pragma once
+
+#include "bcos-framework/interfaces/storage/Common.h"
+#include "bcos-framework/interfaces/storage/StorageInterface.h"
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <variant>
+
+namespace bcos::executor
+{
+/**
+ * the prev storage of the private state of an optimistic transaction, forwards the reads to the
+ * block state and records the keys read, the rows written by the transaction stay in its private
+ * state; the transaction is serializable after the committed ones if none of the keys it read are
+ * written by them, a primary key query reads the whole table
+ */
+class ReadSetStorage : public virtual storage::StorageInterface
+{
+public:
+    using Ptr = std::shared_ptr<ReadSetStorage>;
+    // table => keys
+    using KeySet = std::map<std::string, std::set<std::string, std::less<>>, std::less<>>;
+
+    explicit ReadSetStorage(storage::StorageInterface::Ptr prev) : m_prev(std::move(prev)) {}
+    ReadSetStorage(const ReadSetStorage&) = delete;
+    ReadSetStorage& operator=(const ReadSetStorage&) = delete;
+
+    void asyncGetPrimaryKeys(std::string_view table,
+        const std::optional<storage::Condition const>& _condition,
+        std::function<void(Error::UniquePtr, std::vector<std::string>)> _callback) override
+    {
+        readTable(table);
+        m_prev->asyncGetPrimaryKeys(table, _condition, std::move(_callback));
+    }
+
+    void asyncGetPrimaryKeyPage(std::string_view table,
+        const std::optional<storage::Condition const>& _condition, std::string_view _cursor,
+        size_t _limit,
+        std::function<void(Error::UniquePtr, std::vector<std::string>)> _callback) override
+    {
+        readTable(table);
+        m_prev->asyncGetPrimaryKeyPage(table, _condition, _cursor, _limit, std::move(_callback));
+    }
+
+    void asyncGetRow(std::string_view table, std::string_view _key,
+        std::function<void(Error::UniquePtr, std::optional<storage::Entry>)> _callback) override
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            readKey(table, _key);
+        }
+        m_prev->asyncGetRow(table, _key, std::move(_callback));
+    }
+
+    void asyncGetRows(std::string_view table,
+        const std::variant<const gsl::span<std::string_view const>,
+            const gsl::span<std::string const>>& _keys,
+        std::function<void(Error::UniquePtr, std::vector<std::optional<storage::Entry>>)>
+            _callback) override
+    {
+        std::visit(
+            [this, &table](auto&& keys) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                for (auto const& key : keys)
+                {
+                    readKey(table, key);
+                }
+            },
+            _keys);
+        m_prev->asyncGetRows(table, _keys, std::move(_callback));
+    }
+
+    void asyncSetRow(std::string_view, std::string_view, storage::Entry,
+        std::function<void(Error::UniquePtr)> callback) override
+    {
+        // the private state of the transaction holds the writes
+        callback(BCOS_ERROR_UNIQUE_PTR(
+            storage::StorageError::ReadOnly, "Try to write the block state optimistically"));
+    }
+
+    // some keys read are written by the committed transactions
+    bool conflictWith(KeySet const& _written) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto const& table : m_readTables)
+        {
+            if (_written.count(table))
+            {
+                return true;
+            }
+        }
+        for (auto const& [table, keys] : m_readKeys)
+        {
+            auto it = _written.find(table);
+            if (it == _written.end())
+            {
+                continue;
+            }
+            for (auto const& key : keys)
+            {
+                if (it->second.count(key))
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+private:
+    void readTable(std::string_view table)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_readTables.lower_bound(table);
+        if (it == m_readTables.end() || *it != table)
+        {
+            m_readTables.emplace_hint(it, table);
+        }
+    }
+
+    void readKey(std::string_view table, std::string_view key)
+    {
+        auto it = m_readKeys.lower_bound(table);
+        if (it == m_readKeys.end() || it->first != table)
+        {
+            it = m_readKeys.emplace_hint(it, std::string(table), KeySet::mapped_type());
+        }
+        auto keyIt = it->second.lower_bound(key);
+        if (keyIt == it->second.end() || *keyIt != key)
+        {
+            it->second.emplace_hint(keyIt, key);
+        }
+    }
+
+    storage::StorageInterface::Ptr m_prev;
+    mutable std::mutex m_mutex;
+    KeySet m_readKeys;
+    std::set<std::string, std::less<>> m_readTables;
+};
+}  // namespace bcos::executor
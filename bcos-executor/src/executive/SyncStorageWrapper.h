@@ -58,10 +58,40 @@ public:
         return std::move(keys);
     }
 
+    std::vector<std::string> getPrimaryKeyPage(const std::string_view& table,
+        const std::optional<storage::Condition const>& _condition, std::string_view _cursor,
+        size_t _limit)
+    {
+        GetPrimaryKeysReponse value;
+        m_storage->asyncGetPrimaryKeyPage(
+            table, _condition, _cursor, _limit, [&value](auto&& error, auto&& keys) mutable {
+                value = {std::move(error), std::move(keys)};
+            });
+
+        // After coroutine switch, set the recoder
+        setRecoder(m_recoder);
+
+        auto& [error, keys] = value;
+
+        if (error)
+        {
+            BOOST_THROW_EXCEPTION(*error);
+        }
+
+        return std::move(keys);
+    }
+
     std::optional<storage::Entry> getRow(
         const std::string_view& table, const std::string_view& _key)
     {
-        acquireKeyLock(_key);
+        return getRow(table, _key, _key);
+    }
+
+    // read the row under the key lock of another key, the rows must be written together
+    std::optional<storage::Entry> getRow(const std::string_view& table,
+        const std::string_view& _key, const std::string_view& _lockKey)
+    {
+        acquireKeyLock(_lockKey);
 
         GetRowResponse value;
         m_storage->asyncGetRow(table, _key, [&value](auto&& error, auto&& entry) mutable {
@@ -595,9 +595,9 @@ CallParameters::UniquePtr TransactionExecutive::go(
                 vmKind = VMKind::BcosWasm;
             }
 
-            auto vm = VMFactory::create(vmKind);
+            auto vm = VMFactory::acquire(vmKind);
 
-            auto ret = vm.exec(hostContext, mode, &evmcMessage, code.data(), code.size());
+            auto ret = vm->exec(hostContext, mode, &evmcMessage, code.data(), code.size());
 
             auto callResults = hostContext.takeCallParameters();
             // clear unnecessary logs
@@ -707,8 +707,8 @@ CallParameters::UniquePtr TransactionExecutive::go(
         }
         else
         {
-            auto codeEntry = hostContext.code();
-            if (!codeEntry.has_value())
+            auto cachedCode = hostContext.cachedCode();
+            if (!cachedCode)
             {
                 revert();
                 auto callResult = hostContext.takeCallParameters();
@@ -720,7 +720,7 @@ CallParameters::UniquePtr TransactionExecutive::go(
                                      << LOG_KV("sender", callResult->senderAddress);
                 return callResult;
             }
-            auto code = codeEntry->get();
+            std::string_view code = *cachedCode;
             if (hasPrecompiledPrefix(code))
             {
                 return callDynamicPrecompiled(hostContext.takeCallParameters(), std::string(code));
@@ -731,11 +731,11 @@ CallParameters::UniquePtr TransactionExecutive::go(
             {
                 vmKind = VMKind::BcosWasm;
             }
-            auto vm = VMFactory::create(vmKind);
+            auto vm = VMFactory::acquire(vmKind);
 
             auto mode = toRevision(hostContext.vmSchedule());
             auto evmcMessage = getEVMCMessage(*blockContext, hostContext);
-            auto ret = vm.exec(hostContext, mode, &evmcMessage,
+            auto ret = vm->exec(hostContext, mode, &evmcMessage,
                 reinterpret_cast<const byte*>(code.data()), code.size());
 
             auto callResults = hostContext.takeCallParameters();
@@ -29,6 +29,7 @@
 #include "../executive/BlockContext.h"
 #include "../executive/ExecutiveFactory.h"
 #include "../executive/ExecutiveStackFlow.h"
+#include "../executive/ReadSetStorage.h"
 #include "../executive/TransactionExecutive.h"
 #include "../precompiled/ConsensusPrecompiled.h"
 #include "../precompiled/CryptoPrecompiled.h"
@@ -43,6 +44,7 @@
 #include "../precompiled/extension/GroupSigPrecompiled.h"
 #include "../precompiled/extension/RingSigPrecompiled.h"
 #include "../precompiled/extension/UserPrecompiled.h"
+#include "../vm/CodeCache.h"
 #include "../vm/Precompiled.h"
 #include "../vm/gas_meter/GasInjector.h"
 #include "ExecuteOutputs.h"
@@ -121,7 +123,10 @@ TransactionExecutor::TransactionExecutor(bcos::ledger::LedgerInterface::Ptr ledg
     m_keyPageIgnoreTables(keyPageIgnoreTables)
 {
     assert(m_backendStorage);
-
+    if (m_keyPageSize > 0)
+    {
+        m_keyPageStatistics = std::make_shared<storage::KeyPageStatistics>(m_keyPageSize);
+    }
 
     GlobalHashImpl::g_hashImpl = m_hashImpl;
     m_abiCache = make_shared<ClockCache<bcos::bytes, FunctionAbi>>(32);
@@ -700,14 +705,8 @@ void TransactionExecutor::dmcExecuteTransactions(std::string contractAddress,
                 auto prepareT = utcTime() - recordT;
                 recordT = utcTime();
 
-                auto executiveFlow = getExecutiveFlow(m_blockContext, contractAddress);
-                executiveFlow->submit(callParametersList);
-
-                asyncExecuteExecutiveFlow(executiveFlow,
-                    [callback = std::move(callback)](bcos::Error::UniquePtr&& error,
-                        std::vector<bcos::protocol::ExecutionMessage::UniquePtr>&& messages) {
-                        callback(std::move(error), std::move(messages));
-                    });
+                dmcExecuteTransactionsInternal(
+                    contractAddress, std::move(callParametersList), std::move(callback));
 
                 EXECUTOR_NAME_LOG(INFO)
                     << LOG_DESC("dmcExecuteTransactionsInternal after fillblock")
@@ -717,20 +716,197 @@ void TransactionExecutor::dmcExecuteTransactions(std::string contractAddress,
     }
     else
     {
-        auto executiveFlow = getExecutiveFlow(m_blockContext, contractAddress);
-        executiveFlow->submit(callParametersList);
-
-        asyncExecuteExecutiveFlow(executiveFlow,
-            [callback = std::move(callback)](bcos::Error::UniquePtr&& error,
-                std::vector<bcos::protocol::ExecutionMessage::UniquePtr>&& messages) {
-                callback(std::move(error), std::move(messages));
-            });
+        dmcExecuteTransactionsInternal(
+            contractAddress, std::move(callParametersList), std::move(callback));
     }
 
     EXECUTOR_NAME_LOG(TRACE) << LOG_DESC("dmcExecuteTransactions") << LOG_KV("prepareT", prepareT)
                              << LOG_KV("total", (utcTime() - recoredT));
 }
 
+void TransactionExecutor::dmcExecuteTransactionsInternal(const std::string& contractAddress,
+    std::shared_ptr<std::vector<CallParameters::UniquePtr>> callParametersList,
+    std::function<void(
+        bcos::Error::UniquePtr, std::vector<bcos::protocol::ExecutionMessage::UniquePtr>)>
+        callback)
+{
+    auto optimisticOutputs = std::make_shared<std::vector<ExecutionMessage::UniquePtr>>();
+    // the first batch of the contract in the block, no transaction of it is paused
+    if (m_optimisticExecution && !m_blockContext->getExecutiveFlow(contractAddress))
+    {
+        try
+        {
+            *optimisticOutputs = optimisticExecuteTransactions(*callParametersList);
+        }
+        catch (std::exception& e)
+        {
+            EXECUTOR_NAME_LOG(ERROR) << LOG_BADGE("optimisticExecute")
+                                     << LOG_DESC("commit the transactions failed")
+                                     << LOG_KV("contract", contractAddress)
+                                     << LOG_KV("EINFO", boost::diagnostic_information(e));
+            callback(BCOS_ERROR_WITH_PREV_UNIQUE_PTR(ExecuteError::EXECUTE_ERROR,
+                         "Optimistic execution commit failed", e),
+                {});
+            return;
+        }
+        if (callParametersList->empty())
+        {
+            callback(nullptr, std::move(*optimisticOutputs));
+            return;
+        }
+    }
+
+    auto executiveFlow = getExecutiveFlow(m_blockContext, contractAddress);
+    executiveFlow->submit(callParametersList);
+
+    asyncExecuteExecutiveFlow(executiveFlow,
+        [optimisticOutputs, callback = std::move(callback)](bcos::Error::UniquePtr&& error,
+            std::vector<bcos::protocol::ExecutionMessage::UniquePtr>&& messages) {
+            if (!error && !optimisticOutputs->empty())
+            {
+                messages.insert(messages.begin(),
+                    std::make_move_iterator(optimisticOutputs->begin()),
+                    std::make_move_iterator(optimisticOutputs->end()));
+            }
+            callback(std::move(error), std::move(messages));
+        });
+}
+
+// the request of a transaction, the speculation consumes a copy so that it can be re-executed
+static CallParameters::UniquePtr copyRequest(const CallParameters& input)
+{
+    auto callParameters = std::make_unique<CallParameters>(input.type);
+    callParameters->contextID = input.contextID;
+    callParameters->seq = input.seq;
+    callParameters->senderAddress = input.senderAddress;
+    callParameters->codeAddress = input.codeAddress;
+    callParameters->receiveAddress = input.receiveAddress;
+    callParameters->origin = input.origin;
+    callParameters->gas = input.gas;
+    callParameters->data = input.data;
+    callParameters->abi = input.abi;
+    callParameters->keyLocks = input.keyLocks;
+    callParameters->createSalt = input.createSalt;
+    callParameters->staticCall = input.staticCall;
+    callParameters->create = input.create;
+    callParameters->internalCreate = input.internalCreate;
+    callParameters->internalCall = input.internalCall;
+    return callParameters;
+}
+
+TransactionExecutor::Speculation TransactionExecutor::speculate(const CallParameters& input)
+{
+    Speculation speculation;
+    speculation.readSet = std::make_shared<ReadSetStorage>(m_blockContext->storage());
+    speculation.state = std::make_shared<storage::StateStorage>(speculation.readSet);
+    speculation.blockContext = m_blockContext->fork(speculation.state);
+    speculation.executive = createExecutive(
+        speculation.blockContext, input.codeAddress, input.contextID, input.seq);
+    try
+    {
+        speculation.output = speculation.executive->start(copyRequest(input));
+    }
+    catch (std::exception& e)
+    {
+        // the DMC flow executes it again and reports the error
+        EXECUTOR_NAME_LOG(DEBUG) << LOG_BADGE("optimisticExecute")
+                                 << LOG_DESC("speculate transaction failed")
+                                 << LOG_KV("contextID", input.contextID)
+                                 << LOG_KV("EINFO", boost::diagnostic_information(e));
+    }
+    return speculation;
+}
+
+std::vector<ExecutionMessage::UniquePtr> TransactionExecutor::optimisticExecuteTransactions(
+    std::vector<CallParameters::UniquePtr>& inputs)
+{
+    auto recordT = utcTime();
+    // the transactions never executed, the DMC flow executes the first resumed or locking one and
+    // all the ones after it
+    size_t count = 0;
+    while (count < inputs.size())
+    {
+        auto& input = inputs[count];
+        if (!input || input->type != CallParameters::MESSAGE || input->seq != 0 ||
+            input->create || input->staticCall || !input->keyLocks.empty())
+        {
+            break;
+        }
+        ++count;
+    }
+    if (count < 2)
+    {
+        return {};
+    }
+
+    std::vector<Speculation> speculations(count);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, count),
+        [this, &inputs, &speculations](const tbb::blocked_range<size_t>& range) {
+            for (auto i = range.begin(); i != range.end(); ++i)
+            {
+                speculations[i] = speculate(*inputs[i]);
+            }
+        });
+    auto speculateT = utcTime() - recordT;
+    recordT = utcTime();
+
+    auto storage = m_blockContext->storage();
+    // the recoder of this thread may belong to an executive paused in another flow
+    storage->setRecoder(nullptr);
+    ReadSetStorage::KeySet written;
+    std::vector<ExecutionMessage::UniquePtr> outputs;
+    size_t reexecuted = 0;
+    size_t committed = 0;
+    for (; committed < count; ++committed)
+    {
+        auto& speculation = speculations[committed];
+        if (!speculation.output || speculation.readSet->conflictWith(written))
+        {
+            // the block state contains all the transactions before it, the result is the serial
+            // one
+            speculation = speculate(*inputs[committed]);
+            ++reexecuted;
+        }
+        auto& output = speculation.output;
+        if (!output || output->type == CallParameters::MESSAGE ||
+            output->type == CallParameters::KEY_LOCK)
+        {
+            // calls another contract, the DMC flow executes it in order
+            break;
+        }
+
+        std::mutex rowsMutex;
+        std::vector<std::tuple<std::string_view, std::string_view, const Entry*>> rows;
+        speculation.state->parallelTraverse(true,
+            [&rowsMutex, &rows](const std::string_view& table, const std::string_view& key,
+                const Entry& entry) {
+                std::lock_guard<std::mutex> lock(rowsMutex);
+                rows.emplace_back(table, key, &entry);
+                return true;
+            });
+        for (auto& [table, key, entry] : rows)
+        {
+            // the block state sets the rows synchronously
+            Error::UniquePtr setError;
+            storage->asyncSetRow(table, key, *entry,
+                [&setError](Error::UniquePtr error) { setError = std::move(error); });
+            if (setError)
+            {
+                BOOST_THROW_EXCEPTION(*setError);
+            }
+            written[std::string(table)].emplace(key);
+        }
+        outputs.emplace_back(toExecutionResult(*speculation.executive, std::move(output)));
+    }
+    inputs.erase(inputs.begin(), inputs.begin() + committed);
+
+    EXECUTOR_NAME_LOG(DEBUG) << LOG_BADGE("optimisticExecute") << LOG_KV("txNum", count)
+                             << LOG_KV("committed", committed) << LOG_KV("reexecuted", reexecuted)
+                             << LOG_KV("speculateT", speculateT)
+                             << LOG_KV("commitT", utcTime() - recordT);
+    return outputs;
+}
+
 void TransactionExecutor::getHash(bcos::protocol::BlockNumber number,
     std::function<void(bcos::Error::UniquePtr, crypto::HashType)> callback)
 {
@@ -1371,6 +1547,13 @@ void TransactionExecutor::prepare(
     bcos::protocol::TwoPCParams storageParams{
         params.number, params.primaryTableName, params.primaryTableKey, params.timestamp};
 
+    // the page size of the following blocks adapts to the access pattern of this block
+    auto keyPageStorage = std::dynamic_pointer_cast<storage::KeyPageStorage>(first->storage);
+    if (keyPageStorage)
+    {
+        keyPageStorage->updateStatistics(params.number);
+    }
+
     m_backendStorage->asyncPrepare(storageParams, *(first->storage),
         [this, callback = std::move(callback)](auto&& error, uint64_t) {
             if (!m_isRunning)
@@ -1457,6 +1640,7 @@ void TransactionExecutor::commit(
         m_lastCommittedBlockNumber = blockNumber;
 
         removeCommittedState();
+        CodeCache::instance().report();
 
         callback(nullptr);
     });
@@ -2150,9 +2334,12 @@ bcos::storage::StateStorageInterface::Ptr TransactionExecutor::createStateStorag
     if (m_keyPageSize > 0)
     {
         return std::make_shared<bcos::storage::KeyPageStorage>(
-            storage, m_keyPageSize, m_keyPageIgnoreTables);
+            storage, m_keyPageSize, m_keyPageIgnoreTables, m_keyPageStatistics);
     }
-    return std::make_shared<bcos::storage::StateStorage>(storage);
+    auto stateStorage = std::make_shared<bcos::storage::StateStorage>(storage);
+    // fold the state hash when executing, getHash needn't traverse the whole block state
+    stateStorage->setHashImpl(m_hashImpl);
+    return stateStorage;
 }
 
 protocol::BlockNumber TransactionExecutor::getBlockNumberInStorage()
@@ -37,6 +37,7 @@
 #include "bcos-framework/interfaces/storage/StorageInterface.h"
 #include "bcos-framework/interfaces/txpool/TxPoolInterface.h"
 #include "bcos-table/src/StateStorage.h"
+#include "bcos-table/src/KeyPageStorage.h"
 #include "tbb/concurrent_unordered_map.h"
 #include <bcos-crypto/interfaces/crypto/Hash.h>
 #include <tbb/concurrent_hash_map.h>
@@ -74,6 +75,7 @@ enum ExecutorVersion : int32_t
 class TransactionExecutive;
 class ExecutiveFlowInterface;
 class BlockContext;
+class ReadSetStorage;
 class PrecompiledContract;
 template <typename T, typename V>
 class ClockCache;
@@ -153,6 +155,13 @@ public:
     void start() override { m_isRunning = true; }
     void stop() override { m_isRunning = false; }
 
+    // execute the leading transactions of a contract in parallel optimistically instead of one by
+    // one in the DMC flow, the results are the same as the serial ones
+    void setOptimisticExecution(bool _optimisticExecution)
+    {
+        m_optimisticExecution = _optimisticExecution;
+    }
+
 protected:
     virtual void dagExecuteTransactionsInternal(gsl::span<std::unique_ptr<CallParameters>> inputs,
         std::function<void(
@@ -206,6 +215,29 @@ protected:
     std::shared_ptr<ExecutiveFlowInterface> getExecutiveFlow(
         std::shared_ptr<BlockContext> blockContext, std::string codeAddress);
 
+    void dmcExecuteTransactionsInternal(const std::string& contractAddress,
+        std::shared_ptr<std::vector<std::unique_ptr<CallParameters>>> callParametersList,
+        std::function<void(
+            bcos::Error::UniquePtr, std::vector<bcos::protocol::ExecutionMessage::UniquePtr>)>
+            callback);
+
+    // a transaction executed on its private state over the block state
+    struct Speculation
+    {
+        std::shared_ptr<ReadSetStorage> readSet;
+        storage::StateStorage::Ptr state;
+        std::shared_ptr<BlockContext> blockContext;
+        std::shared_ptr<TransactionExecutive> executive;
+        std::unique_ptr<CallParameters> output;
+    };
+    Speculation speculate(const CallParameters& input);
+
+    // execute the leading fresh transactions of a DMC batch in parallel, then validate them in
+    // order and re-execute the ones reading the keys written before them; the committed ones are
+    // removed from the inputs, the rest keep their order in the DMC flow
+    std::vector<protocol::ExecutionMessage::UniquePtr> optimisticExecuteTransactions(
+        std::vector<std::unique_ptr<CallParameters>>& inputs);
+
 
     void asyncExecuteExecutiveFlow(std::shared_ptr<ExecutiveFlowInterface> executiveFlow,
         std::function<void(
@@ -285,7 +317,9 @@ protected:
     size_t m_keyPageSize = 0;
     VMSchedule m_schedule = FiscoBcosScheduleV4;
     std::shared_ptr<const std::set<std::string, std::less<>>> m_keyPageIgnoreTables;
+    bcos::storage::KeyPageStatistics::Ptr m_keyPageStatistics;
     bool m_isRunning = false;
+    bool m_optimisticExecution = false;
     int64_t m_schedulerTermId = -1;
     void initEvmEnvironment();
     void initWasmEnvironment();
@@ -78,9 +78,16 @@ public:
 
     TransactionExecutor::Ptr build()
     {
-        return std::make_shared<TransactionExecutor>(m_ledger, m_txpool, m_cache, m_storage,
-            m_executionMessageFactory, m_hashImpl, m_isWasm, m_isAuthCheck, m_keyPageSize,
-            m_keyPageIgnoreTables, m_name + "-" + std::to_string(utcTime()));
+        auto executor = std::make_shared<TransactionExecutor>(m_ledger, m_txpool, m_cache,
+            m_storage, m_executionMessageFactory, m_hashImpl, m_isWasm, m_isAuthCheck,
+            m_keyPageSize, m_keyPageIgnoreTables, m_name + "-" + std::to_string(utcTime()));
+        executor->setOptimisticExecution(m_optimisticExecution);
+        return executor;
+    }
+
+    void setOptimisticExecution(bool _optimisticExecution)
+    {
+        m_optimisticExecution = _optimisticExecution;
     }
 
 private:
@@ -95,6 +102,7 @@ private:
     bcos::crypto::Hash::Ptr m_hashImpl;
     bool m_isWasm;
     bool m_isAuthCheck;
+    bool m_optimisticExecution = false;
 };
 
 }  // namespace executor
@@ -0,0 +1,125 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the contract codes shared by the executors of the process
+ * @file CodeCache.cpp
+ * @date: 2022-08-01
+ */
+
+#include "CodeCache.h"
+#include <bcos-framework/interfaces/Common.h>
+
+using namespace bcos;
+using namespace bcos::executor;
+
+CodeCache& CodeCache::instance()
+{
+    static CodeCache cache;
+    return cache;
+}
+
+CodeCache::Code CodeCache::get(h256 const& _codeHash)
+{
+    auto& codeShard = shard(_codeHash);
+    {
+        std::lock_guard<std::mutex> lock(codeShard.mutex);
+        auto it = codeShard.index.find(_codeHash);
+        if (it != codeShard.index.end())
+        {
+            codeShard.codes.splice(codeShard.codes.begin(), codeShard.codes, it->second);
+            ++m_hits;
+            return it->second->second;
+        }
+    }
+    ++m_misses;
+    return nullptr;
+}
+
+CodeCache::Code CodeCache::insert(h256 const& _codeHash, std::string_view _code)
+{
+    auto code = std::make_shared<const std::string>(_code);
+    auto capacity = m_shardCapacity.load();
+    if (code->size() > capacity)
+    {
+        return code;
+    }
+
+    auto& codeShard = shard(_codeHash);
+    std::lock_guard<std::mutex> lock(codeShard.mutex);
+    auto it = codeShard.index.find(_codeHash);
+    if (it != codeShard.index.end())
+    {
+        // inserted by another executive
+        return it->second->second;
+    }
+    codeShard.codes.emplace_front(_codeHash, code);
+    codeShard.index.emplace(_codeHash, codeShard.codes.begin());
+    codeShard.size += code->size();
+    evict(codeShard, capacity);
+    return code;
+}
+
+void CodeCache::setCapacity(size_t _capacity)
+{
+    auto capacity = _capacity / c_shardsNum;
+    m_shardCapacity = capacity;
+    for (auto& codeShard : m_shards)
+    {
+        std::lock_guard<std::mutex> lock(codeShard.mutex);
+        evict(codeShard, capacity);
+    }
+}
+
+void CodeCache::clear()
+{
+    for (auto& codeShard : m_shards)
+    {
+        std::lock_guard<std::mutex> lock(codeShard.mutex);
+        evict(codeShard, 0);
+    }
+}
+
+void CodeCache::report()
+{
+    uint64_t hits = m_hits;
+    uint64_t misses = m_misses;
+    auto newHits = hits - m_reportedHits.exchange(hits);
+    auto newMisses = misses - m_reportedMisses.exchange(misses);
+    if (newHits + newMisses == 0)
+    {
+        return;
+    }
+    size_t size = 0;
+    for (auto& codeShard : m_shards)
+    {
+        std::lock_guard<std::mutex> lock(codeShard.mutex);
+        size += codeShard.size;
+    }
+    EXECUTOR_LOG(INFO) << METRIC << LOG_DESC("codeCache") << LOG_KV("hits", newHits)
+                       << LOG_KV("misses", newMisses)
+                       << LOG_KV("hitRate", (double)newHits / (double)(newHits + newMisses))
+                       << LOG_KV("size", size);
+}
+
+void CodeCache::evict(Shard& _shard, size_t _capacity)
+{
+    while (_shard.size > _capacity && !_shard.codes.empty())
+    {
+        auto& [codeHash, code] = _shard.codes.back();
+        _shard.size -= code->size();
+        _shard.index.erase(codeHash);
+        _shard.codes.pop_back();
+    }
+}
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the contract codes shared by the executors of the process
+ * @file CodeCache.h
+ * @date: 2022-08-01
+ */
+
+#pragma once
+
+#include "../Common.h"
+#include <bcos-utilities/Common.h>
+#include <array>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace bcos
+{
+namespace executor
+{
+/**
+ * the contract codes keyed by the code hash, so the calls of the hot contracts needn't read the
+ * code from the storage again; the same code deployed to several addresses is cached once and an
+ * updated code never hits a stale entry. the least recently used codes are evicted when the cached
+ * bytes exceed the capacity, the codes are sharded by the hash to reduce the lock contention
+ */
+class CodeCache
+{
+public:
+    using Code = std::shared_ptr<const std::string>;
+
+    // the cache shared by the executors of the process
+    static CodeCache& instance();
+
+    explicit CodeCache(size_t _capacity = c_defaultCapacity) { setCapacity(_capacity); }
+    CodeCache(CodeCache const&) = delete;
+    CodeCache& operator=(CodeCache const&) = delete;
+
+    // nullptr if the code is not cached
+    Code get(h256 const& _codeHash);
+    // return the cached code, the code is not cached if it is larger than a shard
+    Code insert(h256 const& _codeHash, std::string_view _code);
+
+    // the capacity in bytes, 0 disables the cache
+    void setCapacity(size_t _capacity);
+    void clear();
+
+    uint64_t hits() const { return m_hits; }
+    uint64_t misses() const { return m_misses; }
+    // print the hit rate since the last report
+    void report();
+
+private:
+    static constexpr size_t c_defaultCapacity = 64 * 1024 * 1024;
+    static constexpr size_t c_shardsNum = 16;
+    struct Shard
+    {
+        // the most recently used code is at the front
+        std::list<std::pair<h256, Code>> codes;
+        std::unordered_map<h256, std::list<std::pair<h256, Code>>::iterator, std::hash<h256>>
+            index;
+        size_t size = 0;
+        std::mutex mutex;
+    };
+    Shard& shard(h256 const& _codeHash)
+    {
+        return m_shards[std::hash<h256>()(_codeHash) % c_shardsNum];
+    }
+    // evict the least recently used codes with the mutex of the shard locked
+    void evict(Shard& _shard, size_t _capacity);
+
+    std::atomic<size_t> m_shardCapacity = {0};
+    std::array<Shard, c_shardsNum> m_shards;
+
+    std::atomic<uint64_t> m_hits = {0};
+    std::atomic<uint64_t> m_misses = {0};
+    std::atomic<uint64_t> m_reportedHits = {0};
+    std::atomic<uint64_t> m_reportedMisses = {0};
+};
+}  // namespace executor
+}  // namespace bcos
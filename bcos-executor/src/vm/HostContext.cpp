@@ -409,14 +409,49 @@ std::optional<storage::Entry> HostContext::code()
     return entry;
 }
 
+CodeCache::Code HostContext::cachedCode()
+{
+    // the code hash is written with the code, read it under the key lock of the code; the
+    // contracts deployed without the code hash, such as the links, are not cached
+    h256 hash;
+    auto hashEntry =
+        m_executive->storage().getRow(m_tableName, ACCOUNT_CODE_HASH, ACCOUNT_CODE);
+    if (hashEntry && hashEntry->getField(0).size() == h256::size)
+    {
+        hash = h256(reinterpret_cast<const byte*>(hashEntry->getField(0).data()), h256::size);
+    }
+    auto& codeCache = CodeCache::instance();
+    if (hash != h256())
+    {
+        auto cached = codeCache.get(hash);
+        if (cached)
+        {
+            return cached;
+        }
+    }
+
+    auto entry = code();
+    if (!entry.has_value())
+    {
+        return nullptr;
+    }
+    if (hash == h256())
+    {
+        return std::make_shared<const std::string>(entry->get());
+    }
+    return codeCache.insert(hash, entry->get());
+}
+
 h256 HostContext::codeHash()
 {
     auto entry = m_executive->storage().getRow(m_tableName, ACCOUNT_CODE_HASH);
     if (entry)
     {
-        auto code = entry->getField(0);
-
-        return h256(std::string(code));  // TODO: h256 support decode from string_view
+        auto codeHash = entry->getField(0);
+        if (codeHash.size() == h256::size)
+        {
+            return h256(reinterpret_cast<const byte*>(codeHash.data()), h256::size);
+        }
     }
 
     return h256();
@@ -22,6 +22,7 @@
 #pragma once
 
 #include "../Common.h"
+#include "CodeCache.h"
 #include "bcos-framework/interfaces/protocol/BlockHeader.h"
 #include "bcos-framework/interfaces/storage/Table.h"
 #include <evmc/evmc.h>
@@ -127,6 +128,8 @@ public:
     std::string_view codeAddress() const { return m_callParameters->codeAddress; }
     bytesConstRef data() const { return ref(m_callParameters->data); }
     std::optional<storage::Entry> code();
+    /// the code shared through the code cache, nullptr if the contract has no code
+    CodeCache::Code cachedCode();
     bool isCodeHasPrefix(std::string_view _prefix) const;
     h256 codeHash();
     u256 salt() const { return m_salt; }
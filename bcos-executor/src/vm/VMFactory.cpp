@@ -26,6 +26,7 @@
 #include <evmc/loader.h>
 #include <evmone/evmone.h>
 #include <boost/program_options.hpp>
+#include <array>
 
 namespace po = boost::program_options;
 
@@ -89,6 +90,27 @@ void setVMKind(const std::string& _name)
     g_kind = VMKind::DLL;
 }
 #endif
+
+/// The most idle instances kept by a thread for every VM kind.
+constexpr size_t c_maxIdleInstances = 16;
+
+/// The idle VM instances of the thread, indexed by the VM kind.
+thread_local std::array<std::vector<std::unique_ptr<VMInstance>>, 3> t_idleInstances;
+
+evmc_vm* createInstance(VMKind _kind)
+{
+    switch (_kind)
+    {
+    case VMKind::BcosWasm:
+        return evmc_create_bcoswasm();
+    case VMKind::evmone:
+        return evmc_create_evmone();
+    case VMKind::DLL:
+        return g_evmcCreateFn();
+    default:
+        return evmc_create_evmone();
+    }
+}
 }  // namespace
 
 VMInstance VMFactory::create()
@@ -98,17 +120,34 @@ VMInstance VMFactory::create()
 
 VMInstance VMFactory::create(VMKind _kind)
 {
-    switch (_kind)
+    return VMInstance{createInstance(_kind)};
+}
+
+std::shared_ptr<VMInstance> VMFactory::acquire(VMKind _kind)
+{
+    auto& idleInstances = t_idleInstances[static_cast<size_t>(_kind)];
+    std::unique_ptr<VMInstance> instance;
+    if (idleInstances.empty())
     {
-    case VMKind::BcosWasm:
-        return VMInstance{evmc_create_bcoswasm()};
-    case VMKind::evmone:
-        return VMInstance{evmc_create_evmone()};
-    case VMKind::DLL:
-        return VMInstance{g_evmcCreateFn()};
-    default:
-        return VMInstance{evmc_create_evmone()};
+        instance = std::make_unique<VMInstance>(createInstance(_kind));
     }
+    else
+    {
+        instance = std::move(idleInstances.back());
+        idleInstances.pop_back();
+    }
+
+    return std::shared_ptr<VMInstance>(instance.release(), [_kind](VMInstance* _instance) {
+        auto& instances = t_idleInstances[static_cast<size_t>(_kind)];
+        if (instances.size() < c_maxIdleInstances)
+        {
+            instances.emplace_back(_instance);
+        }
+        else
+        {
+            delete _instance;
+        }
+    });
 }
 }  // namespace executor
 }  // namespace bcos
@@ -47,6 +47,11 @@ public:
 
     /// Creates a VM instance of the kind provided.
     static VMInstance create(VMKind _kind);
+
+    /// Takes an idle VM instance of the kind from the current thread, or creates one if there is
+    /// none. The instance goes back to the idle instances of the thread releasing it, so the
+    /// nested calls never share an instance and the later calls needn't create one.
+    static std::shared_ptr<VMInstance> acquire(VMKind _kind);
 };
 }  // namespace executor
 }  // namespace bcos
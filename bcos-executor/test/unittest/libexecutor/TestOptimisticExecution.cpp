@@ -0,0 +1,387 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+/**
+ * @brief : unitest for the optimistic execution of the DMC batches
+ * @date: 2022-08-20
+ */
+
+#include "../mock/MockLedger.h"
+#include "../mock/MockTransactionalStorage.h"
+#include "../mock/MockTxPool.h"
+#include "bcos-codec/wrapper/CodecWrapper.h"
+#include "bcos-framework/interfaces/executor/ExecutionMessage.h"
+#include "bcos-protocol/protobuf/PBBlockHeader.h"
+#include "executive/BlockContext.h"
+#include "executor/TransactionExecutorFactory.h"
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
+#include <bcos-crypto/signature/secp256k1/Secp256k1Crypto.h>
+#include <bcos-framework/interfaces/executor/NativeExecutionMessage.h>
+#include <boost/algorithm/hex.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+
+using namespace std;
+using namespace bcos;
+using namespace bcos::executor;
+using namespace bcos::storage;
+using namespace bcos::crypto;
+using namespace bcos::protocol;
+
+namespace bcos
+{
+namespace test
+{
+// the executor telling whether the DMC flow of a contract is created in the block
+class FlowTransactionExecutor : public TransactionExecutor
+{
+public:
+    using Ptr = std::shared_ptr<FlowTransactionExecutor>;
+    using TransactionExecutor::TransactionExecutor;
+
+    bool hasExecutiveFlow(const std::string& contract)
+    {
+        return m_blockContext->getExecutiveFlow(contract) != nullptr;
+    }
+};
+
+struct OptimisticExecutionFixture
+{
+    OptimisticExecutionFixture()
+    {
+        boost::log::core::get()->set_logging_enabled(false);
+        hashImpl = std::make_shared<Keccak256>();
+        cryptoSuite = std::make_shared<CryptoSuite>(
+            hashImpl, std::make_shared<Secp256k1Crypto>(), nullptr);
+        codec = std::make_unique<bcos::CodecWrapper>(hashImpl, false);
+    }
+    ~OptimisticExecutionFixture() { boost::log::core::get()->set_logging_enabled(true); }
+
+    // the receipts and the state of the same block executed by an executor
+    struct Result
+    {
+        std::vector<std::string> outputs;
+        std::map<int64_t, std::string> receipts;
+        crypto::HashType hash;
+        bool helloFlow = false;
+        bool callerFlow = false;
+    };
+
+    ExecutionMessage::UniquePtr createMessage(
+        int64_t contextID, std::string const& to, bytes data, bool create = false)
+    {
+        auto message = std::make_unique<NativeExecutionMessage>();
+        message->setType(ExecutionMessage::MESSAGE);
+        message->setContextID(contextID);
+        message->setSeq(0);
+        message->setDepth(0);
+        message->setOrigin(sender);
+        message->setFrom(sender);
+        message->setTo(to);
+        message->setStaticCall(false);
+        message->setGasAvailable(gas);
+        message->setData(std::move(data));
+        message->setCreate(create);
+        return message;
+    }
+
+    ExecutionMessage::UniquePtr execute(
+        TransactionExecutor::Ptr executor, ExecutionMessage::UniquePtr message)
+    {
+        std::promise<ExecutionMessage::UniquePtr> promise;
+        executor->executeTransaction(std::move(message),
+            [&promise](Error::UniquePtr&& error, ExecutionMessage::UniquePtr&& result) {
+                BOOST_CHECK(!error);
+                promise.set_value(std::move(result));
+            });
+        return promise.get_future().get();
+    }
+
+    std::vector<ExecutionMessage::UniquePtr> dmcExecute(TransactionExecutor::Ptr executor,
+        std::string const& contract, std::vector<ExecutionMessage::UniquePtr> messages)
+    {
+        std::promise<std::vector<ExecutionMessage::UniquePtr>> promise;
+        executor->dmcExecuteTransactions(contract, messages,
+            [&promise](Error::UniquePtr error, std::vector<ExecutionMessage::UniquePtr> outputs) {
+                BOOST_CHECK(!error);
+                promise.set_value(std::move(outputs));
+            });
+        return promise.get_future().get();
+    }
+
+    void nextBlock(TransactionExecutor::Ptr executor, BlockNumber number)
+    {
+        auto blockHeader = std::make_shared<bcos::protocol::PBBlockHeader>(cryptoSuite);
+        blockHeader->setNumber(number);
+        std::promise<void> promise;
+        executor->nextBlockHeader(0, blockHeader, [&promise](bcos::Error::UniquePtr error) {
+            BOOST_CHECK(!error);
+            promise.set_value();
+        });
+        promise.get_future().get();
+    }
+
+    static std::string toString(ExecutionMessage const& message)
+    {
+        std::stringstream ss;
+        ss << message.type() << "|" << message.contextID() << "|" << message.seq() << "|"
+           << message.status() << "|" << message.message() << "|" << message.from() << "->"
+           << message.to() << "|" << message.gasAvailable() << "|"
+           << message.newEVMContractAddress() << "|" << message.create() << "|";
+        boost::algorithm::hex_lower(
+            message.data().begin(), message.data().end(), std::ostream_iterator<char>(ss));
+        for (auto const& log : message.logEntries())
+        {
+            ss << "|" << log.topics().size() << ":";
+            boost::algorithm::hex_lower(
+                log.data().begin(), log.data().end(), std::ostream_iterator<char>(ss));
+        }
+        return ss.str();
+    }
+
+    // execute the same block of the contracts deployed in the previous block
+    Result executeBlock(size_t keyPageSize, bool optimistic)
+    {
+        // the system tables out of the key pages, like TransactionExecutorFactory
+        auto keyPageIgnoreTables = std::make_shared<std::set<std::string, std::less<>>>(
+            std::initializer_list<std::set<std::string, std::less<>>::value_type>{
+                ledger::SYS_CONFIG, ledger::SYS_CONSENSUS, ledger::FS_ROOT, ledger::FS_APPS,
+                ledger::FS_USER, ledger::FS_SYS_BIN, ledger::FS_USER_TABLE,
+                storage::StorageInterface::SYS_TABLES});
+        auto backend = std::make_shared<MockTransactionalStorage>(hashImpl);
+        auto ledger = std::make_shared<MockLedger>();
+        auto executor = std::make_shared<FlowTransactionExecutor>(ledger,
+            std::make_shared<MockTxPool>(), nullptr, backend,
+            std::make_shared<NativeExecutionMessageFactory>(), hashImpl, false, false, keyPageSize,
+            keyPageIgnoreTables, "executor-optimistic");
+        executor->setOptimisticExecution(optimistic);
+
+        // deploy the contracts in block 1, the deploys create the flows of the contracts
+        ledger->setBlockNumber(0);
+        nextBlock(executor, 1);
+        bytes code;
+        boost::algorithm::unhex(helloBin, std::back_inserter(code));
+        auto deployed = execute(executor, createMessage(1, hello, code, true));
+        BOOST_CHECK_EQUAL(deployed->status(), 0);
+        code.clear();
+        boost::algorithm::unhex(callerBin, std::back_inserter(code));
+        deployed = execute(executor, createMessage(2, caller, code, true));
+        BOOST_CHECK_EQUAL(deployed->status(), 0);
+
+        // block 2 is executed on the uncommitted state of block 1, like the pipelined scheduler
+        nextBlock(executor, 2);
+        std::vector<ExecutionMessage::UniquePtr> outputs;
+        // a conflicting pair, a reverting tx and a tx reading the state written before it
+        std::vector<ExecutionMessage::UniquePtr> helloMessages;
+        helloMessages.emplace_back(
+            createMessage(10, hello, codec->encodeWithSig("set(string)", std::string("fisco"))));
+        helloMessages.emplace_back(
+            createMessage(11, hello, codec->encodeWithSig("set(string)", std::string("bcos"))));
+        helloMessages.emplace_back(createMessage(12, hello, codec->encodeWithSig("unknown()")));
+        helloMessages.emplace_back(createMessage(13, hello, codec->encodeWithSig("get()")));
+        for (auto& output : dmcExecute(executor, hello, std::move(helloMessages)))
+        {
+            outputs.emplace_back(std::move(output));
+        }
+        // the tx calling another contract in the middle of the batch pauses it and the following
+        // ones
+        std::vector<ExecutionMessage::UniquePtr> callerMessages;
+        callerMessages.emplace_back(createMessage(20, caller, codec->encodeWithSig("unknown()")));
+        callerMessages.emplace_back(
+            createMessage(21, caller, codec->encodeWithSig("createAndCallB(int256)", s256(1000))));
+        callerMessages.emplace_back(createMessage(22, caller, codec->encodeWithSig("unknown()")));
+        for (auto& output : dmcExecute(executor, caller, std::move(callerMessages)))
+        {
+            outputs.emplace_back(std::move(output));
+        }
+
+        Result result;
+        result.helloFlow = executor->hasExecutiveFlow(hello);
+        result.callerFlow = executor->hasExecutiveFlow(caller);
+        for (auto& output : outputs)
+        {
+            result.outputs.emplace_back(toString(*output));
+        }
+        std::sort(result.outputs.begin(), result.outputs.end());
+
+        // route the external calls like the scheduler, until every tx returns to the sender
+        std::deque<ExecutionMessage::UniquePtr> messages(
+            std::make_move_iterator(outputs.begin()), std::make_move_iterator(outputs.end()));
+        std::map<int64_t, std::vector<int64_t>> callerSeqs;
+        int64_t seq = 1;
+        while (!messages.empty())
+        {
+            auto message = std::move(messages.front());
+            messages.pop_front();
+            auto& seqs = callerSeqs[message->contextID()];
+            if (message->type() == ExecutionMessage::MESSAGE)
+            {
+                seqs.push_back(message->seq());
+                message->setSeq(seq++);
+                message->setKeyLocks({});
+                if (message->create())
+                {
+                    auto address = std::to_string(message->contextID());
+                    message->setTo(std::string(40 - address.size(), 'c') + address);
+                }
+                messages.emplace_back(execute(executor, std::move(message)));
+            }
+            else if (!seqs.empty())
+            {
+                message->setSeq(seqs.back());
+                seqs.pop_back();
+                messages.emplace_back(execute(executor, std::move(message)));
+            }
+            else
+            {
+                result.receipts.emplace(message->contextID(), toString(*message));
+            }
+        }
+
+        std::promise<crypto::HashType> hashPromise;
+        executor->getHash(2, [&hashPromise](bcos::Error::UniquePtr error, crypto::HashType hash) {
+            BOOST_CHECK(!error);
+            hashPromise.set_value(hash);
+        });
+        result.hash = hashPromise.get_future().get();
+        return result;
+    }
+
+    void checkSameResult(size_t keyPageSize)
+    {
+        auto dmc = executeBlock(keyPageSize, false);
+        auto optimistic = executeBlock(keyPageSize, true);
+
+        // all the txs of the hello batch are committed optimistically, the caller batch is
+        // executed by the DMC flow from the external call
+        BOOST_CHECK(dmc.helloFlow);
+        BOOST_CHECK(!optimistic.helloFlow);
+        BOOST_CHECK(dmc.callerFlow);
+        BOOST_CHECK(optimistic.callerFlow);
+
+        BOOST_CHECK_EQUAL(dmc.outputs.size(), 7);
+        BOOST_CHECK_EQUAL_COLLECTIONS(dmc.outputs.begin(), dmc.outputs.end(),
+            optimistic.outputs.begin(), optimistic.outputs.end());
+        BOOST_CHECK_EQUAL(dmc.receipts.size(), 7);
+        BOOST_CHECK(dmc.receipts == optimistic.receipts);
+        BOOST_CHECK_NE(dmc.hash.hex(), h256().hex());
+        BOOST_CHECK_EQUAL(dmc.hash.hex(), optimistic.hash.hex());
+
+        // the tx after the conflicting pair reads the last value, the unknown calls revert
+        auto startsWith = [](std::string const& receipt, ExecutionMessage::Type type) {
+            return receipt.rfind(std::to_string(type) + "|", 0) == 0;
+        };
+        BOOST_CHECK(dmc.receipts[13].find("62636f73") != std::string::npos);
+        BOOST_CHECK(dmc.receipts[13].find("666973636f") == std::string::npos);
+        BOOST_CHECK(startsWith(dmc.receipts[12], ExecutionMessage::REVERT));
+        BOOST_CHECK(startsWith(dmc.receipts[20], ExecutionMessage::REVERT));
+        BOOST_CHECK(startsWith(dmc.receipts[21], ExecutionMessage::FINISHED));
+        BOOST_CHECK(startsWith(dmc.receipts[22], ExecutionMessage::REVERT));
+    }
+
+    CryptoSuite::Ptr cryptoSuite;
+    std::shared_ptr<Keccak256> hashImpl;
+    std::unique_ptr<bcos::CodecWrapper> codec;
+    int64_t gas = 3000000;
+    std::string sender = "0000000000000000000000000000000000000001";
+    std::string hello = "ff6f30856ad3bae00b1169808488502786a13e3c";
+    std::string caller = "ee6f30856ad3bae00b1169808488502786a13e3c";
+
+    // HelloWorld with set(string) and get()
+    std::string helloBin =
+        "60806040526040805190810160405280600181526020017f3100000000000000000000000000000000000000"
+        "0000000000000000000000008152506001908051906020019061004f9291906100ae565b5034801561005c5760"
+        "0080fd5b506040805190810160405280600d81526020017f48656c6c6f2c20576f726c64210000000000000000"
+        "0000000000000000000000815250600090805190602001906100a89291906100ae565b50610153565b82805460"
+        "0181600116156101000203166002900490600052602060002090601f016020900481019282601f106100ef5780"
+        "5160ff191683800117855561011d565b8280016001018555821561011d579182015b8281111561011c57825182"
+        "5591602001919060010190610101565b5b50905061012a919061012e565b5090565b61015091905b8082111561"
+        "014c576000816000905550600101610134565b5090565b90565b6104ac806101626000396000f3006080604052"
+        "60043610610057576000357c0100000000000000000000000000000000000000000000000000000000900463ff"
+        "ffffff1680634ed3885e1461005c57806354fd4d50146100c55780636d4ce63c14610155575b600080fd5b3480"
+        "1561006857600080fd5b506100c3600480360381019080803590602001908201803590602001908080601f0160"
+        "208091040260200160405190810160405280939291908181526020018383808284378201915050505050509192"
+        "9192905050506101e5565b005b3480156100d157600080fd5b506100da61029b565b6040518080602001828103"
+        "825283818151815260200191508051906020019080838360005b8381101561011a578082015181840152602081"
+        "0190506100ff565b50505050905090810190601f1680156101475780820380516001836020036101000a031916"
+        "815260200191505b509250505060405180910390f35b34801561016157600080fd5b5061016a610339565b6040"
+        "518080602001828103825283818151815260200191508051906020019080838360005b838110156101aa578082"
+        "01518184015260208101905061018f565b50505050905090810190601f1680156101d757808203805160018360"
+        "20036101000a031916815260200191505b509250505060405180910390f35b80600090805190602001906101fb"
+        "9291906103db565b507f93a093529f9c8a0c300db4c55fcd27c068c4f5e0e8410bc288c7e76f3d71083e816040"
+        "518080602001828103825283818151815260200191508051906020019080838360005b8381101561025e578082"
+        "015181840152602081019050610243565b50505050905090810190601f16801561028b57808203805160018360"
+        "20036101000a031916815260200191505b509250505060405180910390a150565b600180546001816001161561"
+        "01000203166002900480601f016020809104026020016040519081016040528092919081815260200182805460"
+        "0181600116156101000203166002900480156103315780601f1061030657610100808354040283529160200191"
+        "610331565b820191906000526020600020905b81548152906001019060200180831161031457829003601f1682"
+        "01915b505050505081565b606060008054600181600116156101000203166002900480601f0160208091040260"
+        "200160405190810160405280929190818152602001828054600181600116156101000203166002900480156103"
+        "d15780601f106103a6576101008083540402835291602001916103d1565b820191906000526020600020905b81"
+        "54815290600101906020018083116103b457829003601f168201915b5050505050905090565b82805460018160"
+        "0116156101000203166002900490600052602060002090601f016020900481019282601f1061041c57805160ff"
+        "191683800117855561044a565b8280016001018555821561044a579182015b8281111561044957825182559160"
+        "200191906001019061042e565b5b509050610457919061045b565b5090565b61047d91905b8082111561047957"
+        "6000816000905550600101610461565b5090565b905600a165627a7a723058204736027ad6b97d7cd2685379ac"
+        "b35b386dcb18799934be8283f1e08cd1f0c6ec0029";
+
+    // A with createAndCallB(int256) creating B and calling its value(), from test_external_call.sol
+    std::string callerBin =
+        "608060405234801561001057600080fd5b5061037f806100206000396000f3fe60806040523480156100105760"
+        "0080fd5b506004361061002b5760003560e01c80635b975a7314610030575b600080fd5b61005c600480360360"
+        "2081101561004657600080fd5b8101908080359060200190929190505050610072565b60405180828152602001"
+        "91505060405180910390f35b600081604051610081906101c7565b808281526020019150506040518091039060"
+        "00f0801580156100a7573d6000803e3d6000fd5b506000806101000a81548173ffffffffffffffffffffffffff"
+        "ffffffffffffff021916908373ffffffffffffffffffffffffffffffffffffffff1602179055507fd8e189e965"
+        "f1ff506594c5c65110ea4132cee975b58710da78ea19bc094414ae826040518082815260200191505060405180"
+        "910390a16000809054906101000a900473ffffffffffffffffffffffffffffffffffffffff1673ffffffffffff"
+        "ffffffffffffffffffffffffffff16633fa4f2456040518163ffffffff1660e01b815260040160206040518083"
+        "038186803b15801561018557600080fd5b505afa158015610199573d6000803e3d6000fd5b505050506040513d"
+        "60208110156101af57600080fd5b81019080805190602001909291905050509050919050565b610175806101d5"
+        "8339019056fe608060405234801561001057600080fd5b50604051610175380380610175833981810160405260"
+        "2081101561003357600080fd5b8101908080519060200190929190505050806000819055507fdc509bfccbee28"
+        "6f248e0904323788ad0c0e04e04de65c04b482b056acb1a0658160405180828152602001915050604051809103"
+        "90a15060e4806100916000396000f3fe6080604052348015600f57600080fd5b506004361060325760003560e0"
+        "1c80633fa4f245146037578063a16fe09b146053575b600080fd5b603d605b565b604051808281526020019150"
+        "5060405180910390f35b60596064565b005b60008054905090565b6000808154600101919050819055507f052f"
+        "6b9dfac9e4e1257cb5b806b7673421c54730f663c8ab02561743bb23622d600054604051808281526020019150"
+        "5060405180910390a156fea264697066735822122006eea3bbe24f3d859a9cb90efc318f26898aeb4dffb31cac"
+        "e105776a6c272f8464736f6c634300060a0033a2646970667358221220b441da8ba792a40e444d0ed767a4417e"
+        "944c55578d1c8d0ca4ad4ec050e05a9364736f6c634300060a0033";
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestOptimisticExecution, OptimisticExecutionFixture)
+
+BOOST_AUTO_TEST_CASE(stateStorage)
+{
+    checkSameResult(0);
+}
+
+BOOST_AUTO_TEST_CASE(keyPageStorage)
+{
+    checkSameResult(10240);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
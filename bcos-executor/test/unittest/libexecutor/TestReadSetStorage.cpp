@@ -0,0 +1,94 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+/**
+ * @brief : unitest for the read set of the optimistic transactions
+ * @date: 2022-08-08
+ */
+
+#include "../src/executive/ReadSetStorage.h"
+#include "bcos-table/src/StateStorage.h"
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <optional>
+
+using namespace std;
+using namespace bcos;
+using namespace bcos::executor;
+using namespace bcos::storage;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_AUTO_TEST_SUITE(TestReadSetStorage)
+
+BOOST_AUTO_TEST_CASE(recordReads)
+{
+    auto blockState = std::make_shared<StateStorage>(nullptr);
+    Entry entry;
+    entry.importFields({"1"});
+    blockState->asyncSetRow("t_test", "a", entry, [](Error::UniquePtr error) {
+        BOOST_CHECK(!error);
+    });
+
+    auto readSet = std::make_shared<ReadSetStorage>(blockState);
+    auto state = std::make_shared<StateStorage>(readSet);
+
+    // the rows written by the transaction are read from its own state
+    state->asyncSetRow("t_test", "b", entry, [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+    state->asyncGetRow("t_test", "b", [](Error::UniquePtr error, std::optional<Entry> row) {
+        BOOST_CHECK(!error);
+        BOOST_CHECK(row);
+    });
+    state->asyncGetRow("t_test", "a", [](Error::UniquePtr error, std::optional<Entry> row) {
+        BOOST_CHECK(!error);
+        BOOST_CHECK_EQUAL(row->getField(0), "1");
+    });
+    // the absence of a row is read too
+    state->asyncGetRow("t_test", "c", [](Error::UniquePtr error, std::optional<Entry> row) {
+        BOOST_CHECK(!error);
+        BOOST_CHECK(!row);
+    });
+
+    ReadSetStorage::KeySet written;
+    written["t_test"].emplace("b");
+    written["t_other"].emplace("a");
+    BOOST_CHECK(!readSet->conflictWith(written));
+    written["t_test"].emplace("c");
+    BOOST_CHECK(readSet->conflictWith(written));
+
+    // a primary key query reads the whole table
+    state->asyncGetPrimaryKeys("t_other", std::nullopt,
+        [](Error::UniquePtr error, std::vector<std::string>) { BOOST_CHECK(!error); });
+    ReadSetStorage::KeySet otherWritten;
+    otherWritten["t_other"].emplace("z");
+    BOOST_CHECK(readSet->conflictWith(otherWritten));
+}
+
+BOOST_AUTO_TEST_CASE(refuseWrites)
+{
+    auto readSet = std::make_shared<ReadSetStorage>(std::make_shared<StateStorage>(nullptr));
+    Entry entry;
+    entry.importFields({"1"});
+    readSet->asyncSetRow("t_test", "a", entry, [](Error::UniquePtr error) {
+        BOOST_CHECK(error);
+        BOOST_CHECK_EQUAL(error->errorCode(), StorageError::ReadOnly);
+    });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
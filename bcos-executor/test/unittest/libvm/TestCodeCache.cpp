@@ -0,0 +1,116 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+/**
+ * @brief : unitest for the contract code cache
+ * @date: 2022-08-01
+ */
+
+#include "../src/vm/CodeCache.h"
+#include "../src/vm/VMFactory.h"
+#include "../src/vm/VMInstance.h"
+#include <boost/test/unit_test.hpp>
+#include <memory>
+#include <vector>
+
+using namespace std;
+using namespace bcos;
+using namespace bcos::executor;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_AUTO_TEST_SUITE(TestCodeCache)
+
+BOOST_AUTO_TEST_CASE(hitAndMiss)
+{
+    CodeCache cache(16 * 1024);
+    h256 codeHash(1);
+    BOOST_CHECK(!cache.get(codeHash));
+    BOOST_CHECK_EQUAL(cache.misses(), 1);
+
+    auto code = cache.insert(codeHash, "code");
+    BOOST_CHECK_EQUAL(*code, "code");
+    auto cached = cache.get(codeHash);
+    BOOST_CHECK_EQUAL(cached, code);
+    BOOST_CHECK_EQUAL(cache.hits(), 1);
+
+    // the code inserted first is shared
+    BOOST_CHECK_EQUAL(cache.insert(codeHash, "code"), code);
+    BOOST_CHECK(!cache.get(h256(2)));
+    BOOST_CHECK_EQUAL(cache.misses(), 2);
+
+    cache.clear();
+    BOOST_CHECK(!cache.get(codeHash));
+    // the released code is still valid for the holders
+    BOOST_CHECK_EQUAL(*code, "code");
+}
+
+BOOST_AUTO_TEST_CASE(capacity)
+{
+    // 64 bytes of every shard
+    CodeCache cache(16 * 64);
+    BOOST_CHECK(!cache.get(h256(1)));
+
+    // larger than a shard, not cached
+    auto code = cache.insert(h256(1), std::string(65, 'c'));
+    BOOST_CHECK_EQUAL(code->size(), 65);
+    BOOST_CHECK(!cache.get(h256(1)));
+
+    // the codes of the same shard evict the least recently used one
+    std::vector<h256> codeHashes;
+    auto shard = std::hash<h256>()(h256(2)) % 16;
+    for (unsigned i = 2; codeHashes.size() < 3; ++i)
+    {
+        if (std::hash<h256>()(h256(i)) % 16 == shard)
+        {
+            codeHashes.emplace_back(i);
+        }
+    }
+    cache.insert(codeHashes[0], std::string(30, 'a'));
+    cache.insert(codeHashes[1], std::string(30, 'b'));
+    BOOST_CHECK(cache.get(codeHashes[0]));
+    cache.insert(codeHashes[2], std::string(30, 'c'));
+    BOOST_CHECK(cache.get(codeHashes[0]));
+    BOOST_CHECK(!cache.get(codeHashes[1]));
+    BOOST_CHECK(cache.get(codeHashes[2]));
+
+    // disabled
+    cache.setCapacity(0);
+    BOOST_CHECK(!cache.get(codeHashes[0]));
+    cache.insert(codeHashes[0], "code");
+    BOOST_CHECK(!cache.get(codeHashes[0]));
+}
+
+BOOST_AUTO_TEST_CASE(reuseVMInstance)
+{
+    VMInstance* instance = nullptr;
+    {
+        auto vm = VMFactory::acquire(VMKind::evmone);
+        instance = vm.get();
+        // a nested call takes another instance
+        auto nestedVM = VMFactory::acquire(VMKind::evmone);
+        BOOST_CHECK_NE(nestedVM.get(), instance);
+    }
+    // the idle instances are reused
+    auto vm = VMFactory::acquire(VMKind::evmone);
+    auto nestedVM = VMFactory::acquire(VMKind::evmone);
+    BOOST_CHECK(vm.get() == instance || nestedVM.get() == instance);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
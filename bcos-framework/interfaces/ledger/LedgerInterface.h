@@ -74,6 +74,43 @@ public:
     virtual void asyncGetBlockDataByNumber(protocol::BlockNumber _blockNumber, int32_t _blockFlag,
         std::function<void(Error::Ptr, protocol::Block::Ptr)> _onGetBlock) = 0;
 
+    /**
+     * @brief async get the blocks in [_startNumber, _endNumber] in batches
+     * @param _blockFlag the same flag as asyncGetBlockDataByNumber
+     * @param _onGetBlocks called with the blocks of every batch in order, _finished is true for the
+     * last batch or when error happens, no more batches after that; the range is empty if
+     * _startNumber is larger than _endNumber
+     *
+     * @note the default implementation gets the blocks one by one
+     */
+    virtual void asyncGetBlockDataByRange(protocol::BlockNumber _startNumber,
+        protocol::BlockNumber _endNumber, int32_t _blockFlag,
+        std::function<void(Error::Ptr, protocol::BlocksPtr, bool _finished)> _onGetBlocks)
+    {
+        if (_startNumber > _endNumber)
+        {
+            _onGetBlocks(nullptr, std::make_shared<protocol::Blocks>(), true);
+            return;
+        }
+        asyncGetBlockDataByNumber(_startNumber, _blockFlag,
+            [this, _startNumber, _endNumber, _blockFlag, _onGetBlocks](
+                Error::Ptr _error, protocol::Block::Ptr _block) {
+                if (_error)
+                {
+                    _onGetBlocks(std::move(_error), nullptr, true);
+                    return;
+                }
+                auto finished = (_startNumber == _endNumber);
+                _onGetBlocks(nullptr, std::make_shared<protocol::Blocks>(1, std::move(_block)),
+                    finished);
+                if (!finished)
+                {
+                    asyncGetBlockDataByRange(
+                        _startNumber + 1, _endNumber, _blockFlag, std::move(_onGetBlocks));
+                }
+            });
+    }
+
     /**
      * @brief async get latest block number
      * @param _onGetBlock
@@ -103,6 +140,7 @@ public:
      * @param _withProof if true then it will callback MerkleProofPtr map in _onGetTx
      *                   if false then MerkleProofPtr map will be nullptr
      * @param _onGetTx return <error, [tx data in bytes], map<txHash, merkleProof>
+     * @note the txs may be shared with the other callers, copy them before modifying them
      */
     virtual void asyncGetBatchTxsByHashList(crypto::HashListPtr _txHashList, bool _withProof,
         std::function<void(Error::Ptr, bcos::protocol::TransactionsPtr,
@@ -160,5 +198,11 @@ public:
     virtual void asyncPreStoreBlockTxs(bcos::protocol::TransactionsPtr _blockTxs,
         bcos::protocol::Block::ConstPtr block,
         std::function<void(Error::UniquePtr&&)> _callback) = 0;
+
+    /**
+     * @brief remove the cached data of the prewritten block when the block is rolled back
+     * @param _blockNumber the number of the rolled back block
+     */
+    virtual void removeBlockCache(protocol::BlockNumber) {}
 };
 }  // namespace bcos::ledger
@@ -81,10 +81,13 @@ enum ProtocolVersion : uint32_t
 enum class Version : uint32_t
 {
     RC4_VERSION = 4,
+    // revert the victims of all the dead locks in one DMC round
+    V3_0_VERSION = 0x03000000,
     MIN_VERSION = RC4_VERSION,
-    MAX_VERSION = RC4_VERSION,
+    MAX_VERSION = V3_0_VERSION,
 };
 const std::string RC4_VERSION_STR = "3.0.0-rc4";
+const std::string V3_0_VERSION_STR = "3.0.0";
 
 const std::string RC_VERSION_PREFIX = "3.0.0-rc";
 
@@ -99,6 +102,9 @@ inline std::ostream& operator<<(std::ostream& _out, bcos::protocol::Version cons
     case bcos::protocol::Version::RC4_VERSION:
         _out << RC4_VERSION_STR;
         break;
+    case bcos::protocol::Version::V3_0_VERSION:
+        _out << V3_0_VERSION_STR;
+        break;
     default:
         _out << "Unknown";
         break;
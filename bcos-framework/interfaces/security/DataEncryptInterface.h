@@ -21,6 +21,8 @@
 
 #pragma once
 #include <memory>
+#include <string>
+#include <vector>
 #include <bcos-utilities/Common.h>
 
 namespace bcos
@@ -44,6 +46,28 @@ public:
     // use to encrypt/decrypt in rocksdb
     virtual std::string encrypt(const std::string& data) = 0;
     virtual std::string decrypt(const std::string& data) = 0;
+
+    // encrypt/decrypt the values in place, the empty values are kept empty
+    virtual void encryptBatch(std::vector<std::string>& datas)
+    {
+        for (auto& data : datas)
+        {
+            if (!data.empty())
+            {
+                data = encrypt(data);
+            }
+        }
+    }
+    virtual void decryptBatch(std::vector<std::string>& datas)
+    {
+        for (auto& data : datas)
+        {
+            if (!data.empty())
+            {
+                data = decrypt(data);
+            }
+        }
+    }
 };
 
 }  // namespace security
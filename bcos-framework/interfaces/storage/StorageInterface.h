@@ -55,6 +55,13 @@ public:
         const std::optional<Condition const>& _condition,
         std::function<void(Error::UniquePtr, std::vector<std::string>)> _callback) = 0;
 
+    // get at most _limit primary keys greater than _cursor in ascending order, the last key is the
+    // cursor of the next page, the empty cursor means the first page, the keys are exhausted if
+    // less than _limit keys are returned; the limit of the condition is ignored
+    virtual void asyncGetPrimaryKeyPage(std::string_view table,
+        const std::optional<Condition const>& _condition, std::string_view _cursor, size_t _limit,
+        std::function<void(Error::UniquePtr, std::vector<std::string>)> _callback);
+
     virtual void asyncGetRow(std::string_view table, std::string_view _key,
         std::function<void(Error::UniquePtr, std::optional<Entry>)> _callback) = 0;
 
@@ -47,12 +47,18 @@ public:
         const std::variant<const gsl::span<std::string_view const>,
             const gsl::span<std::string const>>& _keys);
     std::vector<std::string> getPrimaryKeys(const std::optional<const Condition>& _condition);
+    std::vector<std::string> getPrimaryKeyPage(
+        const std::optional<const Condition>& _condition, std::string_view _cursor, size_t _limit);
 
     void setRow(std::string_view _key, Entry _entry);
 
     void asyncGetPrimaryKeys(std::optional<const Condition> const& _condition,
         std::function<void(Error::UniquePtr, std::vector<std::string>)> _callback) noexcept;
 
+    void asyncGetPrimaryKeyPage(std::optional<const Condition> const& _condition,
+        std::string_view _cursor, size_t _limit,
+        std::function<void(Error::UniquePtr, std::vector<std::string>)> _callback) noexcept;
+
     void asyncGetRow(std::string_view _key,
         std::function<void(Error::UniquePtr, std::optional<Entry>)> _callback) noexcept;
 
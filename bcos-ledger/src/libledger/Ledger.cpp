@@ -33,11 +33,11 @@
 #include <bcos-framework/interfaces/protocol/GlobalConfig.h>
 #include <bcos-framework/interfaces/protocol/ProtocolTypeDef.h>
 #include <bcos-framework/interfaces/storage/Table.h>
-#include <bcos-protocol/ParallelMerkleProof.h>
 #include <bcos-tool/ConsensusNode.h>
 #include <bcos-utilities/BoostLog.h>
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/DataConvertUtility.h>
+#include <tbb/concurrent_unordered_map.h>
 #include <tbb/parallel_for.h>
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/lexical_cast.hpp>
@@ -53,6 +53,20 @@ using namespace bcos::protocol;
 using namespace bcos::storage;
 using namespace bcos::crypto;
 
+namespace
+{
+std::vector<HashType> toHashList(std::vector<std::string> const& _hexList)
+{
+    std::vector<HashType> hashList;
+    hashList.reserve(_hexList.size());
+    for (auto const& hex : _hexList)
+    {
+        hashList.emplace_back(hex, HashType::FromHex);
+    }
+    return hashList;
+}
+}  // namespace
+
 
 void Ledger::asyncPreStoreBlockTxs(bcos::protocol::TransactionsPtr _blockTxs,
     bcos::protocol::Block::ConstPtr block, std::function<void(Error::UniquePtr&&)> _callback)
@@ -124,7 +138,8 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
 
     // 8 storage callbacks and write hash=>receipt and
     size_t TOTAL_CALLBACK = 9 + block->receiptsSize();
-    auto setRowCallback = [total = std::make_shared<std::atomic<size_t>>(TOTAL_CALLBACK),
+    auto setRowCallback = [this, number = header->number(),
+                              total = std::make_shared<std::atomic<size_t>>(TOTAL_CALLBACK),
                               failed = std::make_shared<bool>(false),
                               callback = std::move(callback)](
                               Error::UniquePtr&& error, size_t count = 1) {
@@ -140,6 +155,7 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
             // all finished
             if (*failed)
             {
+                m_ledgerCache->remove(number);
                 LEDGER_LOG(ERROR) << "PrewriteBlock error";
                 callback(
                     BCOS_ERROR_PTR(LedgerError::CollectAsyncCallbackError, "PrewriteBlock error"));
@@ -147,6 +163,7 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
             }
 
             LEDGER_LOG(INFO) << "PrewriteBlock success";
+            m_ledgerCache->report();
             callback(nullptr);
         }
     };
@@ -172,6 +189,9 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
     // number 2 header
     bytes headerBuffer;
     header->encode(headerBuffer);
+    // the cached header is decoded from the buffer, the header of the block may still be updated
+    // by the scheduler
+    auto cachedHeader = m_blockFactory->blockHeaderFactory()->createBlockHeader(headerBuffer);
 
     Entry number2HeaderEntry;
     number2HeaderEntry.importFields({std::move(headerBuffer)});
@@ -218,6 +238,48 @@ void Ledger::asyncPrewriteBlock(bcos::storage::StorageInterface::Ptr storage,
     bytes transactionsBuffer;
     transactionsBlock->encode(transactionsBuffer);
 
+    // build the merkle trees once, the proofs of the txs and receipts are collected from them
+    std::vector<HashType> txHashes(transactionsBlock->transactionsMetaDataSize());
+    for (size_t i = 0; i < txHashes.size(); ++i)
+    {
+        txHashes[i] = transactionsBlock->transactionHash(i);
+    }
+    MerkleTree::Ptr receiptsTree = nullptr;
+    std::vector<TransactionReceipt::ConstPtr> receipts;
+    if (block->receiptsSize() == txHashes.size())
+    {
+        std::vector<HashType> receiptHashes(block->receiptsSize());
+        receipts.resize(block->receiptsSize());
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, receiptHashes.size()),
+            [&](const tbb::blocked_range<size_t>& range) {
+                for (size_t i = range.begin(); i < range.end(); ++i)
+                {
+                    receipts[i] = block->receipt(i);
+                    receiptHashes[i] = receipts[i]->hash();
+                }
+            });
+        receiptsTree = std::make_shared<MerkleTree>(
+            m_blockFactory->cryptoSuite(), std::move(receiptHashes));
+    }
+    // the txs are in the block when syncing, or passed by the scheduler
+    std::vector<Transaction::ConstPtr> txs;
+    if (block->transactionsSize() == txHashes.size())
+    {
+        txs.reserve(txHashes.size());
+        for (size_t i = 0; i < block->transactionsSize(); ++i)
+        {
+            txs.emplace_back(block->transaction(i));
+        }
+    }
+    else if (_blockTxs && _blockTxs->size() == txHashes.size())
+    {
+        txs.assign(_blockTxs->begin(), _blockTxs->end());
+    }
+    m_ledgerCache->insert(std::move(cachedHeader), txHashes, std::move(txs), std::move(receipts));
+    m_merkleTreeCache->insert(header->number(),
+        std::make_shared<MerkleTree>(m_blockFactory->cryptoSuite(), std::move(txHashes)),
+        std::move(receiptsTree));
+
     Entry number2TransactionHashesEntry;
     number2TransactionHashesEntry.importFields({std::move(transactionsBuffer)});
     storage->asyncSetRow(SYS_NUMBER_2_TXS, blockNumberStr, std::move(number2TransactionHashesEntry),
@@ -423,6 +485,14 @@ void Ledger::asyncGetBlockDataByNumber(bcos::protocol::BlockNumber _blockNumber,
         _onGetBlock(BCOS_ERROR_PTR(LedgerError::ErrorArgument, "Wrong argument"), nullptr);
         return;
     }
+    auto cachedBlock = m_blockFactory->createBlock();
+    if (m_ledgerCache->fillBlock(_blockNumber, _blockFlag, *cachedBlock))
+    {
+        LEDGER_LOG(INFO) << "GetBlockDataByNumber success from cache"
+                         << LOG_KV("number", _blockNumber);
+        _onGetBlock(nullptr, std::move(cachedBlock));
+        return;
+    }
 
     std::list<std::function<void()>> fetchers;
     auto block = m_blockFactory->createBlock();
@@ -525,6 +595,234 @@ void Ledger::asyncGetBlockDataByNumber(bcos::protocol::BlockNumber _blockNumber,
     }
 }
 
+void Ledger::asyncGetBlockDataByRange(BlockNumber _startNumber, BlockNumber _endNumber,
+    int32_t _blockFlag, std::function<void(Error::Ptr, BlocksPtr, bool)> _onGetBlocks)
+{
+    LEDGER_LOG(DEBUG) << "GetBlockDataByRange request" << LOG_KV("startNumber", _startNumber)
+                      << LOG_KV("endNumber", _endNumber) << LOG_KV("blockFlag", _blockFlag);
+    if (_startNumber < 0 || _blockFlag < 0)
+    {
+        LEDGER_LOG(INFO) << "GetBlockDataByRange error, wrong argument";
+        _onGetBlocks(BCOS_ERROR_PTR(LedgerError::ErrorArgument, "Wrong argument"), nullptr, true);
+        return;
+    }
+    if (_startNumber > _endNumber)
+    {
+        _onGetBlocks(nullptr, std::make_shared<Blocks>(), true);
+        return;
+    }
+    auto batchEndNumber = std::min(_endNumber, _startNumber + c_rangeBatchSize - 1);
+    asyncGetBlockBatch(_startNumber, batchEndNumber, _blockFlag,
+        [this, batchEndNumber, _endNumber, _blockFlag, _onGetBlocks](
+            Error::Ptr&& error, BlocksPtr blocks) {
+            if (error)
+            {
+                LEDGER_LOG(ERROR) << "GetBlockDataByRange error"
+                                  << LOG_KV("batchEndNumber", batchEndNumber)
+                                  << LOG_KV("code", error->errorCode())
+                                  << LOG_KV("msg", error->errorMessage());
+                _onGetBlocks(std::move(error), nullptr, true);
+                return;
+            }
+            auto finished = (batchEndNumber == _endNumber);
+            _onGetBlocks(nullptr, std::move(blocks), finished);
+            if (!finished)
+            {
+                asyncGetBlockDataByRange(batchEndNumber + 1, _endNumber, _blockFlag, _onGetBlocks);
+            }
+        });
+}
+
+void Ledger::asyncGetBlockBatch(BlockNumber _startNumber, BlockNumber _endNumber,
+    int32_t _blockFlag, std::function<void(Error::Ptr&&, BlocksPtr)> _callback)
+{
+    auto blocks = std::make_shared<Blocks>();
+    // the blocks not in the cache and their numbers
+    auto uncachedBlocks = std::make_shared<Blocks>();
+    auto numbers = std::make_shared<std::vector<std::string>>();
+    for (auto number = _startNumber; number <= _endNumber; ++number)
+    {
+        auto block = m_blockFactory->createBlock();
+        blocks->emplace_back(block);
+        if (!m_ledgerCache->fillBlock(number, _blockFlag, *block))
+        {
+            uncachedBlocks->emplace_back(std::move(block));
+            numbers->emplace_back(boost::lexical_cast<std::string>(number));
+        }
+    }
+    if (numbers->empty() || !(_blockFlag & (HEADER | TRANSACTIONS | RECEIPTS)))
+    {
+        _callback(nullptr, std::move(blocks));
+        return;
+    }
+
+    auto fetchTransactions = [this, blocks, uncachedBlocks, numbers, _blockFlag, _callback]() {
+        if (!(_blockFlag & (TRANSACTIONS | RECEIPTS)))
+        {
+            _callback(nullptr, blocks);
+            return;
+        }
+        asyncGetRequiredRows(SYS_NUMBER_2_TXS, numbers,
+            [this, blocks, uncachedBlocks, _blockFlag, _callback](
+                Error::Ptr&& error, std::vector<std::optional<Entry>>&& entries) {
+                if (error)
+                {
+                    _callback(std::move(error), nullptr);
+                    return;
+                }
+                // the tx hashes of all the blocks, the txs of the i-th block are in
+                // [offsets[i], offsets[i + 1])
+                auto hashes = std::make_shared<std::vector<std::string>>();
+                auto offsets = std::make_shared<std::vector<size_t>>(1, 0);
+                for (auto& entry : entries)
+                {
+                    auto field = entry->getField(0);
+                    auto blockWithTxs = m_blockFactory->createBlock(
+                        bcos::bytesConstRef((bcos::byte*)field.data(), field.size()));
+                    for (size_t i = 0; i < blockWithTxs->transactionsHashSize(); ++i)
+                    {
+                        hashes->emplace_back(blockWithTxs->transactionHash(i).hex());
+                    }
+                    offsets->emplace_back(hashes->size());
+                }
+
+                auto fetchReceipts = [this, blocks, uncachedBlocks, hashes, offsets, _blockFlag,
+                                         _callback]() {
+                    if (!(_blockFlag & RECEIPTS) || hashes->empty())
+                    {
+                        _callback(nullptr, blocks);
+                        return;
+                    }
+                    asyncGetRequiredRows(SYS_HASH_2_RECEIPT, hashes,
+                        [this, blocks, uncachedBlocks, offsets, _callback](Error::Ptr&& error,
+                            std::vector<std::optional<Entry>>&& entries) {
+                            if (error)
+                            {
+                                _callback(std::move(error), nullptr);
+                                return;
+                            }
+                            std::vector<TransactionReceipt::Ptr> receipts(entries.size());
+                            tbb::parallel_for(tbb::blocked_range<size_t>(0, entries.size()),
+                                [&](const tbb::blocked_range<size_t>& range) {
+                                    for (size_t i = range.begin(); i < range.end(); ++i)
+                                    {
+                                        auto field = entries[i]->getField(0);
+                                        receipts[i] =
+                                            m_blockFactory->receiptFactory()->createReceipt(
+                                                bcos::bytesConstRef(
+                                                    (bcos::byte*)field.data(), field.size()));
+                                    }
+                                });
+                            for (size_t i = 0; i < uncachedBlocks->size(); ++i)
+                            {
+                                for (auto j = (*offsets)[i]; j < (*offsets)[i + 1]; ++j)
+                                {
+                                    (*uncachedBlocks)[i]->appendReceipt(std::move(receipts[j]));
+                                }
+                            }
+                            _callback(nullptr, blocks);
+                        });
+                };
+                if (!(_blockFlag & TRANSACTIONS) || hashes->empty())
+                {
+                    fetchReceipts();
+                    return;
+                }
+                asyncGetRequiredRows(SYS_HASH_2_TX, hashes,
+                    [this, uncachedBlocks, offsets, fetchReceipts, _callback](
+                        Error::Ptr&& error, std::vector<std::optional<Entry>>&& entries) {
+                        if (error)
+                        {
+                            _callback(std::move(error), nullptr);
+                            return;
+                        }
+                        std::vector<Transaction::Ptr> transactions(entries.size());
+                        tbb::parallel_for(tbb::blocked_range<size_t>(0, entries.size()),
+                            [&](const tbb::blocked_range<size_t>& range) {
+                                for (size_t i = range.begin(); i < range.end(); ++i)
+                                {
+                                    auto field = entries[i]->getField(0);
+                                    transactions[i] =
+                                        m_blockFactory->transactionFactory()->createTransaction(
+                                            bcos::bytesConstRef(
+                                                (bcos::byte*)field.data(), field.size()));
+                                }
+                            });
+                        for (size_t i = 0; i < uncachedBlocks->size(); ++i)
+                        {
+                            for (auto j = (*offsets)[i]; j < (*offsets)[i + 1]; ++j)
+                            {
+                                (*uncachedBlocks)[i]->appendTransaction(
+                                    std::move(transactions[j]));
+                            }
+                        }
+                        fetchReceipts();
+                    });
+            });
+    };
+
+    if (!(_blockFlag & HEADER))
+    {
+        fetchTransactions();
+        return;
+    }
+    asyncGetRequiredRows(SYS_NUMBER_2_BLOCK_HEADER, numbers,
+        [this, uncachedBlocks, fetchTransactions, _callback](
+            Error::Ptr&& error, std::vector<std::optional<Entry>>&& entries) {
+            if (error)
+            {
+                _callback(std::move(error), nullptr);
+                return;
+            }
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, entries.size()),
+                [&](const tbb::blocked_range<size_t>& range) {
+                    for (size_t i = range.begin(); i < range.end(); ++i)
+                    {
+                        auto field = entries[i]->getField(0);
+                        (*uncachedBlocks)[i]->setBlockHeader(
+                            m_blockFactory->blockHeaderFactory()->createBlockHeader(
+                                bcos::bytesConstRef((bcos::byte*)field.data(), field.size())));
+                    }
+                });
+            fetchTransactions();
+        });
+}
+
+void Ledger::asyncGetRequiredRows(const std::string_view& _table,
+    std::shared_ptr<std::vector<std::string>> _keys,
+    std::function<void(Error::Ptr&&, std::vector<std::optional<Entry>>&&)> _callback)
+{
+    m_storage->asyncGetRows(_table, *_keys,
+        [table = std::string(_table), _keys, _callback](
+            Error::UniquePtr error, std::vector<std::optional<Entry>> entries) {
+            if (error)
+            {
+                _callback(BCOS_ERROR_WITH_PREV_PTR(LedgerError::GetStorageError,
+                              "Get rows of " + table + " error", *error),
+                    {});
+                return;
+            }
+            if (entries.size() != _keys->size())
+            {
+                _callback(BCOS_ERROR_PTR(LedgerError::CollectAsyncCallbackError,
+                              "Get rows of " + table + " error, rows size not match keys size"),
+                    {});
+                return;
+            }
+            for (size_t i = 0; i < entries.size(); ++i)
+            {
+                if (!entries[i])
+                {
+                    _callback(BCOS_ERROR_PTR(LedgerError::GetStorageError,
+                                  "Get rows of " + table + " error, not found: " + (*_keys)[i]),
+                        {});
+                    return;
+                }
+            }
+            _callback(nullptr, std::move(entries));
+        });
+}
+
 void Ledger::asyncGetBlockNumber(
     std::function<void(Error::Ptr, bcos::protocol::BlockNumber)> _onGetBlock)
 {
@@ -664,6 +962,85 @@ void Ledger::asyncGetBatchTxsByHashList(crypto::HashListPtr _txHashList, bool _w
     LEDGER_LOG(TRACE) << "GetBatchTxsByHashList request" << LOG_KV("hashes", _txHashList->size())
                       << LOG_KV("withProof", _withProof);
 
+    auto onGetTxs = [this, callback = std::move(_onGetTx), _txHashList, _withProof](
+                        Error::Ptr&& error, std::vector<Transaction::Ptr>&& transactions) {
+        if (error)
+        {
+            LEDGER_LOG(TRACE) << "GetBatchTxsByHashList error: "
+                              << boost::diagnostic_information(error);
+            callback(BCOS_ERROR_WITH_PREV_PTR(
+                         LedgerError::GetStorageError, "GetBatchTxsByHashList error", *error),
+                nullptr, nullptr);
+            return;
+        }
+
+        bcos::protocol::TransactionsPtr results =
+            std::make_shared<bcos::protocol::Transactions>(std::move(transactions));
+
+        if (_withProof)
+        {
+            auto con_proofMap =
+                std::make_shared<tbb::concurrent_unordered_map<std::string, MerkleProofPtr>>();
+            auto count = std::make_shared<std::atomic_uint64_t>(0);
+            auto counter = [_txList = results, _txHashList, count, con_proofMap,
+                               callback = callback]() {
+                count->fetch_add(1);
+                if (count->load() == _txHashList->size())
+                {
+                    auto proofMap = std::make_shared<std::map<std::string, MerkleProofPtr>>(
+                        con_proofMap->begin(), con_proofMap->end());
+                    LEDGER_LOG(INFO) << LOG_BADGE("GetBatchTxsByHashList success")
+                                     << LOG_KV("txHashListSize", _txHashList->size())
+                                     << LOG_KV("proofMapSize", proofMap->size());
+                    callback(nullptr, _txList, proofMap);
+                }
+            };
+
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, _txHashList->size()),
+                [this, _txHashList, counter, con_proofMap](
+                    const tbb::blocked_range<size_t>& range) {
+                    for (size_t i = range.begin(); i < range.end(); ++i)
+                    {
+                        auto txHash = _txHashList->at(i);
+                        getTxProof(txHash, [con_proofMap, txHash, counter](
+                                               Error::Ptr _error, MerkleProofPtr _proof) {
+                            if (!_error && _proof)
+                            {
+                                con_proofMap->insert(std::make_pair(txHash.hex(), _proof));
+                            }
+                            counter();
+                        });
+                    }
+                });
+        }
+        else
+        {
+            LEDGER_LOG(TRACE) << LOG_BADGE("GetBatchTxsByHashList success")
+                              << LOG_KV("txHashListSize", _txHashList->size())
+                              << LOG_KV("withProof", _withProof);
+            callback(nullptr, results, nullptr);
+        }
+    };
+
+    // all the txs are in the recent blocks in most cases, the cached txs are shared with the
+    // callers, and the callers that modify them copy them first
+    std::vector<protocol::Transaction::Ptr> cachedTxs;
+    cachedTxs.reserve(_txHashList->size());
+    for (auto const& hash : *_txHashList)
+    {
+        auto tx = m_ledgerCache->transaction(hash);
+        if (!tx)
+        {
+            break;
+        }
+        cachedTxs.emplace_back(std::const_pointer_cast<Transaction>(tx));
+    }
+    if (cachedTxs.size() == _txHashList->size())
+    {
+        onGetTxs(nullptr, std::move(cachedTxs));
+        return;
+    }
+
     auto hexList = std::make_shared<std::vector<std::string>>();
     hexList->reserve(_txHashList->size());
 
@@ -671,67 +1048,7 @@ void Ledger::asyncGetBatchTxsByHashList(crypto::HashListPtr _txHashList, bool _w
     {
         hexList->push_back(it.hex());
     }
-
-    asyncBatchGetTransactions(
-        hexList, [this, callback = std::move(_onGetTx), _txHashList, _withProof](
-                     Error::Ptr&& error, std::vector<protocol::Transaction::Ptr>&& transactions) {
-            if (error)
-            {
-                LEDGER_LOG(TRACE) << "GetBatchTxsByHashList error: "
-                                  << boost::diagnostic_information(error);
-                callback(BCOS_ERROR_WITH_PREV_PTR(
-                             LedgerError::GetStorageError, "GetBatchTxsByHashList error", *error),
-                    nullptr, nullptr);
-                return;
-            }
-
-            bcos::protocol::TransactionsPtr results =
-                std::make_shared<bcos::protocol::Transactions>(std::move(transactions));
-
-            if (_withProof)
-            {
-                auto con_proofMap =
-                    std::make_shared<tbb::concurrent_unordered_map<std::string, MerkleProofPtr>>();
-                auto count = std::make_shared<std::atomic_uint64_t>(0);
-                auto counter = [_txList = results, _txHashList, count, con_proofMap,
-                                   callback = callback]() {
-                    count->fetch_add(1);
-                    if (count->load() == _txHashList->size())
-                    {
-                        auto proofMap = std::make_shared<std::map<std::string, MerkleProofPtr>>(
-                            con_proofMap->begin(), con_proofMap->end());
-                        LEDGER_LOG(INFO) << LOG_BADGE("GetBatchTxsByHashList success")
-                                         << LOG_KV("txHashListSize", _txHashList->size())
-                                         << LOG_KV("proofMapSize", proofMap->size());
-                        callback(nullptr, _txList, proofMap);
-                    }
-                };
-
-                tbb::parallel_for(tbb::blocked_range<size_t>(0, _txHashList->size()),
-                    [this, _txHashList, counter, con_proofMap](
-                        const tbb::blocked_range<size_t>& range) {
-                        for (size_t i = range.begin(); i < range.end(); ++i)
-                        {
-                            auto txHash = _txHashList->at(i);
-                            getTxProof(txHash, [con_proofMap, txHash, counter](
-                                                   Error::Ptr _error, MerkleProofPtr _proof) {
-                                if (!_error && _proof)
-                                {
-                                    con_proofMap->insert(std::make_pair(txHash.hex(), _proof));
-                                }
-                                counter();
-                            });
-                        }
-                    });
-            }
-            else
-            {
-                LEDGER_LOG(TRACE) << LOG_BADGE("GetBatchTxsByHashList success")
-                                  << LOG_KV("txHashListSize", _txHashList->size())
-                                  << LOG_KV("withProof", _withProof);
-                callback(nullptr, results, nullptr);
-            }
-        });
+    asyncBatchGetTransactions(hexList, std::move(onGetTxs));
 }
 
 void Ledger::asyncGetTransactionReceiptByHash(bcos::crypto::HashType const& _txHash,
@@ -743,46 +1060,62 @@ void Ledger::asyncGetTransactionReceiptByHash(bcos::crypto::HashType const& _txH
 
     LEDGER_LOG(TRACE) << "GetTransactionReceiptByHash" << LOG_KV("hash", key);
 
+    auto onGetReceipt = [this, callback = std::move(_onGetTx), key, _withProof](
+                            Error::Ptr&& error, TransactionReceipt::ConstPtr receipt) {
+        if (error)
+        {
+            LEDGER_LOG(ERROR) << "GetTransactionReceiptByHash error"
+                              << boost::diagnostic_information(error);
+            callback(BCOS_ERROR_WITH_PREV_PTR(
+                         LedgerError::GetStorageError, "GetTransactionReceiptByHash", *error),
+                nullptr, nullptr);
+
+            return;
+        }
+
+        if (_withProof)
+        {
+            getReceiptProof(
+                receipt, [receipt, _onGetTx = callback](Error::Ptr _error, MerkleProofPtr _proof) {
+                    if (_error)
+                    {
+                        LEDGER_LOG(ERROR) << "GetTransactionReceiptByHash error"
+                                          << LOG_KV("errorCode", _error->errorCode())
+                                          << LOG_KV("errorMsg", _error->errorMessage())
+                                          << boost::diagnostic_information(_error);
+                        _onGetTx(std::move(_error), receipt, nullptr);
+                        return;
+                    }
+
+                    _onGetTx(nullptr, receipt, std::move(_proof));
+                });
+        }
+        else
+        {
+            LEDGER_LOG(TRACE) << "GetTransactionReceiptByHash success" << LOG_KV("hash", key);
+            callback(nullptr, receipt, nullptr);
+        }
+    };
+
+    auto receipt = m_ledgerCache->receipt(_txHash);
+    if (receipt)
+    {
+        onGetReceipt(nullptr, std::move(receipt));
+        return;
+    }
     asyncGetSystemTableEntry(SYS_HASH_2_RECEIPT, key,
-        [this, callback = std::move(_onGetTx), key, _withProof](
+        [this, onGetReceipt = std::move(onGetReceipt)](
             Error::Ptr&& error, std::optional<bcos::storage::Entry>&& entry) {
             if (error)
             {
-                LEDGER_LOG(ERROR) << "GetTransactionReceiptByHash error"
-                                  << boost::diagnostic_information(error);
-                callback(BCOS_ERROR_WITH_PREV_PTR(
-                             LedgerError::GetStorageError, "GetTransactionReceiptByHash", *error),
-                    nullptr, nullptr);
-
+                onGetReceipt(std::move(error), nullptr);
                 return;
             }
 
             auto value = entry->getField(0);
             auto receipt = m_blockFactory->receiptFactory()->createReceipt(
                 bcos::bytesConstRef((bcos::byte*)value.data(), value.size()));
-
-            if (_withProof)
-            {
-                getReceiptProof(receipt,
-                    [receipt, _onGetTx = callback](Error::Ptr _error, MerkleProofPtr _proof) {
-                        if (_error)
-                        {
-                            LEDGER_LOG(ERROR) << "GetTransactionReceiptByHash error"
-                                              << LOG_KV("errorCode", _error->errorCode())
-                                              << LOG_KV("errorMsg", _error->errorMessage())
-                                              << boost::diagnostic_information(_error);
-                            _onGetTx(std::move(_error), receipt, nullptr);
-                            return;
-                        }
-
-                        _onGetTx(nullptr, receipt, std::move(_proof));
-                    });
-            }
-            else
-            {
-                LEDGER_LOG(TRACE) << "GetTransactionReceiptByHash success" << LOG_KV("hash", key);
-                callback(nullptr, receipt, nullptr);
-            }
+            onGetReceipt(nullptr, std::move(receipt));
         });
 }
 
@@ -1342,8 +1675,9 @@ void Ledger::getTxProof(
                 _onGetProof(std::forward<decltype(_error)>(_error), nullptr);
                 return;
             }
-            asyncGetBlockTransactionHashes(_receipt->blockNumber(),
-                [this, _onGetProof, _txHash = std::move(_txHash)](
+            auto blockNumber = _receipt->blockNumber();
+            asyncGetBlockTransactionHashes(blockNumber,
+                [this, blockNumber, _onGetProof, _txHash = std::move(_txHash)](
                     Error::Ptr&& _error, std::vector<std::string>&& _hashList) {
                     if (_error || _hashList.empty())
                     {
@@ -1354,52 +1688,59 @@ void Ledger::getTxProof(
                         _onGetProof(std::forward<decltype(_error)>(_error), nullptr);
                         return;
                     }
-                    asyncBatchGetTransactions(std::make_shared<std::vector<std::string>>(_hashList),
-                        [cryptoSuite = m_blockFactory->cryptoSuite(), _onGetProof,
-                            _txHash = std::move(_txHash)](
-                            Error::Ptr&& _error, std::vector<Transaction::Ptr>&& _txList) {
-                            if (_error || _txList.empty())
-                            {
-                                LEDGER_LOG(ERROR)
-                                    << LOG_BADGE("getTxProof") << LOG_DESC("getTxs callback error")
-                                    << LOG_KV("errorCode", _error->errorCode())
-                                    << LOG_KV("errorMsg", _error->errorMessage());
-                                _onGetProof(std::forward<decltype(_error)>(_error), nullptr);
-                                return;
-                            }
-
-                            auto merkleProofPtr = std::make_shared<MerkleProof>();
-                            auto merkleProofUtility = std::make_shared<MerkleProofUtility>();
-
-                            merkleProofUtility->getMerkleProof(_txHash,
-                                std::forward<decltype(_txList)>(_txList), cryptoSuite,
-                                merkleProofPtr);
-                            LEDGER_LOG(TRACE)
-                                << LOG_BADGE("getTxProof") << LOG_DESC("get merkle proof success")
-                                << LOG_KV("txHash", _txHash.hex());
-                            _onGetProof(nullptr, std::move(merkleProofPtr));
-                        });
+                    // the leaves of the txs tree are the tx hashes, needn't load the txs
+                    auto txHashes = toHashList(_hashList);
+                    auto txsTree = m_merkleTreeCache->txsTree(blockNumber, txHashes);
+                    if (!txsTree)
+                    {
+                        txsTree = std::make_shared<MerkleTree>(
+                            m_blockFactory->cryptoSuite(), std::move(txHashes));
+                        m_merkleTreeCache->insert(blockNumber, txsTree);
+                    }
+                    auto merkleProofPtr = txsTree->proof(_txHash);
+                    if (!merkleProofPtr)
+                    {
+                        merkleProofPtr = std::make_shared<MerkleProof>();
+                    }
+                    LEDGER_LOG(TRACE)
+                        << LOG_BADGE("getTxProof") << LOG_DESC("get merkle proof success")
+                        << LOG_KV("txHash", _txHash.hex());
+                    _onGetProof(nullptr, std::move(merkleProofPtr));
                 });
         });
 }
 
-void Ledger::getReceiptProof(protocol::TransactionReceipt::Ptr _receipt,
+void Ledger::getReceiptProof(protocol::TransactionReceipt::ConstPtr _receipt,
     std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof)
 {
     // receipt->number number->txs txs->receipts
-    asyncGetBlockTransactionHashes(_receipt->blockNumber(),
-        [this, _onGetProof = std::move(_onGetProof), receiptHash = _receipt->hash()](
+    auto blockNumber = _receipt->blockNumber();
+    asyncGetBlockTransactionHashes(blockNumber,
+        [this, blockNumber, _onGetProof = std::move(_onGetProof),
+            receiptHash = _receipt->hash()](
             Error::Ptr&& _error, std::vector<std::string>&& _hashList) {
             if (_error)
             {
                 _onGetProof(std::forward<decltype(_error)>(_error), nullptr);
                 return;
             }
+            auto txHashes = toHashList(_hashList);
+            auto receiptsTree = m_merkleTreeCache->receiptsTree(blockNumber, txHashes);
+            if (receiptsTree)
+            {
+                auto merkleProof = receiptsTree->proof(receiptHash);
+                if (!merkleProof)
+                {
+                    merkleProof = std::make_shared<MerkleProof>();
+                }
+                _onGetProof(nullptr, std::move(merkleProof));
+                return;
+            }
 
             asyncBatchGetReceipts(std::make_shared<std::vector<std::string>>(_hashList),
-                [cryptoSuite = this->m_blockFactory->cryptoSuite(), _onGetProof,
+                [this, blockNumber, txHashes = std::move(txHashes), _onGetProof,
                     receiptHash = receiptHash](Error::Ptr&& _error,
-                    std::vector<protocol::TransactionReceipt::Ptr>&& _receiptList) {
+                    std::vector<protocol::TransactionReceipt::Ptr>&& _receiptList) mutable {
                     if (_error || _receiptList.empty())
                     {
                         LEDGER_LOG(ERROR) << LOG_BADGE("getReceiptProof")
@@ -1407,11 +1748,31 @@ void Ledger::getReceiptProof(protocol::TransactionReceipt::Ptr _receipt,
                         _onGetProof(std::forward<decltype(_error)>(_error), nullptr);
                         return;
                     }
-                    auto merkleProof = std::make_shared<MerkleProof>();
-                    auto merkleProofUtility = std::make_shared<MerkleProofUtility>();
-                    merkleProofUtility->getMerkleProof(receiptHash,
-                        std::forward<decltype(_receiptList)>(_receiptList), cryptoSuite,
-                        merkleProof);
+                    std::vector<HashType> receiptHashes(_receiptList.size());
+                    tbb::parallel_for(tbb::blocked_range<size_t>(0, _receiptList.size()),
+                        [&](const tbb::blocked_range<size_t>& range) {
+                            for (size_t i = range.begin(); i < range.end(); ++i)
+                            {
+                                receiptHashes[i] = _receiptList[i]->hash();
+                            }
+                        });
+                    auto cryptoSuite = m_blockFactory->cryptoSuite();
+                    auto receiptsTree =
+                        std::make_shared<MerkleTree>(cryptoSuite, std::move(receiptHashes));
+                    if (receiptsTree->leavesSize() == txHashes.size())
+                    {
+                        auto txsTree = m_merkleTreeCache->txsTree(blockNumber, txHashes);
+                        if (!txsTree)
+                        {
+                            txsTree = std::make_shared<MerkleTree>(cryptoSuite, txHashes);
+                        }
+                        m_merkleTreeCache->insert(blockNumber, txsTree, receiptsTree);
+                    }
+                    auto merkleProof = receiptsTree->proof(receiptHash);
+                    if (!merkleProof)
+                    {
+                        merkleProof = std::make_shared<MerkleProof>();
+                    }
                     LEDGER_LOG(INFO)
                         << LOG_BADGE("getReceiptProof") << LOG_DESC("call back receipt and proof");
                     _onGetProof(nullptr, std::move(merkleProof));
@@ -25,7 +25,8 @@
 #include "bcos-framework/interfaces/protocol/ProtocolTypeDef.h"
 #include "bcos-framework/interfaces/storage/Common.h"
 #include "bcos-framework/interfaces/storage/StorageInterface.h"
-#include "utilities/MerkleProofUtility.h"
+#include "utilities/LedgerCache.h"
+#include "utilities/MerkleTreeCache.h"
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/Exceptions.h>
 #include <bcos-utilities/ThreadPool.h>
@@ -61,6 +62,10 @@ public:
     void asyncGetBlockDataByNumber(bcos::protocol::BlockNumber _blockNumber, int32_t _blockFlag,
         std::function<void(Error::Ptr, bcos::protocol::Block::Ptr)> _onGetBlock) override;
 
+    void asyncGetBlockDataByRange(bcos::protocol::BlockNumber _startNumber,
+        bcos::protocol::BlockNumber _endNumber, int32_t _blockFlag,
+        std::function<void(Error::Ptr, bcos::protocol::BlocksPtr, bool)> _onGetBlocks) override;
+
     void asyncGetBlockNumber(
         std::function<void(Error::Ptr, bcos::protocol::BlockNumber)> _onGetBlock) override;
 
@@ -96,6 +101,11 @@ public:
     void asyncGetNodeListByType(const std::string& _type,
         std::function<void(Error::Ptr, consensus::ConsensusNodeListPtr)> _onGetConfig) override;
 
+    void removeBlockCache(bcos::protocol::BlockNumber _blockNumber) override
+    {
+        m_ledgerCache->remove(_blockNumber);
+    }
+
     /****** init ledger ******/
     bool buildGenesisBlock(LedgerConfig::Ptr _ledgerConfig, size_t _gasLimit,
         const std::string& _genesisData, std::string const& _compatibilityVersion);
@@ -120,13 +130,24 @@ private:
         std::function<void(Error::Ptr&&, std::vector<protocol::TransactionReceipt::Ptr>&&)>
             callback);
 
+    // get the blocks in [_startNumber, _endNumber], the rows of every table are read in one batch
+    void asyncGetBlockBatch(bcos::protocol::BlockNumber _startNumber,
+        bcos::protocol::BlockNumber _endNumber, int32_t _blockFlag,
+        std::function<void(Error::Ptr&&, bcos::protocol::BlocksPtr)> _callback);
+
+    // all the rows of the keys are required
+    void asyncGetRequiredRows(const std::string_view& _table,
+        std::shared_ptr<std::vector<std::string>> _keys,
+        std::function<void(Error::Ptr&&, std::vector<std::optional<bcos::storage::Entry>>&&)>
+            _callback);
+
     void asyncGetSystemTableEntry(const std::string_view& table, const std::string_view& key,
         std::function<void(Error::Ptr&&, std::optional<bcos::storage::Entry>&&)> callback);
 
     void getTxProof(const crypto::HashType& _txHash,
         std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof);
 
-    void getReceiptProof(protocol::TransactionReceipt::Ptr _receipt,
+    void getReceiptProof(protocol::TransactionReceipt::ConstPtr _receipt,
         std::function<void(Error::Ptr&&, MerkleProofPtr&&)> _onGetProof);
 
     void createFileSystemTables();
@@ -143,7 +164,12 @@ private:
     needStoreUnsavedTxs(
         bcos::protocol::TransactionsPtr _blockTxs, bcos::protocol::Block::ConstPtr _block);
 
+    // the blocks of a batch of asyncGetBlockDataByRange
+    static constexpr bcos::protocol::BlockNumber c_rangeBatchSize = 32;
+
     bcos::protocol::BlockFactory::Ptr m_blockFactory;
     bcos::storage::StorageInterface::Ptr m_storage;
+    MerkleTreeCache::Ptr m_merkleTreeCache = std::make_shared<MerkleTreeCache>();
+    LedgerCache::Ptr m_ledgerCache = std::make_shared<LedgerCache>();
 };
 }  // namespace bcos::ledger
\ No newline at end of file
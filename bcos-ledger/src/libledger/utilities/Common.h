@@ -20,18 +20,12 @@
 #pragma once
 #include <bcos-framework/interfaces/consensus/ConsensusNodeInterface.h>
 #include <bcos-framework/interfaces/protocol/Block.h>
-#include <tbb/concurrent_unordered_map.h>
 #include <map>
 
 #define LEDGER_LOG(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE("LEDGER")
 
 namespace bcos::ledger
 {
-// parent=>children
-using Parent2ChildListMap = std::map<std::string, std::vector<std::string>>;
-// child=>parent
-using Child2ParentMap = tbb::concurrent_unordered_map<std::string, std::string>;
-
 static const char* const SYS_VALUE = "value";
 static const char* const SYS_CONFIG_ENABLE_BLOCK_NUMBER = "enable_number";
 
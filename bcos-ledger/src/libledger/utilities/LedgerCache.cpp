@@ -0,0 +1,219 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file LedgerCache.cpp
+ * @date 2022-07-25
+ */
+
+#include "LedgerCache.h"
+#include "Common.h"
+#include <bcos-framework/interfaces/ledger/LedgerTypeDef.h>
+
+using namespace bcos;
+using namespace bcos::crypto;
+using namespace bcos::protocol;
+using namespace bcos::ledger;
+
+void LedgerCache::insert(BlockHeader::ConstPtr _header, std::vector<HashType> _txHashes,
+    std::vector<Transaction::ConstPtr> _txs, std::vector<TransactionReceipt::ConstPtr> _receipts)
+{
+    if (!_header)
+    {
+        return;
+    }
+    if (!_txs.empty() && _txs.size() != _txHashes.size())
+    {
+        _txs.clear();
+    }
+    if (!_receipts.empty() && _receipts.size() != _txHashes.size())
+    {
+        _receipts.clear();
+    }
+    auto blockData = std::make_shared<BlockData>();
+    blockData->header = std::move(_header);
+    blockData->txHashes = std::move(_txHashes);
+    blockData->txs = std::move(_txs);
+    blockData->receipts = std::move(_receipts);
+
+    WriteGuard l(x_blocks);
+    auto number = blockData->header->number();
+    auto it = m_blocks.find(number);
+    if (it != m_blocks.end())
+    {
+        // the block is rewritten after rollback
+        removeBlock(it);
+    }
+    for (size_t i = 0; i < blockData->txHashes.size(); ++i)
+    {
+        auto const& hash = blockData->txHashes[i];
+        auto& txShard = shard(hash);
+        WriteGuard shardLock(txShard.mutex);
+        if (!blockData->txs.empty())
+        {
+            txShard.txs[hash] = blockData->txs[i];
+        }
+        if (!blockData->receipts.empty())
+        {
+            txShard.receipts[hash] = blockData->receipts[i];
+        }
+    }
+    m_txsNum += blockData->txHashes.size();
+    m_blocks.emplace(number, std::move(blockData));
+    // the newest block is kept even if it exceeds the tx capacity
+    while (m_blocks.size() > m_blockCapacity ||
+           (m_txsNum > m_txCapacity && m_blocks.size() > 1))
+    {
+        removeBlock(m_blocks.begin());
+    }
+}
+
+void LedgerCache::remove(BlockNumber _number)
+{
+    WriteGuard l(x_blocks);
+    auto it = m_blocks.find(_number);
+    if (it != m_blocks.end())
+    {
+        removeBlock(it);
+    }
+}
+
+void LedgerCache::removeBlock(std::map<BlockNumber, BlockData::Ptr>::iterator _it)
+{
+    auto const& blockData = _it->second;
+    for (size_t i = 0; i < blockData->txHashes.size(); ++i)
+    {
+        auto const& hash = blockData->txHashes[i];
+        auto& txShard = shard(hash);
+        WriteGuard shardLock(txShard.mutex);
+        // only remove the objects of this block
+        auto txIt = txShard.txs.find(hash);
+        if (txIt != txShard.txs.end() && !blockData->txs.empty() &&
+            txIt->second == blockData->txs[i])
+        {
+            txShard.txs.erase(txIt);
+        }
+        auto receiptIt = txShard.receipts.find(hash);
+        if (receiptIt != txShard.receipts.end() && !blockData->receipts.empty() &&
+            receiptIt->second == blockData->receipts[i])
+        {
+            txShard.receipts.erase(receiptIt);
+        }
+    }
+    m_txsNum -= blockData->txHashes.size();
+    m_blocks.erase(_it);
+}
+
+bool LedgerCache::fillBlock(BlockNumber _number, int32_t _blockFlag, Block& _block)
+{
+    BlockData::Ptr blockData;
+    {
+        ReadGuard l(x_blocks);
+        auto it = m_blocks.find(_number);
+        if (it != m_blocks.end())
+        {
+            blockData = it->second;
+        }
+    }
+    // the txs and receipts of the empty block are cached as well
+    bool hit = blockData && (!(_blockFlag & TRANSACTIONS) || !blockData->txs.empty() ||
+                                blockData->txHashes.empty()) &&
+               (!(_blockFlag & RECEIPTS) || !blockData->receipts.empty() ||
+                   blockData->txHashes.empty());
+    m_blockHitRate.record(hit);
+    if (!hit)
+    {
+        return false;
+    }
+    // the block keeps its own copies of the data of the header, txs and receipts set into it, so
+    // the cached objects are not modified through the block
+    if (_blockFlag & HEADER)
+    {
+        _block.setBlockHeader(std::const_pointer_cast<BlockHeader>(blockData->header));
+    }
+    if (_blockFlag & TRANSACTIONS)
+    {
+        for (auto const& tx : blockData->txs)
+        {
+            _block.appendTransaction(std::const_pointer_cast<Transaction>(tx));
+        }
+    }
+    if (_blockFlag & RECEIPTS)
+    {
+        for (auto const& receipt : blockData->receipts)
+        {
+            _block.appendReceipt(std::const_pointer_cast<TransactionReceipt>(receipt));
+        }
+    }
+    return true;
+}
+
+Transaction::ConstPtr LedgerCache::transaction(HashType const& _txHash)
+{
+    auto& txShard = shard(_txHash);
+    Transaction::ConstPtr tx = nullptr;
+    {
+        ReadGuard l(txShard.mutex);
+        auto it = txShard.txs.find(_txHash);
+        if (it != txShard.txs.end())
+        {
+            tx = it->second;
+        }
+    }
+    m_txHitRate.record(tx != nullptr);
+    return tx;
+}
+
+TransactionReceipt::ConstPtr LedgerCache::receipt(HashType const& _txHash)
+{
+    auto& txShard = shard(_txHash);
+    TransactionReceipt::ConstPtr receipt = nullptr;
+    {
+        ReadGuard l(txShard.mutex);
+        auto it = txShard.receipts.find(_txHash);
+        if (it != txShard.receipts.end())
+        {
+            receipt = it->second;
+        }
+    }
+    m_receiptHitRate.record(receipt != nullptr);
+    return receipt;
+}
+
+void LedgerCache::report()
+{
+    auto hitRate = [](HitRate& _hitRate) {
+        uint64_t hits = _hitRate.hits.exchange(0);
+        uint64_t misses = _hitRate.misses.exchange(0);
+        auto total = hits + misses;
+        return std::make_tuple(hits, total, total == 0 ? 0.0 : (double)hits / total);
+    };
+    auto [blockHits, blockReads, blockHitRate] = hitRate(m_blockHitRate);
+    auto [txHits, txReads, txHitRate] = hitRate(m_txHitRate);
+    auto [receiptHits, receiptReads, receiptHitRate] = hitRate(m_receiptHitRate);
+    size_t blocks = 0;
+    size_t txs = 0;
+    {
+        ReadGuard l(x_blocks);
+        blocks = m_blocks.size();
+        txs = m_txsNum;
+    }
+    LEDGER_LOG(INFO) << METRIC << LOG_DESC("ledgerCache") << LOG_KV("blocks", blocks)
+                     << LOG_KV("txs", txs) << LOG_KV("blockReads", blockReads)
+                     << LOG_KV("blockHits", blockHits) << LOG_KV("blockHitRate", blockHitRate)
+                     << LOG_KV("txReads", txReads) << LOG_KV("txHits", txHits)
+                     << LOG_KV("txHitRate", txHitRate) << LOG_KV("receiptReads", receiptReads)
+                     << LOG_KV("receiptHits", receiptHits)
+                     << LOG_KV("receiptHitRate", receiptHitRate);
+}
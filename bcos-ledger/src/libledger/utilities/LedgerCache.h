@@ -0,0 +1,110 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file LedgerCache.h
+ * @date 2022-07-25
+ */
+
+#pragma once
+
+#include <bcos-framework/interfaces/protocol/Block.h>
+#include <bcos-framework/interfaces/protocol/Block.h>
+#include <bcos-utilities/Common.h>
+#include <array>
+#include <atomic>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos::ledger
+{
+/**
+ * the decoded headers, txs and receipts of the recent blocks, filled when the block is prewritten
+ * and removed when the block is rolled back, so the reads of the latest blocks needn't query the
+ * storage or decode the objects again. the cached objects are shared with the callers as const
+ * objects, the callers that modify them should copy them first.
+ * the txs and receipts are sharded by the hash to reduce the lock contention of the reads
+ */
+class LedgerCache
+{
+public:
+    using Ptr = std::shared_ptr<LedgerCache>;
+    // the oldest blocks are evicted when the blocks or the txs exceed the capacity
+    explicit LedgerCache(size_t _blockCapacity = 128, size_t _txCapacity = 100000)
+      : m_blockCapacity(std::max(_blockCapacity, (size_t)1)), m_txCapacity(_txCapacity)
+    {}
+
+    // the txs or receipts are empty if they are not in the block, otherwise they are in the
+    // order of the tx hashes
+    void insert(protocol::BlockHeader::ConstPtr _header, std::vector<crypto::HashType> _txHashes,
+        std::vector<protocol::Transaction::ConstPtr> _txs,
+        std::vector<protocol::TransactionReceipt::ConstPtr> _receipts);
+    void remove(protocol::BlockNumber _number);
+
+    // fill the header, txs and receipts required by the flag into the block, false if any of them
+    // is not cached
+    bool fillBlock(protocol::BlockNumber _number, int32_t _blockFlag, protocol::Block& _block);
+    // the cached tx or receipt, nullptr if it is not cached
+    protocol::Transaction::ConstPtr transaction(crypto::HashType const& _txHash);
+    protocol::TransactionReceipt::ConstPtr receipt(crypto::HashType const& _txHash);
+
+    // print the hit rates since the last report
+    void report();
+
+private:
+    struct BlockData
+    {
+        using Ptr = std::shared_ptr<const BlockData>;
+        protocol::BlockHeader::ConstPtr header;
+        std::vector<crypto::HashType> txHashes;
+        std::vector<protocol::Transaction::ConstPtr> txs;
+        std::vector<protocol::TransactionReceipt::ConstPtr> receipts;
+    };
+    struct Shard
+    {
+        std::unordered_map<crypto::HashType, protocol::Transaction::ConstPtr,
+            std::hash<crypto::HashType>>
+            txs;
+        std::unordered_map<crypto::HashType, protocol::TransactionReceipt::ConstPtr,
+            std::hash<crypto::HashType>>
+            receipts;
+        mutable SharedMutex mutex;
+    };
+    struct HitRate
+    {
+        std::atomic<uint64_t> hits = {0};
+        std::atomic<uint64_t> misses = {0};
+        void record(bool _hit) { _hit ? ++hits : ++misses; }
+    };
+    static constexpr size_t c_shardsNum = 16;
+    Shard& shard(crypto::HashType const& _hash)
+    {
+        return m_shards[std::hash<crypto::HashType>()(_hash) % c_shardsNum];
+    }
+    // remove the block with x_blocks locked
+    void removeBlock(std::map<protocol::BlockNumber, BlockData::Ptr>::iterator _it);
+
+    size_t m_blockCapacity;
+    size_t m_txCapacity;
+    std::map<protocol::BlockNumber, BlockData::Ptr> m_blocks;
+    size_t m_txsNum = 0;
+    mutable SharedMutex x_blocks;
+    std::array<Shard, c_shardsNum> m_shards;
+
+    HitRate m_blockHitRate;
+    HitRate m_txHitRate;
+    HitRate m_receiptHitRate;
+};
+}  // namespace bcos::ledger
@@ -0,0 +1,64 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file MerkleTreeCache.cpp
+ * @date 2022-07-20
+ */
+
+#include "MerkleTreeCache.h"
+
+using namespace bcos;
+using namespace bcos::crypto;
+using namespace bcos::ledger;
+
+void MerkleTreeCache::insert(
+    protocol::BlockNumber _number, MerkleTree::Ptr _txsTree, MerkleTree::Ptr _receiptsTree)
+{
+    if (!_txsTree)
+    {
+        return;
+    }
+    WriteGuard l(x_trees);
+    m_trees[_number] = BlockTrees{std::move(_txsTree), std::move(_receiptsTree)};
+    // the proofs of the old blocks are rarely requested
+    while (m_trees.size() > m_capacity)
+    {
+        m_trees.erase(m_trees.begin());
+    }
+}
+
+MerkleTree::Ptr MerkleTreeCache::txsTree(
+    protocol::BlockNumber _number, std::vector<HashType> const& _txHashes) const
+{
+    ReadGuard l(x_trees);
+    auto it = m_trees.find(_number);
+    if (it == m_trees.end() || !it->second.txs->match(_txHashes))
+    {
+        return nullptr;
+    }
+    return it->second.txs;
+}
+
+MerkleTree::Ptr MerkleTreeCache::receiptsTree(
+    protocol::BlockNumber _number, std::vector<HashType> const& _txHashes) const
+{
+    ReadGuard l(x_trees);
+    auto it = m_trees.find(_number);
+    if (it == m_trees.end() || !it->second.receipts || !it->second.txs->match(_txHashes))
+    {
+        return nullptr;
+    }
+    return it->second.receipts;
+}
@@ -0,0 +1,60 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @file MerkleTreeCache.h
+ * @date 2022-07-20
+ */
+
+#pragma once
+
+#include <bcos-framework/interfaces/protocol/ProtocolTypeDef.h>
+#include <bcos-protocol/MerkleTree.h>
+#include <bcos-utilities/Common.h>
+#include <map>
+#include <vector>
+
+namespace bcos::ledger
+{
+using MerkleTree = protocol::MerkleTree;
+
+// the merkle trees of the recent blocks, built when the block is written, so the proofs of the txs
+// and receipts needn't reload and rehash the whole block
+class MerkleTreeCache
+{
+public:
+    using Ptr = std::shared_ptr<MerkleTreeCache>;
+    explicit MerkleTreeCache(size_t _capacity = 256) : m_capacity(_capacity) {}
+
+    // the receipts tree is keyed by the txs of the block, the txs tree is required
+    void insert(protocol::BlockNumber _number, MerkleTree::Ptr _txsTree,
+        MerkleTree::Ptr _receiptsTree = nullptr);
+    // the tree is returned only if the txs of the cached block are the same as the given txs,
+    // the block may be rolled back and rewritten
+    MerkleTree::Ptr txsTree(
+        protocol::BlockNumber _number, std::vector<crypto::HashType> const& _txHashes) const;
+    MerkleTree::Ptr receiptsTree(
+        protocol::BlockNumber _number, std::vector<crypto::HashType> const& _txHashes) const;
+
+private:
+    struct BlockTrees
+    {
+        MerkleTree::Ptr txs;
+        MerkleTree::Ptr receipts;
+    };
+    size_t m_capacity;
+    std::map<protocol::BlockNumber, BlockTrees> m_trees;
+    mutable SharedMutex x_trees;
+};
+}  // namespace bcos::ledger
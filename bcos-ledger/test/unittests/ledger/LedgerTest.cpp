@@ -26,6 +26,8 @@
 #include "bcos-framework/interfaces/ledger/LedgerTypeDef.h"
 #include "bcos-framework/interfaces/protocol/Protocol.h"
 #include "bcos-ledger/src/libledger/utilities/Common.h"
+#include "bcos-ledger/src/libledger/utilities/LedgerCache.h"
+#include "bcos-ledger/src/libledger/utilities/MerkleTreeCache.h"
 #include "bcos-tool/ConsensusNode.h"
 #include "common/FakeBlock.h"
 #include "interfaces/crypto/KeyPairInterface.h"
@@ -37,6 +39,7 @@
 #include <bcos-framework/interfaces/executor/PrecompiledTypeDef.h>
 #include <bcos-framework/interfaces/storage/StorageInterface.h>
 #include <bcos-framework/interfaces/storage/Table.h>
+#include <bcos-protocol/ParallelMerkleProof.h>
 #include <bcos-table/src/StateStorage.h>
 #include <bcos-utilities/DataConvertUtility.h>
 #include <bcos-utilities/testutils/TestPromptFixture.h>
@@ -863,6 +866,191 @@ BOOST_AUTO_TEST_CASE(getTransactionReceiptByHash)
     BOOST_CHECK_EQUAL(f4.get(), true);
 }
 
+BOOST_AUTO_TEST_CASE(merkleTreeProof)
+{
+    initFixture();
+    auto cryptoSuite = m_blockFactory->cryptoSuite();
+    for (size_t leavesSize : {1, 2, 16, 17, 300})
+    {
+        std::vector<HashType> leaves;
+        std::vector<bytes> leavesBytes;
+        for (size_t i = 0; i < leavesSize; ++i)
+        {
+            leaves.emplace_back(cryptoSuite->hash(boost::lexical_cast<std::string>(i)));
+            leavesBytes.emplace_back(leaves.back().asBytes());
+        }
+        MerkleTree tree(cryptoSuite, leaves);
+        BOOST_CHECK(tree.match(leaves));
+        BOOST_CHECK(tree.root() == calculateMerkleProofRoot(cryptoSuite, leavesBytes));
+
+        for (auto index : {(size_t)0, leavesSize / 2, leavesSize - 1})
+        {
+            auto proof = tree.proof(leaves[index]);
+            BOOST_REQUIRE(proof);
+            BOOST_CHECK(MerkleTree::verify(cryptoSuite, *proof, leaves[index], tree.root()));
+        }
+    }
+    MerkleTree tree(cryptoSuite, {cryptoSuite->hash(std::string("leaf"))});
+    BOOST_CHECK(!tree.proof(cryptoSuite->hash(std::string("other"))));
+
+    MerkleTreeCache cache(2);
+    std::vector<HashType> txs = {cryptoSuite->hash(std::string("tx"))};
+    auto txsTree = std::make_shared<MerkleTree>(cryptoSuite, txs);
+    cache.insert(1, txsTree);
+    BOOST_CHECK_EQUAL(cache.txsTree(1, txs), txsTree);
+    BOOST_CHECK(!cache.receiptsTree(1, txs));
+    // the block is rewritten with other txs
+    BOOST_CHECK(!cache.txsTree(1, {cryptoSuite->hash(std::string("other"))}));
+    cache.insert(2, txsTree, txsTree);
+    cache.insert(3, txsTree);
+    BOOST_CHECK(!cache.txsTree(1, txs));
+    BOOST_CHECK_EQUAL(cache.receiptsTree(2, txs), txsTree);
+}
+
+BOOST_AUTO_TEST_CASE(ledgerCache)
+{
+    initFixture();
+    initChain(5);
+    auto checkBlock = [this](BlockNumber _number) {
+        std::promise<Block::Ptr> promise;
+        m_ledger->asyncGetBlockDataByNumber(
+            _number, FULL_BLOCK, [&promise](Error::Ptr _error, Block::Ptr _block) {
+                BOOST_CHECK_EQUAL(_error, nullptr);
+                promise.set_value(std::move(_block));
+            });
+        auto block = promise.get_future().get();
+        auto const& expected = m_fakeBlocks->at(_number - 1);
+        BOOST_REQUIRE(block);
+        BOOST_CHECK(block->blockHeader()->hash() == expected->blockHeader()->hash());
+        BOOST_REQUIRE_EQUAL(block->transactionsSize(), expected->transactionsSize());
+        BOOST_REQUIRE_EQUAL(block->receiptsSize(), expected->receiptsSize());
+        for (size_t i = 0; i < block->transactionsSize(); ++i)
+        {
+            BOOST_CHECK(block->transaction(i)->hash() == expected->transaction(i)->hash());
+            BOOST_CHECK(block->receipt(i)->hash() == expected->receipt(i)->hash());
+        }
+    };
+    // from the cache, and from the storage after the block is removed from the cache
+    checkBlock(3);
+    m_ledger->removeBlockCache(3);
+    checkBlock(3);
+
+    LedgerCache cache(2, 100000);
+    std::vector<HashType> txHashes;
+    std::vector<Transaction::ConstPtr> txs;
+    std::vector<TransactionReceipt::ConstPtr> receipts;
+    auto const& block = m_fakeBlocks->at(4);
+    for (size_t i = 0; i < block->transactionsSize(); ++i)
+    {
+        txHashes.emplace_back(block->transaction(i)->hash());
+        txs.emplace_back(block->transaction(i));
+        receipts.emplace_back(block->receipt(i));
+    }
+    BOOST_REQUIRE(!txHashes.empty());
+    auto headerFactory = m_blockFactory->blockHeaderFactory();
+    cache.insert(headerFactory->createBlockHeader(1), txHashes, txs, {});
+    // the cached objects are handed out without decoding them again
+    BOOST_CHECK_EQUAL(cache.transaction(txHashes[0]), txs[0]);
+    BOOST_CHECK(!cache.receipt(txHashes[0]));
+    auto cachedBlock = m_blockFactory->createBlock();
+    BOOST_CHECK(cache.fillBlock(1, HEADER | TRANSACTIONS, *cachedBlock));
+    BOOST_CHECK_EQUAL(cachedBlock->blockHeaderConst()->number(), 1);
+    BOOST_REQUIRE_EQUAL(cachedBlock->transactionsSize(), txs.size());
+    BOOST_CHECK(cachedBlock->transaction(0)->hash() == txHashes[0]);
+    // modifying the filled block doesn't modify the cached header
+    cachedBlock->blockHeader()->setNumber(100);
+    auto otherBlock = m_blockFactory->createBlock();
+    BOOST_CHECK(cache.fillBlock(1, HEADER, *otherBlock));
+    BOOST_CHECK_EQUAL(otherBlock->blockHeaderConst()->number(), 1);
+    BOOST_CHECK(!cache.fillBlock(1, RECEIPTS, *m_blockFactory->createBlock()));
+    // the block is rewritten with the receipts
+    cache.insert(headerFactory->createBlockHeader(1), txHashes, txs, receipts);
+    BOOST_CHECK_EQUAL(cache.receipt(txHashes[0]), receipts[0]);
+    BOOST_CHECK(cache.fillBlock(1, FULL_BLOCK, *m_blockFactory->createBlock()));
+    // the oldest block is evicted
+    cache.insert(headerFactory->createBlockHeader(2), {}, {}, {});
+    cache.insert(headerFactory->createBlockHeader(3), {}, {}, {});
+    BOOST_CHECK(!cache.fillBlock(1, HEADER, *m_blockFactory->createBlock()));
+    BOOST_CHECK(!cache.transaction(txHashes[0]));
+    BOOST_CHECK(cache.fillBlock(3, FULL_BLOCK, *m_blockFactory->createBlock()));
+    cache.remove(3);
+    BOOST_CHECK(!cache.fillBlock(3, HEADER, *m_blockFactory->createBlock()));
+    cache.report();
+}
+
+BOOST_AUTO_TEST_CASE(getBlockDataByRange)
+{
+    initFixture();
+    // cross the batch boundary of the range read
+    initChain(40);
+    // mix the cached and the uncached blocks
+    for (BlockNumber number = 2; number <= 40; number += 3)
+    {
+        m_ledger->removeBlockCache(number);
+    }
+
+    std::vector<Block::Ptr> blocks;
+    std::promise<bool> finishedPromise;
+    m_ledger->asyncGetBlockDataByRange(1, 40, FULL_BLOCK,
+        [&](Error::Ptr _error, BlocksPtr _blocks, bool _finished) {
+            BOOST_CHECK_EQUAL(_error, nullptr);
+            BOOST_REQUIRE(_blocks);
+            blocks.insert(blocks.end(), _blocks->begin(), _blocks->end());
+            if (_finished)
+            {
+                finishedPromise.set_value(true);
+            }
+        });
+    BOOST_CHECK(finishedPromise.get_future().get());
+    BOOST_REQUIRE_EQUAL(blocks.size(), 40);
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+        auto const& block = blocks[i];
+        auto const& expected = m_fakeBlocks->at(i);
+        BOOST_CHECK_EQUAL(block->blockHeader()->number(), (BlockNumber)(i + 1));
+        BOOST_CHECK(block->blockHeader()->hash() == expected->blockHeader()->hash());
+        BOOST_REQUIRE_EQUAL(block->transactionsSize(), expected->transactionsSize());
+        BOOST_REQUIRE_EQUAL(block->receiptsSize(), expected->receiptsSize());
+        for (size_t j = 0; j < block->transactionsSize(); ++j)
+        {
+            BOOST_CHECK(block->transaction(j)->hash() == expected->transaction(j)->hash());
+            BOOST_CHECK(block->receipt(j)->hash() == expected->receipt(j)->hash());
+        }
+    }
+
+    // only the headers
+    std::promise<BlocksPtr> headerPromise;
+    m_ledger->asyncGetBlockDataByRange(
+        5, 8, HEADER, [&](Error::Ptr _error, BlocksPtr _blocks, bool _finished) {
+            BOOST_CHECK_EQUAL(_error, nullptr);
+            BOOST_CHECK(_finished);
+            headerPromise.set_value(_blocks);
+        });
+    auto headers = headerPromise.get_future().get();
+    BOOST_REQUIRE_EQUAL(headers->size(), 4);
+    BOOST_CHECK_EQUAL(headers->at(0)->blockHeader()->number(), 5);
+    BOOST_CHECK_EQUAL(headers->at(0)->transactionsSize(), 0);
+
+    // empty range
+    std::promise<bool> emptyPromise;
+    m_ledger->asyncGetBlockDataByRange(
+        10, 9, FULL_BLOCK, [&](Error::Ptr _error, BlocksPtr _blocks, bool _finished) {
+            BOOST_CHECK_EQUAL(_error, nullptr);
+            BOOST_CHECK(_blocks->empty());
+            emptyPromise.set_value(_finished);
+        });
+    BOOST_CHECK(emptyPromise.get_future().get());
+
+    // invalid range
+    std::promise<bool> errorPromise;
+    m_ledger->asyncGetBlockDataByRange(
+        -1, 9, FULL_BLOCK, [&](Error::Ptr _error, BlocksPtr, bool _finished) {
+            BOOST_CHECK(_error != nullptr);
+            errorPromise.set_value(_finished);
+        });
+    BOOST_CHECK(errorPromise.get_future().get());
+}
+
 BOOST_AUTO_TEST_CASE(getNonceList)
 {
     initFixture();
@@ -0,0 +1,179 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the merkle tree on the contiguous hash array
+ * @file: MerkleTree.cpp
+ * @date 2022-07-22
+ */
+#include "MerkleTree.h"
+#include <bcos-utilities/DataConvertUtility.h>
+#include <tbb/parallel_for.h>
+
+using namespace bcos;
+using namespace bcos::crypto;
+using namespace bcos::protocol;
+
+MerkleTree::MerkleTree(
+    CryptoSuite::Ptr const& _cryptoSuite, std::vector<HashType> _leaves, size_t _width)
+  : m_width(std::max(_width, (size_t)2)), m_nodes(std::move(_leaves))
+{
+    m_levelOffsets.push_back(0);
+    m_levelOffsets.push_back(m_nodes.size());
+    if (m_nodes.empty())
+    {
+        m_root = _cryptoSuite->hash(bytes());
+        return;
+    }
+    m_leafIndex.reserve(m_nodes.size());
+    for (size_t i = 0; i < m_nodes.size(); ++i)
+    {
+        m_leafIndex.emplace(m_nodes[i], i);
+    }
+    // the upper levels have 1 / (width - 1) of the leaves in total
+    m_nodes.reserve(m_nodes.size() + m_nodes.size() / (m_width - 1) + 1);
+    while (m_levelOffsets.back() - m_levelOffsets[m_levelOffsets.size() - 2] > 1)
+    {
+        auto begin = m_levelOffsets[m_levelOffsets.size() - 2];
+        auto end = m_levelOffsets.back();
+        auto parentsSize = (end - begin + m_width - 1) / m_width;
+        m_nodes.resize(end + parentsSize);
+        hashLevel(_cryptoSuite, m_width, m_nodes.data() + begin, end - begin, m_nodes.data() + end);
+        m_levelOffsets.push_back(end + parentsSize);
+    }
+    m_root = _cryptoSuite->hash(m_nodes.back().asBytes());
+}
+
+bool MerkleTree::match(std::vector<HashType> const& _leaves) const
+{
+    if (_leaves.size() != leavesSize())
+    {
+        return false;
+    }
+    return std::equal(_leaves.begin(), _leaves.end(), m_nodes.begin());
+}
+
+bcos::ledger::MerkleProofPtr MerkleTree::proof(HashType const& _leaf) const
+{
+    auto it = m_leafIndex.find(_leaf);
+    if (it == m_leafIndex.end())
+    {
+        return nullptr;
+    }
+    return proof(it->second);
+}
+
+bcos::ledger::MerkleProofPtr MerkleTree::proof(size_t _index) const
+{
+    if (_index >= leavesSize())
+    {
+        return nullptr;
+    }
+    auto proof = std::make_shared<bcos::ledger::MerkleProof>();
+    proof->reserve(m_levelOffsets.size() - 1);
+    for (size_t level = 0; level + 1 < m_levelOffsets.size(); ++level)
+    {
+        auto begin = m_levelOffsets[level];
+        auto end = m_levelOffsets[level + 1];
+        std::vector<std::string> leftPath;
+        std::vector<std::string> rightPath;
+        if (end - begin > 1)
+        {
+            auto groupBegin = begin + (_index / m_width) * m_width;
+            auto groupEnd = std::min(groupBegin + m_width, end);
+            for (auto i = groupBegin; i < begin + _index; ++i)
+            {
+                leftPath.emplace_back(m_nodes[i].hex());
+            }
+            for (auto i = begin + _index + 1; i < groupEnd; ++i)
+            {
+                rightPath.emplace_back(m_nodes[i].hex());
+            }
+        }
+        proof->emplace_back(std::move(leftPath), std::move(rightPath));
+        _index /= m_width;
+    }
+    return proof;
+}
+
+bool MerkleTree::verify(CryptoSuite::Ptr const& _cryptoSuite,
+    bcos::ledger::MerkleProof const& _proof, HashType const& _leaf, HashType const& _root)
+{
+    if (_proof.empty())
+    {
+        return false;
+    }
+    auto node = _leaf;
+    bytes buffer;
+    for (auto const& [leftPath, rightPath] : _proof)
+    {
+        buffer.clear();
+        for (auto const& sibling : leftPath)
+        {
+            auto siblingBytes = fromHex(sibling);
+            buffer.insert(buffer.end(), siblingBytes.begin(), siblingBytes.end());
+        }
+        buffer.insert(buffer.end(), node.begin(), node.end());
+        for (auto const& sibling : rightPath)
+        {
+            auto siblingBytes = fromHex(sibling);
+            buffer.insert(buffer.end(), siblingBytes.begin(), siblingBytes.end());
+        }
+        node = _cryptoSuite->hash(buffer);
+    }
+    return node == _root;
+}
+
+HashType MerkleTree::calculateRoot(
+    CryptoSuite::Ptr const& _cryptoSuite, std::vector<HashType> _leaves, size_t _width)
+{
+    if (_leaves.empty())
+    {
+        return _cryptoSuite->hash(bytes());
+    }
+    _width = std::max(_width, (size_t)2);
+    // the levels are hashed between two buffers alternately
+    std::vector<HashType> parents((_leaves.size() + _width - 1) / _width);
+    auto size = _leaves.size();
+    while (size > 1)
+    {
+        auto parentsSize = (size + _width - 1) / _width;
+        hashLevel(_cryptoSuite, _width, _leaves.data(), size, parents.data());
+        std::swap(_leaves, parents);
+        size = parentsSize;
+    }
+    return _cryptoSuite->hash(_leaves[0].asBytes());
+}
+
+void MerkleTree::hashLevel(CryptoSuite::Ptr const& _cryptoSuite, size_t _width,
+    HashType const* _children, size_t _childrenSize, HashType* _parents)
+{
+    auto parentsSize = (_childrenSize + _width - 1) / _width;
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, parentsSize), [&](const tbb::blocked_range<size_t>& _range) {
+            // the buffer is reused by all the parents of the range
+            bytes buffer;
+            buffer.reserve(_width * HashType::size);
+            for (size_t i = _range.begin(); i < _range.end(); ++i)
+            {
+                buffer.clear();
+                auto childEnd = std::min((i + 1) * _width, _childrenSize);
+                for (auto child = i * _width; child < childEnd; ++child)
+                {
+                    buffer.insert(buffer.end(), _children[child].begin(), _children[child].end());
+                }
+                _parents[i] = _cryptoSuite->hash(buffer);
+            }
+        });
+}
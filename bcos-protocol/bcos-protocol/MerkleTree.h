@@ -0,0 +1,81 @@
+/**
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the merkle tree on the contiguous hash array
+ * @file: MerkleTree.h
+ * @date 2022-07-22
+ */
+#pragma once
+
+#include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
+#include <bcos-framework/interfaces/ledger/LedgerTypeDef.h>
+#include <unordered_map>
+#include <vector>
+
+namespace bcos
+{
+namespace protocol
+{
+/**
+ * every width nodes are hashed into their parent, and the root is the hash of the top node.
+ * the nodes of all levels are stored in one contiguous array from the leaves to the top, every
+ * level is hashed in parallel, and a proof is collected by walking up the levels
+ */
+class MerkleTree
+{
+public:
+    using Ptr = std::shared_ptr<const MerkleTree>;
+    static constexpr size_t DEFAULT_WIDTH = 16;
+
+    MerkleTree(bcos::crypto::CryptoSuite::Ptr const& _cryptoSuite,
+        std::vector<bcos::crypto::HashType> _leaves, size_t _width = DEFAULT_WIDTH);
+
+    bcos::crypto::HashType const& root() const { return m_root; }
+    size_t width() const { return m_width; }
+    size_t leavesSize() const { return m_levelOffsets[1]; }
+    bcos::crypto::HashType const& leaf(size_t _index) const { return m_nodes[_index]; }
+    // the leaves are the same as the given hashes in order
+    bool match(std::vector<bcos::crypto::HashType> const& _leaves) const;
+
+    // the left and right siblings of every level from the leaf to the top, the top node is the
+    // only child of the root; nullptr if the hash is not a leaf of the tree
+    bcos::ledger::MerkleProofPtr proof(bcos::crypto::HashType const& _leaf) const;
+    bcos::ledger::MerkleProofPtr proof(size_t _index) const;
+
+    // hash the leaf up to the root with the siblings in the proof
+    static bool verify(bcos::crypto::CryptoSuite::Ptr const& _cryptoSuite,
+        bcos::ledger::MerkleProof const& _proof, bcos::crypto::HashType const& _leaf,
+        bcos::crypto::HashType const& _root);
+
+    // only calculate the root, the levels below are not kept
+    static bcos::crypto::HashType calculateRoot(bcos::crypto::CryptoSuite::Ptr const& _cryptoSuite,
+        std::vector<bcos::crypto::HashType> _leaves, size_t _width = DEFAULT_WIDTH);
+
+    // hash every width children into the parents, the parents must be preallocated
+    static void hashLevel(bcos::crypto::CryptoSuite::Ptr const& _cryptoSuite, size_t _width,
+        bcos::crypto::HashType const* _children, size_t _childrenSize,
+        bcos::crypto::HashType* _parents);
+
+private:
+    size_t m_width;
+    std::vector<bcos::crypto::HashType> m_nodes;
+    // the offset of every level in m_nodes, the last one is the size of m_nodes
+    std::vector<size_t> m_levelOffsets;
+    std::unordered_map<bcos::crypto::HashType, size_t, std::hash<bcos::crypto::HashType>>
+        m_leafIndex;
+    bcos::crypto::HashType m_root;
+};
+}  // namespace protocol
+}  // namespace bcos
@@ -21,13 +21,12 @@
  */
 
 #include "ParallelMerkleProof.h"
+#include "MerkleTree.h"
 #include <tbb/parallel_for.h>
-#include <mutex>
 
 using namespace bcos;
 using namespace bcos::crypto;
-
-const uint32_t MAX_CHILD_COUNT = 16;
+using namespace bcos::protocol;
 
 HashType bcos::protocol::calculateMerkleProofRoot(
     CryptoSuite::Ptr _cryptoSuite, const std::vector<bcos::bytes>& _bytesCaches)
@@ -36,84 +35,27 @@ HashType bcos::protocol::calculateMerkleProofRoot(
     {
         return _cryptoSuite->hash(bytes());
     }
-    std::vector<bcos::bytes> bytesCachesTemp;
-    bytesCachesTemp.insert(bytesCachesTemp.end(),
-        std::make_move_iterator(const_cast<std::vector<bcos::bytes>&>(_bytesCaches).begin()),
-        std::make_move_iterator(const_cast<std::vector<bcos::bytes>&>(_bytesCaches).end()));
-
-    while (bytesCachesTemp.size() > 1)
+    if (_bytesCaches.size() == 1)
     {
-        std::vector<bcos::bytes> higherLevelList;
-        int size = (bytesCachesTemp.size() + MAX_CHILD_COUNT - 1) / MAX_CHILD_COUNT;
-        higherLevelList.resize(size);
-        tbb::parallel_for(
-            tbb::blocked_range<size_t>(0, size), [&](const tbb::blocked_range<size_t>& _r) {
-                for (uint32_t i = _r.begin(); i < _r.end(); ++i)
-                {
-                    bytes byteValue;
-                    for (uint32_t j = 0; j < MAX_CHILD_COUNT; j++)
-                    {
-                        uint32_t index = i * MAX_CHILD_COUNT + j;
-                        if (index < bytesCachesTemp.size())
-                        {
-                            byteValue.insert(byteValue.end(), bytesCachesTemp[index].begin(),
-                                bytesCachesTemp[index].end());
-                        }
-                    }
-                    higherLevelList[i] = _cryptoSuite->hash(byteValue).asBytes();
-                }
-            });
-        bytesCachesTemp = std::move(higherLevelList);
+        return _cryptoSuite->hash(_bytesCaches[0]);
     }
-    return _cryptoSuite->hash(bytesCachesTemp[0]);
-}
-
-void bcos::protocol::calculateMerkleProof(bcos::crypto::CryptoSuite::Ptr _cryptoSuite,
-    const std::vector<bcos::bytes>& _bytesCaches,
-    std::shared_ptr<std::map<std::string, std::vector<std::string>>> _parent2ChildList)
-{
-    if (_bytesCaches.empty())
-    {
-        return;
-    }
-    std::vector<bcos::bytes> bytesCachesTemp;
-    bytesCachesTemp.insert(bytesCachesTemp.end(),
-        std::make_move_iterator(const_cast<std::vector<bcos::bytes>&>(_bytesCaches).begin()),
-        std::make_move_iterator(const_cast<std::vector<bcos::bytes>&>(_bytesCaches).end()));
-    std::mutex mapMutex;
-    while (bytesCachesTemp.size() > 1)
-    {
-        std::vector<bcos::bytes> higherLevelList;
-        int size = (bytesCachesTemp.size() + MAX_CHILD_COUNT - 1) / MAX_CHILD_COUNT;
-        higherLevelList.resize(size);
-        tbb::parallel_for(
-            tbb::blocked_range<size_t>(0, size), [&](const tbb::blocked_range<size_t>& _r) {
-                for (uint32_t i = _r.begin(); i < _r.end(); ++i)
+    // the leaves are variable-length, hash them into the first level of the fixed-size nodes
+    auto width = MerkleTree::DEFAULT_WIDTH;
+    std::vector<HashType> parents((_bytesCaches.size() + width - 1) / width);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, parents.size()),
+        [&](const tbb::blocked_range<size_t>& _range) {
+            bytes buffer;
+            for (size_t i = _range.begin(); i < _range.end(); ++i)
+            {
+                buffer.clear();
+                auto childEnd = std::min((i + 1) * width, _bytesCaches.size());
+                for (auto child = i * width; child < childEnd; ++child)
                 {
-                    bytes byteValue;
-                    std::vector<bcos::bytes> childList;
-                    for (uint32_t j = 0; j < MAX_CHILD_COUNT; j++)
-                    {
-                        uint32_t index = i * MAX_CHILD_COUNT + j;
-                        if (index < bytesCachesTemp.size())
-                        {
-                            byteValue.insert(byteValue.end(), bytesCachesTemp[index].begin(),
-                                bytesCachesTemp[index].end());
-                            childList.push_back(bytesCachesTemp[index]);
-                        }
-                    }
-                    higherLevelList[i] = _cryptoSuite->hash(byteValue).asBytes();
-                    std::lock_guard<std::mutex> l(mapMutex);
-                    std::string parentNode = *toHexString(higherLevelList[i]);
-                    for (const auto& child : childList)
-                    {
-                        (*_parent2ChildList)[parentNode].emplace_back(*toHexString(child));
-                    }
+                    buffer.insert(
+                        buffer.end(), _bytesCaches[child].begin(), _bytesCaches[child].end());
                 }
-            });
-        bytesCachesTemp = std::move(higherLevelList);
-    }
-
-    (*_parent2ChildList)[*toHexString(_cryptoSuite->hash(bytesCachesTemp[0]).asBytes())].push_back(
-        *toHexString(bytesCachesTemp[0]));
+                parents[i] = _cryptoSuite->hash(buffer);
+            }
+        });
+    return MerkleTree::calculateRoot(_cryptoSuite, std::move(parents), width);
 }
@@ -31,8 +31,5 @@ namespace protocol
 {
 bcos::crypto::HashType calculateMerkleProofRoot(
     bcos::crypto::CryptoSuite::Ptr _cryptoSuite, const std::vector<bcos::bytes>& _bytesCaches);
-void calculateMerkleProof(bcos::crypto::CryptoSuite::Ptr _cryptoSuite,
-    const std::vector<bcos::bytes>& _bytesCaches,
-    std::shared_ptr<std::map<std::string, std::vector<std::string>>> _parent2ChildList);
 }  // namespace protocol
 }  // namespace bcos
@@ -0,0 +1,175 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief test for MerkleTree
+ * @file MerkleTreeTest.cpp
+ * @date: 2022-07-22
+ */
+#include "bcos-protocol/MerkleTree.h"
+#include "bcos-protocol/ParallelMerkleProof.h"
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/hash/SM3.h>
+#include <bcos-utilities/DataConvertUtility.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+#include <map>
+using namespace bcos;
+using namespace bcos::protocol;
+using namespace bcos::crypto;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(MerkleTreeTest, TestPromptFixture)
+
+// the nodes of every level from the leaves to the top, hashed one by one on the bytes
+std::vector<std::vector<bytes>> legacyLevels(
+    CryptoSuite::Ptr const& _cryptoSuite, std::vector<bytes> _leaves, size_t _width)
+{
+    std::vector<std::vector<bytes>> levels{std::move(_leaves)};
+    while (levels.back().size() > 1)
+    {
+        auto const& children = levels.back();
+        std::vector<bytes> parents;
+        for (size_t i = 0; i < children.size(); i += _width)
+        {
+            bytes data;
+            for (size_t j = i; j < std::min(i + _width, children.size()); ++j)
+            {
+                data.insert(data.end(), children[j].begin(), children[j].end());
+            }
+            parents.emplace_back(_cryptoSuite->hash(data).asBytes());
+        }
+        levels.emplace_back(std::move(parents));
+    }
+    return levels;
+}
+
+// the proof collected from the parent to children map, the same as the ledger used to do
+bcos::ledger::MerkleProof legacyProof(CryptoSuite::Ptr const& _cryptoSuite,
+    std::vector<std::vector<bytes>> const& _levels, size_t _width, std::string _leaf)
+{
+    std::map<std::string, std::vector<std::string>> parent2Children;
+    std::map<std::string, std::string> child2Parent;
+    for (size_t level = 0; level + 1 < _levels.size(); ++level)
+    {
+        for (size_t i = 0; i < _levels[level].size(); ++i)
+        {
+            auto parent = *toHexString(_levels[level + 1][i / _width]);
+            parent2Children[parent].emplace_back(*toHexString(_levels[level][i]));
+        }
+    }
+    auto root = *toHexString(_cryptoSuite->hash(_levels.back()[0]).asBytes());
+    parent2Children[root].emplace_back(*toHexString(_levels.back()[0]));
+    for (auto const& [parent, children] : parent2Children)
+    {
+        for (auto const& child : children)
+        {
+            child2Parent[child] = parent;
+        }
+    }
+    bcos::ledger::MerkleProof proof;
+    for (auto it = child2Parent.find(_leaf); it != child2Parent.end();
+         it = child2Parent.find(_leaf))
+    {
+        auto const& children = parent2Children[it->second];
+        auto index = std::find(children.begin(), children.end(), _leaf);
+        proof.emplace_back(std::vector<std::string>(children.begin(), index),
+            std::vector<std::string>(std::next(index), children.end()));
+        _leaf = it->second;
+    }
+    return proof;
+}
+
+void testMerkleTree(CryptoSuite::Ptr const& _cryptoSuite, size_t _width)
+{
+    for (size_t leavesSize : {1, 2, 15, 16, 17, 256, 1000})
+    {
+        std::vector<HashType> leaves;
+        std::vector<bytes> leavesBytes;
+        for (size_t i = 0; i < leavesSize; ++i)
+        {
+            leaves.emplace_back(_cryptoSuite->hash(std::to_string(i)));
+            leavesBytes.emplace_back(leaves.back().asBytes());
+        }
+        MerkleTree tree(_cryptoSuite, leaves, _width);
+        BOOST_CHECK(tree.match(leaves));
+        BOOST_CHECK_EQUAL(tree.leavesSize(), leavesSize);
+
+        auto levels = legacyLevels(_cryptoSuite, leavesBytes, _width);
+        auto root = _cryptoSuite->hash(levels.back()[0]);
+        BOOST_CHECK(tree.root() == root);
+        BOOST_CHECK(MerkleTree::calculateRoot(_cryptoSuite, leaves, _width) == root);
+        if (_width == MerkleTree::DEFAULT_WIDTH)
+        {
+            BOOST_CHECK(calculateMerkleProofRoot(_cryptoSuite, leavesBytes) == root);
+        }
+
+        for (auto index : {(size_t)0, leavesSize / 2, leavesSize - 1})
+        {
+            auto proof = tree.proof(leaves[index]);
+            BOOST_REQUIRE(proof);
+            BOOST_CHECK(*proof == legacyProof(_cryptoSuite, levels, _width, leaves[index].hex()));
+            BOOST_CHECK(MerkleTree::verify(_cryptoSuite, *proof, leaves[index], root));
+            BOOST_CHECK(!MerkleTree::verify(_cryptoSuite, *proof, _cryptoSuite->hash(std::string("x")), root));
+        }
+    }
+    MerkleTree tree(_cryptoSuite, {_cryptoSuite->hash(std::string("leaf"))}, _width);
+    BOOST_CHECK(!tree.proof(_cryptoSuite->hash(std::string("other"))));
+    BOOST_CHECK(!tree.proof((size_t)1));
+}
+
+BOOST_AUTO_TEST_CASE(testKeccak256MerkleTree)
+{
+    auto cryptoSuite =
+        std::make_shared<CryptoSuite>(std::make_shared<Keccak256>(), nullptr, nullptr);
+    testMerkleTree(cryptoSuite, MerkleTree::DEFAULT_WIDTH);
+    testMerkleTree(cryptoSuite, 2);
+    testMerkleTree(cryptoSuite, 5);
+}
+
+BOOST_AUTO_TEST_CASE(testSM3MerkleTree)
+{
+    auto cryptoSuite = std::make_shared<CryptoSuite>(std::make_shared<SM3>(), nullptr, nullptr);
+    testMerkleTree(cryptoSuite, MerkleTree::DEFAULT_WIDTH);
+}
+
+BOOST_AUTO_TEST_CASE(testVariableLengthLeaves)
+{
+    auto cryptoSuite =
+        std::make_shared<CryptoSuite>(std::make_shared<Keccak256>(), nullptr, nullptr);
+    // the leaves of the block roots are the encoded index and hash
+    for (size_t leavesSize : {0, 1, 16, 17, 300})
+    {
+        std::vector<bytes> leaves;
+        for (size_t i = 0; i < leavesSize; ++i)
+        {
+            leaves.emplace_back(asBytes(std::to_string(i) + "leaf"));
+        }
+        auto expected = cryptoSuite->hash(bytes());
+        if (leavesSize > 0)
+        {
+            auto levels = legacyLevels(cryptoSuite, leaves, MerkleTree::DEFAULT_WIDTH);
+            expected = cryptoSuite->hash(levels.back()[0]);
+        }
+        BOOST_CHECK(calculateMerkleProofRoot(cryptoSuite, leaves) == expected);
+        // the leaves are not moved any more
+        BOOST_CHECK_EQUAL(leaves.size(), leavesSize);
+    }
+}
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
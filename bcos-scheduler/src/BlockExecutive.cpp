@@ -7,6 +7,7 @@
 #include "bcos-framework/interfaces/executor/ExecutionMessage.h"
 #include "bcos-framework/interfaces/executor/ParallelTransactionExecutorInterface.h"
 #include "bcos-framework/interfaces/executor/PrecompiledTypeDef.h"
+#include "bcos-framework/interfaces/protocol/Protocol.h"
 #include "bcos-framework/interfaces/protocol/Transaction.h"
 #include "bcos-table/src/StateStorage.h"
 #include <bcos-utilities/Error.h>
@@ -455,6 +456,7 @@ void BlockExecutive::asyncCommit(std::function<void(Error::UniquePtr)> callback)
         [this, stateStorage, callback = std::move(callback)](Error::Ptr&& error) mutable {
             if (error)
             {
+                m_scheduler->m_ledger->removeBlockCache(number());
                 SCHEDULER_LOG(ERROR) << "Prewrite block error!" << error->errorMessage();
                 callback(BCOS_ERROR_WITH_PREV_UNIQUE_PTR(SchedulerError::PrewriteBlockError,
                     "Prewrite block error： " + error->errorMessage(), *error));
@@ -469,6 +471,7 @@ void BlockExecutive::asyncCommit(std::function<void(Error::UniquePtr)> callback)
                     std::string errorMessage =
                         "Prepare with errors! " + boost::lexical_cast<std::string>(status.failed);
                     SCHEDULER_LOG(WARNING) << errorMessage;
+                    m_scheduler->m_ledger->removeBlockCache(number());
                     batchBlockRollback([this, callback, errorMessage](Error::UniquePtr&& error) {
                         if (error)
                         {
@@ -496,6 +499,8 @@ void BlockExecutive::asyncCommit(std::function<void(Error::UniquePtr)> callback)
                     {
                         SCHEDULER_LOG(ERROR) << "Commit block to storage failed!"
                                              << LOG_KV("number", number()) << error->errorMessage();
+                        // the cached block is not committed
+                        m_scheduler->m_ledger->removeBlockCache(number());
 
                         // FATAL ERROR, NEED MANUAL FIX!
 
@@ -930,6 +935,9 @@ void BlockExecutive::onDmcExecuteFinish(
                       << "\t " << LOG_BADGE("DMCRecorder")
                       << " DMCExecute for transaction finished " << LOG_KV("blockNumber", number())
                       << LOG_KV("checksum", dmcChecksum);
+        DMC_LOG(INFO) << METRIC << LOG_BADGE("DeadLock") << LOG_KV("blockNumber", number())
+                      << LOG_KV("deadLocks", m_keyLocks->deadLocksSize())
+                      << LOG_KV("reverts", m_deadLockReverts);
 
         // All Transaction finished, get hash
         batchGetHashes([this, callback = std::move(callback)](
@@ -1388,19 +1396,25 @@ void BlockExecutive::serialPrepareExecutor()
 
     if (needDetectDeadlock && !allFinished)
     {
-        bool needRevert = false;
-        // detect deadlock and revert the first tx TODO: revert many tx in one DMC round
+        // the dead locks are detected when the key locks are acquired, revert the victims of all
+        // the dead locks in one DMC round, the blocks before V3_0_VERSION revert the first tx
+        // found to keep the same results
+        bool revertAllVictims = m_block->blockHeaderConst()->version() >=
+                                (uint32_t)bcos::protocol::Version::V3_0_VERSION;
+        size_t reverted = 0;
         for (auto it = m_dmcExecutors.begin(); it != m_dmcExecutors.end(); it++)
         {
             auto& address = it->first;
             DMC_LOG(TRACE) << " --detect--revert-- " << address << " | "
                            << m_block->blockHeaderConst()->number() << " -----------------";
-            if (m_dmcExecutors[address]->detectLockAndRevert())
+            reverted += m_dmcExecutors[address]->detectLockAndRevert(revertAllVictims);
+            if (!revertAllVictims && reverted > 0)
             {
-                needRevert = true;
                 break;  // Just revert the first found tx
             }
         }
+        m_deadLockReverts += reverted;
+        bool needRevert = (reverted > 0);
 
         if (!needRevert)
         {
@@ -154,6 +154,8 @@ private:
     size_t m_gasUsed = 0;
 
     GraphKeyLocks::Ptr m_keyLocks = std::make_shared<GraphKeyLocks>();
+    // the txs reverted to break the dead locks
+    size_t m_deadLockReverts = 0;
 
     std::chrono::system_clock::time_point m_currentTimePoint;
 
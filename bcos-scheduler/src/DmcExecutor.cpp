@@ -92,12 +92,15 @@ bool DmcExecutor::unlockPrepare()
                                                            // need to detect deadlock
 }
 
-bool DmcExecutor::detectLockAndRevert()
+size_t DmcExecutor::detectLockAndRevert(bool revertAllVictims)
 {
-    bool found = false;
-    m_executivePool.forEach(
-        MessageHint::LOCKED, [this, &found](int64_t contextID, ExecutiveState::Ptr executiveState) {
-            if (m_keyLocks->detectDeadLock(contextID))
+    size_t reverted = 0;
+    m_executivePool.forEach(MessageHint::LOCKED,
+        [this, revertAllVictims, &reverted](int64_t contextID, ExecutiveState::Ptr executiveState) {
+            // revert the victims of the dead locks, one of every cycle, the legacy blocks revert
+            // the first locked context reaching a dead lock
+            if (revertAllVictims ? m_keyLocks->isDeadLockVictim(contextID) :
+                                   m_keyLocks->detectDeadLock(contextID))
             {
                 auto& message = executiveState->message;
 
@@ -111,17 +114,14 @@ bool DmcExecutor::detectLockAndRevert()
                 m_executivePool.markAs(contextID, MessageHint::NEED_SEND);
                 DMC_LOG(TRACE) << " 3.AfterPrepare: \t [..] " << executiveState->toString()
                                << " REVERT";
-                found = true;
-                return false;  // break at once found a tx can be revert
-                // just detect one TODO: detect and unlock more deadlock
-            }
-            else
-            {
-                return true;  // continue forEach
+                ++reverted;
+                // the legacy blocks break at once found a tx can be revert
+                return revertAllVictims;
             }
+            return true;  // continue forEach
         });
 
-    return found;  // no detected
+    return reverted;
 }
 
 void DmcExecutor::submit(protocol::ExecutionMessage::UniquePtr message, bool withDAG)
@@ -68,7 +68,9 @@ public:
     bool prepare();        // return true if has schedule out message
     bool unlockPrepare();  // return true if need to detect deadlock
     void releaseOutdatedLock();
-    bool detectLockAndRevert();  // return true if detect a tx and revert
+    // revert the victims of all the dead locks, or the first locked tx reaching a dead lock for
+    // the legacy blocks, return the reverted txs
+    size_t detectLockAndRevert(bool revertAllVictims);
 
     void go(std::function<void(bcos::Error::UniquePtr, Status)> callback);
     bool hasFinished() { return m_executivePool.empty(); }
@@ -2,17 +2,10 @@
 #include "Common.h"
 #include <bcos-utilities/DataConvertUtility.h>
 #include <bcos-utilities/Error.h>
-#include <boost/core/ignore_unused.hpp>
 #include <boost/format.hpp>
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/depth_first_search.hpp>
-#include <boost/graph/detail/adjacency_list.hpp>
-#include <boost/graph/edge_list.hpp>
-#include <boost/graph/graph_selectors.hpp>
-#include <boost/graph/properties.hpp>
-#include <boost/graph/visitors.hpp>
 #include <boost/throw_exception.hpp>
 #include <algorithm>
+#include <tuple>
 
 using namespace bcos::scheduler;
 
@@ -41,34 +34,48 @@ bool GraphKeyLocks::batchAcquireKeyLock(
 bool GraphKeyLocks::acquireKeyLock(
     std::string_view contract, std::string_view key, int64_t contextID, int64_t seq)
 {
-    auto keyVertex = touchKeyLock(std::make_tuple(contract, key));
-    auto contextVertex = touchContext(contextID);
+    auto keyLock = touchKeyLock(contract, key);
+    auto& context = m_contexts[contextID];
 
-    auto range = boost::out_edges(keyVertex, m_graph);
-    for (auto it = range.first; it != range.second; ++it)
+    if (!keyLock->holdingSeqs.empty() && keyLock->holder != contextID)
     {
-        auto vertex = boost::get(VertexPropertyTag(), boost::target(*it, m_graph));
-        if (std::get<0>(*vertex) != contextID)
+        KEY_LOCK_LOG(TRACE) << boost::format(
+                                   "Acquire key lock failed, request: [%s, %s, %ld, %ld] "
+                                   "exists: [%ld]") %
+                                   contract % toHex(key) % contextID % seq % keyLock->holder;
+
+        // Key lock holding by another context
+        auto [it, inserted] = context.waiting.try_emplace(keyLock);
+        if (inserted)
         {
-            KEY_LOCK_LOG(TRACE) << boost::format(
-                                       "Acquire key lock failed, request: [%s, %s, %ld, %ld] "
-                                       "exists: [%ld]") %
-                                       contract % toHex(key) % contextID % seq %
-                                       std::get<0>(*vertex);
-
-            // Key lock holding by another context
-            addEdge(contextVertex, keyVertex, seq);
-            KEY_LOCK_LOG(TRACE) << " [[" << std::string(contract) << ":" << toHex(key) << "]]  -> "
-                                << contextID << " | " << seq;
-            return false;
+            keyLock->waiters.insert(contextID);
+            addWaitEdge(contextID, keyLock->holder);
         }
+        it->second.insert(seq);
+        KEY_LOCK_LOG(TRACE) << " [[" << std::string(contract) << ":" << toHex(key) << "]]  -> "
+                            << contextID << " | " << seq;
+        return false;
     }
 
     // Remove all request edge
-    boost::remove_edge(contextVertex, keyVertex, m_graph);
+    if (context.waiting.erase(keyLock) > 0)
+    {
+        keyLock->waiters.erase(contextID);
+    }
 
-    // Add an own edge
-    addEdge(keyVertex, contextVertex, seq);
+    // Add an own edge, the waiters wait for the new holder
+    if (keyLock->holdingSeqs.empty())
+    {
+        keyLock->holder = contextID;
+        for (auto waiter : keyLock->waiters)
+        {
+            addWaitEdge(waiter, contextID);
+        }
+    }
+    if (keyLock->holdingSeqs.insert(seq).second)
+    {
+        context.holding[seq].push_back(keyLock);
+    }
     KEY_LOCK_LOG(TRACE) << " [" << std::string(contract) << ":" << toHex(key) << "]  -> "
                         << contextID << " | " << seq;
 
@@ -82,26 +89,19 @@ bool GraphKeyLocks::acquireKeyLock(
 std::vector<std::string> GraphKeyLocks::getKeyLocksNotHoldingByContext(
     std::string_view contract, int64_t excludeContextID) const
 {
-    std::set<std::string> uniqueKeyLocks;
-
-    auto range = boost::edges(m_graph);
-    for (auto it = range.first; it != range.second; ++it)
+    std::vector<std::string> keyLocks;
+    auto it = m_keyLocks.find(contract);
+    if (it == m_keyLocks.end())
     {
-        auto sourceVertex = boost::get(VertexPropertyTag(), boost::source(*it, m_graph));
-        auto targetVertex = boost::get(VertexPropertyTag(), boost::target(*it, m_graph));
-
-        if (targetVertex->index() == 0 && std::get<0>(*targetVertex) != excludeContextID &&
-            sourceVertex->index() == 1 && std::get<0>(std::get<1>(*sourceVertex)) == contract)
-        {
-            uniqueKeyLocks.emplace(std::get<1>(std::get<1>(*sourceVertex)));
-        }
+        return keyLocks;
     }
 
-    std::vector<std::string> keyLocks;
-    keyLocks.reserve(uniqueKeyLocks.size());
-    for (auto& it : uniqueKeyLocks)
+    for (auto const& [key, keyLock] : it->second)
     {
-        keyLocks.emplace_back(std::move(it));
+        if (!keyLock.holdingSeqs.empty() && keyLock.holder != excludeContextID)
+        {
+            keyLocks.emplace_back(key);
+        }
     }
 
     return keyLocks;
@@ -109,7 +109,8 @@ std::vector<std::string> GraphKeyLocks::getKeyLocksNotHoldingByContext(
 
 void GraphKeyLocks::releaseKeyLocks(int64_t contextID, int64_t seq)
 {
-    if (m_vertexes.count(Vertex(contextID)) == 0)
+    auto contextIt = m_contexts.find(contextID);
+    if (contextIt == m_contexts.end())
     {
         return;
     }
@@ -117,161 +118,168 @@ void GraphKeyLocks::releaseKeyLocks(int64_t contextID, int64_t seq)
     SCHEDULER_LOG(TRACE) << "Release key lock, contextID: " << contextID << " seq: " << seq;
 
     KEY_LOCK_LOG(TRACE) << " [*****] -> " << contextID << " | " << seq;
-    auto vertex = touchContext(contextID);
-
-    auto edgeRemoveFunc = [seq, graph = &m_graph](auto range) mutable -> bool {
-        size_t total = 0;
-        size_t removed = 0;
+    auto& context = contextIt->second;
 
-        for (auto next = range.first; range.first != range.second; range.first = next)
+    auto holdingIt = context.holding.find(seq);
+    if (holdingIt != context.holding.end())
+    {
+        for (auto keyLock : holdingIt->second)
         {
-            ++total;
-            ++next;
-            auto edgeSeq = boost::get(EdgePropertyTag(), *range.first);
-            if (edgeSeq == seq)
+            if (bcos::LogLevel::TRACE >= bcos::c_fileLogLevel)
+            {
+                SCHEDULER_LOG(TRACE) << "Releasing key lock, contract: " << keyLock->contract
+                                     << " key: " << toHex(keyLock->key);
+            }
+            keyLock->holdingSeqs.erase(seq);
+            if (keyLock->holdingSeqs.empty())
             {
-                ++removed;
-                if (bcos::LogLevel::TRACE >= bcos::c_fileLogLevel)
+                for (auto waiter : keyLock->waiters)
                 {
-                    auto source =
-                        boost::get(VertexPropertyTag(), boost::source(*range.first, *graph));
-                    auto target =
-                        boost::get(VertexPropertyTag(), boost::target(*range.first, *graph));
-                    if (target->index() == 1)
-                    {
-                        source = target;
-                    }
-
-                    const auto& [contract, key] = std::get<1>(*source);
-                    SCHEDULER_LOG(TRACE) << "Releasing key lock, contract: " << contract
-                                         << " key: " << bcos::toHexString(key);
+                    m_waitForGraph.removeEdge(waiter, contextID);
                 }
-                boost::remove_edge(*range.first, *graph);
             }
+            tryEraseKeyLock(keyLock);
         }
-
-        return total == removed;
-    };
-
-    auto clearedIn = edgeRemoveFunc(boost::in_edges(vertex, m_graph));
-    auto clearedOut = edgeRemoveFunc(boost::out_edges(vertex, m_graph));
-
-    if (clearedIn && clearedOut)
-    {
-        // All edge had removed, delete the vertex
-        boost::remove_vertex(vertex, m_graph);
-        m_vertexes.erase(contextID);
+        context.holding.erase(holdingIt);
     }
-}
 
-bool GraphKeyLocks::detectDeadLock(ContextID contextID)
-{
-    struct GraphVisitor
+    for (auto it = context.waiting.begin(); it != context.waiting.end();)
     {
-        GraphVisitor(bool& backEdge) : m_backEdge(backEdge) {}
-
-        void initialize_vertex(VertexID, const Graph&) {}
-        void start_vertex(VertexID, const Graph&) {}
-        void discover_vertex(VertexID, const Graph&) {}
-        void examine_edge(EdgeID, const Graph&) {}
-        void tree_edge(EdgeID, const Graph&) {}
-        void forward_or_cross_edge(EdgeID, const Graph&) {}
-        void finish_edge(EdgeID, const Graph&) {}
-        void finish_vertex(VertexID, const Graph&) {}
-
-        void back_edge(EdgeID edgeID, const Graph&) const
+        auto keyLock = it->first;
+        if (it->second.erase(seq) == 0 || !it->second.empty())
         {
-            auto edgeSeq = boost::get(EdgePropertyTag(), edgeID);
-            SCHEDULER_LOG(TRACE) << "Detected back edge seq: " << edgeSeq;
-
-            m_backEdge = true;
+            ++it;
+            continue;
         }
+        it = context.waiting.erase(it);
+        keyLock->waiters.erase(contextID);
+        if (!keyLock->holdingSeqs.empty())
+        {
+            m_waitForGraph.removeEdge(contextID, keyLock->holder);
+        }
+        tryEraseKeyLock(keyLock);
+    }
 
-        bool& m_backEdge;
-    };
+    if (context.holding.empty() && context.waiting.empty())
+    {
+        // All edge had removed, delete the context
+        m_contexts.erase(contextIt);
+    }
+}
 
-    auto it = m_vertexes.find(bcos::scheduler::GraphKeyLocks::Vertex(contextID));
-    if (it == m_vertexes.end())
+bool GraphKeyLocks::detectDeadLock(ContextID contextID) const
+{
+    auto it = m_contexts.find(contextID);
+    if (it == m_contexts.end())
     {
-        // No vertex, may be removed
+        // No context, may be removed
         return false;
     }
 
-    if (boost::in_degree(it->second, m_graph) == 0)
+    if (it->second.holding.empty())
     {
-        // No in degree, not holding key lock
+        // Not holding key lock
         return false;
     }
 
-    std::map<VertexID, boost::default_color_type> vertexColors;
-    bool hasDeadLock = false;
-    boost::depth_first_visit(m_graph, it->second, GraphVisitor(hasDeadLock),
-        boost::make_assoc_property_map(vertexColors),
-        [&hasDeadLock](VertexID, const Graph&) { return hasDeadLock; });
+    // depth first search on the wait-for graph, the context waits for the holders of the keys, a
+    // back edge to a context on the search path is a cycle
+    enum class Color
+    {
+        Gray,
+        Black,
+    };
+    std::unordered_map<ContextID, Color> colors;
+    using WaitingIt = std::map<KeyLockState*, std::set<Seq>>::const_iterator;
+    // the context on the search path and its next waiting key
+    std::vector<std::tuple<ContextID, WaitingIt, WaitingIt>> path;
+    static const std::map<KeyLockState*, std::set<Seq>> c_emptyWaiting;
+    auto visit = [this, &colors, &path](ContextID id) {
+        colors[id] = Color::Gray;
+        auto contextIt = m_contexts.find(id);
+        auto const& waiting =
+            (contextIt == m_contexts.end()) ? c_emptyWaiting : contextIt->second.waiting;
+        path.emplace_back(id, waiting.begin(), waiting.end());
+    };
 
+    visit(contextID);
+    while (!path.empty())
+    {
+        auto& [id, next, end] = path.back();
+        if (next == end)
+        {
+            colors[id] = Color::Black;
+            path.pop_back();
+            continue;
+        }
+        auto keyLock = (next++)->first;
+        if (keyLock->holdingSeqs.empty())
+        {
+            continue;
+        }
+        auto colorIt = colors.find(keyLock->holder);
+        if (colorIt == colors.end())
+        {
+            visit(keyLock->holder);
+            continue;
+        }
+        if (colorIt->second == Color::Gray)
+        {
+            SCHEDULER_LOG(TRACE) << "Detected back edge, context: " << id
+                                 << " waiting for: " << keyLock->holder;
+            return true;
+        }
+    }
 
-    return hasDeadLock;
+    return false;
 }
 
-GraphKeyLocks::VertexID GraphKeyLocks::touchContext(int64_t contextID)
+GraphKeyLocks::KeyLockState* GraphKeyLocks::touchKeyLock(
+    std::string_view contract, std::string_view key)
 {
-    auto [it, inserted] = m_vertexes.emplace(Vertex(contextID), VertexID());
-    if (inserted)
+    auto contractIt = m_keyLocks.find(contract);
+    if (contractIt == m_keyLocks.end())
     {
-        it->second = boost::add_vertex(&(it->first), m_graph);
+        contractIt = m_keyLocks.emplace(std::string(contract), decltype(m_keyLocks)::mapped_type())
+                         .first;
     }
-    auto contextVertexID = it->second;
-
-    return contextVertexID;
-}
 
-GraphKeyLocks::VertexID GraphKeyLocks::touchKeyLock(KeyLockView keyLockView)
-{
-    auto contractKeyView = keyLockView;
-    auto it = m_vertexes.lower_bound(contractKeyView);
-    if (it != m_vertexes.end() && it->first == contractKeyView)
+    auto& keyLocks = contractIt->second;
+    auto it = keyLocks.lower_bound(key);
+    if (it != keyLocks.end() && it->first == key)
     {
-        return it->second;
+        return &(it->second);
     }
 
-    auto inserted = m_vertexes.emplace_hint(it,
-        Vertex(std::make_tuple(
-            std::string(std::get<0>(contractKeyView)), std::string(std::get<1>(contractKeyView)))),
-        VertexID());
-    inserted->second = boost::add_vertex(&(inserted->first), m_graph);
-    return inserted->second;
+    it = keyLocks.emplace_hint(it, std::string(key), KeyLockState());
+    it->second.contract = contractIt->first;
+    it->second.key = it->first;
+    ++m_keyLocksSize;
+    return &(it->second);
 }
 
-void GraphKeyLocks::addEdge(VertexID source, VertexID target, int64_t seq)
+void GraphKeyLocks::tryEraseKeyLock(KeyLockState* keyLock)
 {
-    bool exists = false;
-
-    auto range = boost::edge_range(source, target, m_graph);
-    for (auto it = range.first; it != range.second; ++it)
+    if (!keyLock->holdingSeqs.empty() || !keyLock->waiters.empty())
     {
-        auto edgeSeq = boost::get(EdgePropertyTag(), *it);
-        if (edgeSeq == seq)
-        {
-            exists = true;
-        }
+        return;
     }
-
-    if (!exists)
+    auto contractIt = m_keyLocks.find(keyLock->contract);
+    contractIt->second.erase(contractIt->second.find(keyLock->key));
+    --m_keyLocksSize;
+    if (contractIt->second.empty())
     {
-        boost::add_edge(source, target, seq, m_graph);
+        m_keyLocks.erase(contractIt);
     }
 }
 
-void GraphKeyLocks::removeEdge(VertexID source, VertexID target, int64_t seq)
+void GraphKeyLocks::addWaitEdge(ContextID waiter, ContextID holder)
 {
-    auto range = boost::edge_range(source, target, m_graph);
-    for (auto it = range.first; it != range.second; ++it)
+    if (m_waitForGraph.addEdge(waiter, holder))
     {
-        auto edgeSeq = boost::get(EdgePropertyTag(), *it);
-        if (edgeSeq == seq)
-        {
-            boost::remove_edge(*it, m_graph);
-            break;
-        }
+        ++m_deadLocksSize;
+        SCHEDULER_LOG(DEBUG) << "Detected dead lock, context: " << waiter
+                             << " waiting for: " << holder
+                             << " cycles: " << m_waitForGraph.cyclesSize();
     }
-}
\ No newline at end of file
+}
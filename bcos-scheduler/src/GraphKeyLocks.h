@@ -1,25 +1,26 @@
 #pragma once
 
 #include "Common.h"
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/depth_first_search.hpp>
-#include <boost/graph/edge_list.hpp>
-#include <boost/graph/graph_selectors.hpp>
-#include <boost/graph/properties.hpp>
-#include <boost/graph/visitors.hpp>
-#include <any>
-#include <forward_list>
+#include "WaitForGraph.h"
 #include <functional>
 #include <gsl/span>
+#include <map>
 #include <set>
 #include <string_view>
-#include <variant>
+#include <unordered_map>
+#include <vector>
 
 #define KEY_LOCK_LOG(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE("SCHEDULER") << LOG_BADGE("KEY_LOCK")
 // #define KEY_LOCK_LOG(LEVEL) std::cout << LOG_BADGE("KEY_LOCK")
 
 namespace bcos::scheduler
 {
+/**
+ * the key locks of the DMC contexts, indexed by contract and by context so that acquiring,
+ * releasing and querying the locks only touch the locks involved; a context waiting for a key
+ * points to the holder of the key, these edges form the wait-for graph which detects the dead
+ * locks incrementally
+ */
 class GraphKeyLocks
 {
 public:
@@ -42,86 +43,54 @@ public:
     bool acquireKeyLock(
         std::string_view contract, std::string_view key, ContextID contextID, Seq seq);
 
+    // the sorted keys of the contract held by the other contexts
     std::vector<std::string> getKeyLocksNotHoldingByContext(
         std::string_view contract, ContextID excludeContextID) const;
 
     void releaseKeyLocks(ContextID contextID, Seq seq);
 
-    bool detectDeadLock(ContextID contextID);
+    // the context holds key locks and reaches a dead lock cycle, the legacy check of the blocks
+    // before V3_0_VERSION which revert the first locked context found in every DMC round
+    bool detectDeadLock(ContextID contextID) const;
+    // the contexts to revert, one of every dead lock cycle
+    bool isDeadLockVictim(ContextID contextID) { return m_waitForGraph.isVictim(contextID); }
+    std::set<ContextID> const& deadLockVictims() { return m_waitForGraph.victims(); }
+    // the dead locks detected since the key locks are created
+    size_t deadLocksSize() const { return m_deadLocksSize; }
 
-    struct Vertex : public std::variant<ContextID, KeyLock>
-    {
-        using std::variant<ContextID, KeyLock>::variant;
-
-        bool operator==(const KeyLockView& rhs) const
-        {
-            if (index() != 1)
-            {
-                return false;
-            }
-
-            auto view = std::make_tuple(std::string_view(std::get<0>(std::get<1>(*this))),
-                std::string_view(std::get<1>(std::get<1>(*this))));
-            return view == rhs;
-        }
-    };
+    // the keys held or waited by the contexts
+    size_t keyLocksSize() const { return m_keyLocksSize; }
+    size_t contextsSize() const { return m_contexts.size(); }
 
 private:
-    struct VertexIterator
+    struct KeyLockState
     {
-        using kind = boost::vertex_property_tag;
+        std::string_view contract;
+        std::string_view key;
+        // all the holding seqs belong to the same context
+        ContextID holder = 0;
+        std::set<Seq> holdingSeqs;
+        // the contexts waiting for the key
+        std::set<ContextID> waiters;
     };
-    using VertexProperty = boost::property<VertexIterator, const Vertex*>;
-    struct EdgeSeq
+    struct ContextLocks
     {
-        using kind = boost::edge_property_tag;
+        std::map<Seq, std::vector<KeyLockState*>> holding;
+        std::map<KeyLockState*, std::set<Seq>> waiting;
     };
-    using EdgeProperty = boost::property<EdgeSeq, int64_t>;
 
-    using Graph = boost::adjacency_list<boost::multisetS, boost::multisetS, boost::bidirectionalS,
-        VertexProperty, EdgeProperty>;
-    using VertexPropertyTag = boost::property_map<Graph, VertexIterator>::const_type;
-    using EdgePropertyTag = boost::property_map<Graph, EdgeSeq>::const_type;
-    using VertexID = Graph::vertex_descriptor;
-    using EdgeID = Graph::edge_descriptor;
-
-    Graph m_graph;
-    std::map<Vertex, VertexID, std::less<>> m_vertexes;
-
-    VertexID touchContext(ContextID contextID);
-    VertexID touchKeyLock(KeyLockView keylockView);
-
-    void addEdge(VertexID source, VertexID target, Seq seq);
-    void removeEdge(VertexID source, VertexID target, Seq seq);
+    KeyLockState* touchKeyLock(std::string_view contract, std::string_view key);
+    // erase the key lock once no context holds or waits for it
+    void tryEraseKeyLock(KeyLockState* keyLock);
+    void addWaitEdge(ContextID waiter, ContextID holder);
+
+    // contract => key => lock state
+    std::map<std::string, std::map<std::string, KeyLockState, std::less<>>, std::less<>>
+        m_keyLocks;
+    size_t m_keyLocksSize = 0;
+    std::unordered_map<ContextID, ContextLocks> m_contexts;
+    WaitForGraph m_waitForGraph;
+    size_t m_deadLocksSize = 0;
 };
 
 }  // namespace bcos::scheduler
-
-namespace std
-{
-inline bool operator<(const bcos::scheduler::GraphKeyLocks::Vertex& lhs,
-    const bcos::scheduler::GraphKeyLocks::KeyLockView& rhs)
-{
-    if (lhs.index() != 1)
-    {
-        return true;
-    }
-
-    auto view = std::make_tuple(std::string_view(std::get<0>(std::get<1>(lhs))),
-        std::string_view(std::get<1>(std::get<1>(lhs))));
-    return view < rhs;
-}
-
-inline bool operator<(const bcos::scheduler::GraphKeyLocks::KeyLockView& lhs,
-    const bcos::scheduler::GraphKeyLocks::Vertex& rhs)
-{
-    if (rhs.index() != 1)
-    {
-        return false;
-    }
-
-    auto view = std::make_tuple(std::string_view(std::get<0>(std::get<1>(rhs))),
-        std::string_view(std::get<1>(std::get<1>(rhs))));
-    return lhs < view;
-}
-}  // namespace std
\ No newline at end of file
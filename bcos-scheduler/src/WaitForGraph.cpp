@@ -0,0 +1,278 @@
+#include "WaitForGraph.h"
+#include <algorithm>
+#include <iterator>
+
+using namespace bcos::scheduler;
+
+bool WaitForGraph::addEdge(ContextID from, ContextID to)
+{
+    auto& count = m_edges[Edge(from, to)];
+    if (count++ > 0)
+    {
+        return false;
+    }
+    touchVertex(from).degree++;
+    touchVertex(to).degree++;
+    if (insertOrderedEdge(from, to))
+    {
+        // the edge may extend the existing cycles
+        m_cyclesChanged = m_cyclesChanged || !m_cycleEdges.empty();
+        return false;
+    }
+
+    SCHEDULER_LOG(TRACE) << "Detected wait-for cycle, context: " << from
+                         << " waiting for: " << to;
+    m_cycleEdges.emplace(from, to);
+    m_cyclesChanged = true;
+    return true;
+}
+
+void WaitForGraph::removeEdge(ContextID from, ContextID to)
+{
+    auto it = m_edges.find(Edge(from, to));
+    if (it == m_edges.end() || --(it->second) > 0)
+    {
+        return;
+    }
+    m_edges.erase(it);
+
+    if (m_cycleEdges.erase(Edge(from, to)) == 0)
+    {
+        m_vertices[from].successors.erase(to);
+        m_vertices[to].predecessors.erase(from);
+    }
+    releaseVertex(from);
+    releaseVertex(to);
+
+    // the removed edge may break some cycles
+    m_cyclesChanged = m_cyclesChanged || !m_cycleEdges.empty() || !m_cycleContexts.empty();
+}
+
+WaitForGraph::Vertex& WaitForGraph::touchVertex(ContextID contextID)
+{
+    auto [it, inserted] = m_vertices.try_emplace(contextID);
+    if (inserted)
+    {
+        it->second.order = m_nextOrder++;
+    }
+    return it->second;
+}
+
+void WaitForGraph::releaseVertex(ContextID contextID)
+{
+    auto it = m_vertices.find(contextID);
+    if (it != m_vertices.end() && --(it->second.degree) == 0)
+    {
+        m_vertices.erase(it);
+    }
+}
+
+bool WaitForGraph::insertOrderedEdge(ContextID from, ContextID to)
+{
+    if (from == to)
+    {
+        return false;
+    }
+    auto& fromVertex = m_vertices[from];
+    auto& toVertex = m_vertices[to];
+    auto lowerBound = toVertex.order;
+    auto upperBound = fromVertex.order;
+    if (upperBound < lowerBound)
+    {
+        fromVertex.successors.insert(to);
+        toVertex.predecessors.insert(from);
+        return true;
+    }
+
+    // the contexts reachable from the target and ordered before the source, reaching the source
+    // means a cycle
+    std::vector<ContextID> forward;
+    std::set<ContextID> visited{to};
+    std::vector<ContextID> stack{to};
+    while (!stack.empty())
+    {
+        auto current = stack.back();
+        stack.pop_back();
+        forward.push_back(current);
+        for (auto next : m_vertices[current].successors)
+        {
+            auto order = m_vertices[next].order;
+            if (order == upperBound)
+            {
+                return false;
+            }
+            if (order < upperBound && visited.insert(next).second)
+            {
+                stack.push_back(next);
+            }
+        }
+    }
+
+    // the contexts reaching the source and ordered after the target
+    std::vector<ContextID> backward;
+    stack.push_back(from);
+    visited.insert(from);
+    while (!stack.empty())
+    {
+        auto current = stack.back();
+        stack.pop_back();
+        backward.push_back(current);
+        for (auto previous : m_vertices[current].predecessors)
+        {
+            if (m_vertices[previous].order > lowerBound && visited.insert(previous).second)
+            {
+                stack.push_back(previous);
+            }
+        }
+    }
+
+    // reuse the orders of the affected contexts: the backward ones first, then the forward ones
+    auto byOrder = [this](ContextID lhs, ContextID rhs) {
+        return m_vertices[lhs].order < m_vertices[rhs].order;
+    };
+    std::sort(forward.begin(), forward.end(), byOrder);
+    std::sort(backward.begin(), backward.end(), byOrder);
+    std::vector<int64_t> orders;
+    orders.reserve(forward.size() + backward.size());
+    for (auto contextID : backward)
+    {
+        orders.push_back(m_vertices[contextID].order);
+    }
+    for (auto contextID : forward)
+    {
+        orders.push_back(m_vertices[contextID].order);
+    }
+    std::sort(orders.begin(), orders.end());
+    size_t index = 0;
+    for (auto contextID : backward)
+    {
+        m_vertices[contextID].order = orders[index++];
+    }
+    for (auto contextID : forward)
+    {
+        m_vertices[contextID].order = orders[index++];
+    }
+
+    fromVertex.successors.insert(to);
+    toVertex.predecessors.insert(from);
+    return true;
+}
+
+void WaitForGraph::updateCycles()
+{
+    if (!m_cyclesChanged)
+    {
+        return;
+    }
+    m_cyclesChanged = false;
+    m_cycleContexts.clear();
+    m_victims.clear();
+
+    // the removed edges may break the cycles of the set aside edges
+    std::map<ContextID, std::vector<ContextID>> cycleEdges;
+    for (auto it = m_cycleEdges.begin(); it != m_cycleEdges.end();)
+    {
+        if (insertOrderedEdge(it->first, it->second))
+        {
+            it = m_cycleEdges.erase(it);
+            continue;
+        }
+        cycleEdges[it->first].push_back(it->second);
+        if (it->first == it->second)
+        {
+            // waiting for itself
+            m_cycleContexts.insert(it->first);
+            m_victims.insert(it->first);
+        }
+        ++it;
+    }
+
+    // every cycle has a set aside edge, find the strongly connected components reachable from the
+    // set aside edges (iterative Tarjan), the contexts of the non-trivial components are on cycles
+    struct Visit
+    {
+        int64_t index;
+        int64_t lowLink;
+        bool onStack;
+    };
+    std::unordered_map<ContextID, Visit> visits;
+    std::vector<ContextID> components;
+    // the contexts being searched, with their successors and the next successor to search
+    struct Step
+    {
+        ContextID contextID;
+        std::vector<ContextID> successors;
+        size_t next;
+    };
+    std::vector<Step> path;
+    int64_t nextIndex = 0;
+    auto successors = [this, &cycleEdges](ContextID contextID) {
+        std::vector<ContextID> result(m_vertices.at(contextID).successors.begin(),
+            m_vertices.at(contextID).successors.end());
+        auto it = cycleEdges.find(contextID);
+        if (it != cycleEdges.end())
+        {
+            result.insert(result.end(), it->second.begin(), it->second.end());
+        }
+        return result;
+    };
+    auto visit = [&](ContextID contextID) {
+        visits[contextID] = {nextIndex, nextIndex, true};
+        ++nextIndex;
+        components.push_back(contextID);
+        path.push_back({contextID, successors(contextID), 0});
+    };
+
+    for (auto const& edge : m_cycleEdges)
+    {
+        if (visits.count(edge.second) > 0)
+        {
+            continue;
+        }
+        visit(edge.second);
+        while (!path.empty())
+        {
+            auto& step = path.back();
+            auto current = step.contextID;
+            if (step.next < step.successors.size())
+            {
+                auto nextContext = step.successors[step.next++];
+                auto it = visits.find(nextContext);
+                if (it == visits.end())
+                {
+                    visit(nextContext);
+                }
+                else if (it->second.onStack)
+                {
+                    auto& currentVisit = visits[current];
+                    currentVisit.lowLink = std::min(currentVisit.lowLink, it->second.index);
+                }
+                continue;
+            }
+
+            path.pop_back();
+            auto& currentVisit = visits[current];
+            if (!path.empty())
+            {
+                auto& parentVisit = visits[path.back().contextID];
+                parentVisit.lowLink = std::min(parentVisit.lowLink, currentVisit.lowLink);
+            }
+            if (currentVisit.lowLink != currentVisit.index)
+            {
+                continue;
+            }
+            // pop the component, revert its youngest (largest) context
+            auto first = std::find(components.begin(), components.end(), current);
+            for (auto it = first; it != components.end(); ++it)
+            {
+                visits[*it].onStack = false;
+            }
+            if (std::distance(first, components.end()) > 1)
+            {
+                m_cycleContexts.insert(first, components.end());
+                m_victims.insert(*std::max_element(first, components.end()));
+            }
+            components.erase(first, components.end());
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Common.h"
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace bcos::scheduler
+{
+/**
+ * the wait-for graph of the DMC contexts with incremental cycle detection: the edges keep a
+ * topological order of the contexts (Pearce-Kelly dynamic topological sort), an edge that cannot
+ * be ordered closes a cycle and is set aside until one edge of the cycle is removed; every cycle
+ * has a set aside edge, so only the contexts reachable from the set aside edges are searched for
+ * the cycles, and the youngest (largest) context of every cycle component is the victim
+ */
+class WaitForGraph
+{
+public:
+    WaitForGraph() = default;
+    WaitForGraph(const WaitForGraph&) = delete;
+    WaitForGraph& operator=(const WaitForGraph&) = delete;
+
+    // the edges are counted, return true if the edge closes a new cycle
+    bool addEdge(ContextID from, ContextID to);
+    void removeEdge(ContextID from, ContextID to);
+
+    bool onCycle(ContextID contextID)
+    {
+        updateCycles();
+        return m_cycleContexts.count(contextID) > 0;
+    }
+    bool isVictim(ContextID contextID)
+    {
+        updateCycles();
+        return m_victims.count(contextID) > 0;
+    }
+    // the contexts to revert to break the cycles, deterministic for the same edges sequence
+    std::set<ContextID> const& victims()
+    {
+        updateCycles();
+        return m_victims;
+    }
+
+    size_t cyclesSize() const { return m_cycleEdges.size(); }
+    size_t verticesSize() const { return m_vertices.size(); }
+
+private:
+    struct Vertex
+    {
+        int64_t order = 0;
+        // the edges in the topological order
+        std::set<ContextID> successors;
+        std::set<ContextID> predecessors;
+        // all the distinct edges of the vertex, including the edges closing the cycles
+        size_t degree = 0;
+    };
+    using Edge = std::pair<ContextID, ContextID>;
+
+    Vertex& touchVertex(ContextID contextID);
+    void releaseVertex(ContextID contextID);
+
+    // insert the edge and keep the topological order, return false if the edge closes a cycle
+    bool insertOrderedEdge(ContextID from, ContextID to);
+    // retry ordering the set aside edges and collect the contexts on the cycles, when queried
+    // after the edges changed
+    void updateCycles();
+
+    std::unordered_map<ContextID, Vertex> m_vertices;
+    std::map<Edge, size_t> m_edges;
+    std::set<Edge> m_cycleEdges;
+    bool m_cyclesChanged = false;
+    std::set<ContextID> m_cycleContexts;
+    std::set<ContextID> m_victims;
+    int64_t m_nextOrder = 0;
+};
+}  // namespace bcos::scheduler
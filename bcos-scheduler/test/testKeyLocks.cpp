@@ -1,10 +1,12 @@
 #include "GraphKeyLocks.h"
+#include "WaitForGraph.h"
 #include "mock/MockExecutor.h"
 #include <bcos-utilities/Common.h>
 #include <boost/lexical_cast.hpp>
 #include <boost/test/tools/old/interface.hpp>
 #include <boost/test/unit_test.hpp>
 #include <memory>
+#include <random>
 
 namespace bcos::test
 {
@@ -79,6 +81,37 @@ BOOST_AUTO_TEST_CASE(getKeyLocksNotHoldingByContext)
     BOOST_CHECK_EQUAL_COLLECTIONS(keys.begin(), keys.end(), matchKeys.begin(), matchKeys.end());
 }
 
+BOOST_AUTO_TEST_CASE(releaseKeyLocks)
+{
+    std::string to = "contract1";
+
+    BOOST_CHECK(keyLocks.acquireKeyLock(to, "key1", 1000, 1));
+    BOOST_CHECK(keyLocks.acquireKeyLock(to, "key2", 1000, 2));
+    BOOST_CHECK(keyLocks.acquireKeyLock("contract2", "key1", 1001, 1));
+    BOOST_CHECK(!keyLocks.acquireKeyLock(to, "key1", 1001, 2));
+    BOOST_CHECK_EQUAL(keyLocks.keyLocksSize(), 3);
+    BOOST_CHECK_EQUAL(keyLocks.contextsSize(), 2);
+
+    auto keys = keyLocks.getKeyLocksNotHoldingByContext(to, 1001);
+    BOOST_CHECK_EQUAL(keys.size(), 2);
+    BOOST_CHECK(keyLocks.getKeyLocksNotHoldingByContext(to, 1000).empty());
+    BOOST_CHECK(keyLocks.getKeyLocksNotHoldingByContext("contract3", 1000).empty());
+
+    // key1 is still waited by 1001
+    keyLocks.releaseKeyLocks(1000, 1);
+    BOOST_CHECK_EQUAL(keyLocks.keyLocksSize(), 3);
+    BOOST_CHECK_EQUAL(keyLocks.getKeyLocksNotHoldingByContext(to, 1001).size(), 1);
+
+    // the waiting is removed with the seq
+    keyLocks.releaseKeyLocks(1001, 2);
+    BOOST_CHECK_EQUAL(keyLocks.keyLocksSize(), 2);
+    keyLocks.releaseKeyLocks(1000, 2);
+    BOOST_CHECK_EQUAL(keyLocks.contextsSize(), 1);
+    keyLocks.releaseKeyLocks(1001, 1);
+    BOOST_CHECK_EQUAL(keyLocks.keyLocksSize(), 0);
+    BOOST_CHECK_EQUAL(keyLocks.contextsSize(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(deadLock)
 {
     std::string to = "contract1";
@@ -110,5 +143,191 @@ BOOST_AUTO_TEST_CASE(deadLock)
     BOOST_CHECK(keyLocks.detectDeadLock(1001));
 }
 
+BOOST_AUTO_TEST_CASE(deadLockOfContexts)
+{
+    std::string to = "contract1";
+
+    // 1000 -> 1001 -> 1002, no dead lock
+    BOOST_CHECK(keyLocks.acquireKeyLock(to, "key1", 1000, 1));
+    BOOST_CHECK(keyLocks.acquireKeyLock(to, "key2", 1001, 1));
+    BOOST_CHECK(keyLocks.acquireKeyLock(to, "key3", 1002, 1));
+    BOOST_CHECK(!keyLocks.acquireKeyLock(to, "key2", 1000, 2));
+    BOOST_CHECK(!keyLocks.acquireKeyLock(to, "key3", 1001, 2));
+    BOOST_CHECK(!keyLocks.detectDeadLock(1000));
+    BOOST_CHECK(!keyLocks.detectDeadLock(1002));
+
+    // 1002 -> 1000 closes the cycle
+    BOOST_CHECK(!keyLocks.acquireKeyLock(to, "key1", 1002, 2));
+    BOOST_CHECK(keyLocks.detectDeadLock(1000));
+    BOOST_CHECK(keyLocks.detectDeadLock(1001));
+    BOOST_CHECK(keyLocks.detectDeadLock(1002));
+
+    // revert 1002 breaks the cycle
+    keyLocks.releaseKeyLocks(1002, 2);
+    keyLocks.releaseKeyLocks(1002, 1);
+    BOOST_CHECK(!keyLocks.detectDeadLock(1000));
+    BOOST_CHECK(!keyLocks.detectDeadLock(1001));
+    BOOST_CHECK(!keyLocks.detectDeadLock(1002));
+    BOOST_CHECK(keyLocks.acquireKeyLock(to, "key3", 1001, 2));
+}
+
+BOOST_AUTO_TEST_CASE(deadLockVictims)
+{
+    std::string to = "contract1";
+
+    // two dead locks: 1000 <-> 1001 and 1002 <-> 1003
+    BOOST_CHECK(keyLocks.acquireKeyLock(to, "key1", 1000, 1));
+    BOOST_CHECK(keyLocks.acquireKeyLock(to, "key2", 1001, 1));
+    BOOST_CHECK(keyLocks.acquireKeyLock(to, "key3", 1002, 1));
+    BOOST_CHECK(keyLocks.acquireKeyLock(to, "key4", 1003, 1));
+    BOOST_CHECK(!keyLocks.acquireKeyLock(to, "key2", 1000, 2));
+    BOOST_CHECK(!keyLocks.acquireKeyLock(to, "key4", 1002, 2));
+    BOOST_CHECK(keyLocks.deadLockVictims().empty());
+    BOOST_CHECK(!keyLocks.acquireKeyLock(to, "key1", 1001, 2));
+    BOOST_CHECK(!keyLocks.acquireKeyLock(to, "key3", 1003, 2));
+    BOOST_CHECK_EQUAL(keyLocks.deadLocksSize(), 2);
+
+    // the youngest context of every dead lock
+    std::set<int64_t> victims{1001, 1003};
+    BOOST_CHECK(keyLocks.deadLockVictims() == victims);
+    BOOST_CHECK(keyLocks.isDeadLockVictim(1001));
+    BOOST_CHECK(!keyLocks.isDeadLockVictim(1000));
+
+    // revert 1001
+    keyLocks.releaseKeyLocks(1001, 2);
+    keyLocks.releaseKeyLocks(1001, 1);
+    BOOST_CHECK(!keyLocks.detectDeadLock(1000));
+    BOOST_CHECK(keyLocks.detectDeadLock(1002));
+    BOOST_CHECK(keyLocks.deadLockVictims() == std::set<int64_t>{1003});
+
+    // the waiting 1000 gets key2, then the waiting 1001 closes a new dead lock
+    BOOST_CHECK(keyLocks.acquireKeyLock(to, "key2", 1000, 2));
+    BOOST_CHECK(keyLocks.acquireKeyLock(to, "key5", 1001, 3));
+    BOOST_CHECK(!keyLocks.acquireKeyLock(to, "key1", 1001, 4));
+    BOOST_CHECK(!keyLocks.detectDeadLock(1001));
+    BOOST_CHECK(!keyLocks.acquireKeyLock(to, "key5", 1000, 3));
+    BOOST_CHECK(keyLocks.detectDeadLock(1000));
+    BOOST_CHECK(keyLocks.isDeadLockVictim(1001));
+    BOOST_CHECK_EQUAL(keyLocks.deadLocksSize(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(deadLockVictimsOfVersions)
+{
+    std::string to = "contract1";
+
+    // two dead locks: 1001 <-> 1002 and 1003 <-> 1004, 1000 waits for the first one
+    BOOST_CHECK(keyLocks.acquireKeyLock(to, "key0", 1000, 1));
+    BOOST_CHECK(keyLocks.acquireKeyLock(to, "key1", 1001, 1));
+    BOOST_CHECK(keyLocks.acquireKeyLock(to, "key2", 1002, 1));
+    BOOST_CHECK(keyLocks.acquireKeyLock(to, "key3", 1003, 1));
+    BOOST_CHECK(keyLocks.acquireKeyLock(to, "key4", 1004, 1));
+    BOOST_CHECK(!keyLocks.acquireKeyLock(to, "key1", 1000, 2));
+    BOOST_CHECK(!keyLocks.acquireKeyLock(to, "key2", 1001, 2));
+    BOOST_CHECK(!keyLocks.acquireKeyLock(to, "key1", 1002, 2));
+    BOOST_CHECK(!keyLocks.acquireKeyLock(to, "key4", 1003, 2));
+    BOOST_CHECK(!keyLocks.acquireKeyLock(to, "key3", 1004, 2));
+
+    // the reverted contexts of a DMC round, like DmcExecutor::detectLockAndRevert
+    std::vector<int64_t> locked{1000, 1001, 1002, 1003, 1004};
+    auto revert = [this, &locked](bool revertAllVictims) {
+        std::vector<int64_t> reverted;
+        for (auto contextID : locked)
+        {
+            if (revertAllVictims ? keyLocks.isDeadLockVictim(contextID) :
+                                   keyLocks.detectDeadLock(contextID))
+            {
+                reverted.push_back(contextID);
+                if (!revertAllVictims)
+                {
+                    break;
+                }
+            }
+        }
+        return reverted;
+    };
+
+    // the blocks before V3_0_VERSION revert the first locked context reaching a dead lock
+    BOOST_CHECK(revert(false) == std::vector<int64_t>{1000});
+    // the later blocks revert the youngest context of every dead lock
+    BOOST_CHECK(revert(true) == (std::vector<int64_t>{1002, 1004}));
+
+    // the legacy round after reverting 1000 reverts the first context of the first dead lock
+    keyLocks.releaseKeyLocks(1000, 2);
+    keyLocks.releaseKeyLocks(1000, 1);
+    locked.erase(locked.begin());
+    BOOST_CHECK(revert(false) == std::vector<int64_t>{1001});
+    BOOST_CHECK(revert(true) == (std::vector<int64_t>{1002, 1004}));
+}
+
+BOOST_AUTO_TEST_CASE(waitForGraph)
+{
+    // compare the incremental cycle detection with the search of every context
+    scheduler::WaitForGraph graph;
+    std::map<std::pair<int64_t, int64_t>, size_t> edges;
+    auto onCycle = [&edges](int64_t contextID) {
+        std::set<int64_t> visited;
+        std::vector<int64_t> stack{contextID};
+        while (!stack.empty())
+        {
+            auto current = stack.back();
+            stack.pop_back();
+            for (auto it = edges.lower_bound({current, INT64_MIN});
+                 it != edges.end() && it->first.first == current; ++it)
+            {
+                if (it->first.second == contextID)
+                {
+                    return true;
+                }
+                if (visited.insert(it->first.second).second)
+                {
+                    stack.push_back(it->first.second);
+                }
+            }
+        }
+        return false;
+    };
+
+    std::mt19937 random(0);
+    const int64_t contexts = 12;
+    for (size_t i = 0; i < 3000; ++i)
+    {
+        auto from = (int64_t)(random() % contexts);
+        auto to = (int64_t)(random() % contexts);
+        if (random() % 2 == 0)
+        {
+            graph.addEdge(from, to);
+            edges[{from, to}]++;
+        }
+        else if (!edges.empty())
+        {
+            auto it = std::next(edges.begin(), random() % edges.size());
+            graph.removeEdge(it->first.first, it->first.second);
+            if (--(it->second) == 0)
+            {
+                edges.erase(it);
+            }
+        }
+
+        for (int64_t contextID = 0; contextID < contexts; ++contextID)
+        {
+            BOOST_CHECK_EQUAL(graph.onCycle(contextID), onCycle(contextID));
+        }
+        for (auto victim : graph.victims())
+        {
+            BOOST_CHECK(onCycle(victim));
+        }
+    }
+    while (!edges.empty())
+    {
+        graph.removeEdge(edges.begin()->first.first, edges.begin()->first.second);
+        if (--(edges.begin()->second) == 0)
+        {
+            edges.erase(edges.begin());
+        }
+    }
+    BOOST_CHECK_EQUAL(graph.verticesSize(), 0);
+    BOOST_CHECK(graph.victims().empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace bcos::test
\ No newline at end of file
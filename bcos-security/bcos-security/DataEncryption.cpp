@@ -28,6 +28,8 @@
 #include <bcos-utilities/DataConvertUtility.h>
 #include <bcos-utilities/FileUtility.h>
 #include <bcos-utilities/Log.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
 
 using namespace std;
 using namespace bcos;
@@ -146,6 +148,44 @@ std::string DataEncryption::decrypt(const std::string& data)
     return value;
 }
 
+void DataEncryption::encryptBatch(std::vector<std::string>& datas)
+{
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, datas.size(), c_batchGrainSize),
+        [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i)
+            {
+                auto& data = datas[i];
+                if (data.empty())
+                {
+                    continue;
+                }
+                bytesPointer encData = m_symmetricEncrypt->symmetricEncrypt(
+                    reinterpret_cast<const unsigned char*>(data.data()), data.size(),
+                    reinterpret_cast<const unsigned char*>(m_dataKey.data()), m_dataKey.size());
+                data.assign(reinterpret_cast<const char*>(encData->data()), encData->size());
+            }
+        });
+}
+
+void DataEncryption::decryptBatch(std::vector<std::string>& datas)
+{
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, datas.size(), c_batchGrainSize),
+        [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i)
+            {
+                auto& data = datas[i];
+                if (data.empty())
+                {
+                    continue;
+                }
+                bytesPointer decData = m_symmetricEncrypt->symmetricDecrypt(
+                    reinterpret_cast<const unsigned char*>(data.data()), data.size(),
+                    reinterpret_cast<const unsigned char*>(m_dataKey.data()), m_dataKey.size());
+                data.assign(reinterpret_cast<const char*>(decData->data()), decData->size());
+            }
+        });
+}
+
 }  // namespace security
 
 }  // namespace bcos
@@ -53,11 +53,19 @@ public:
     std::string encrypt(const std::string& data) override;
     std::string decrypt(const std::string& data) override;
 
-private:
-    bcos::tool::NodeConfig::Ptr m_nodeConfig{nullptr};
+    // encrypt/decrypt the values in parallel, the result overwrites the buffer of the value
+    void encryptBatch(std::vector<std::string>& datas) override;
+    void decryptBatch(std::vector<std::string>& datas) override;
 
+protected:
     std::string m_dataKey;
     bcos::crypto::SymmetricEncryption::Ptr m_symmetricEncrypt{nullptr};
+
+private:
+    // the values of one task, to amortize the scheduling cost of the small values
+    static constexpr size_t c_batchGrainSize = 64;
+
+    bcos::tool::NodeConfig::Ptr m_nodeConfig{nullptr};
 };
 
 }  // namespace security
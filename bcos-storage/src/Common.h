@@ -21,11 +21,48 @@
 
 #pragma once
 
+#include <bcos-framework/interfaces/ledger/LedgerTypeDef.h>
 #include <bcos-framework/interfaces/storage/StorageInterface.h>
+#include <set>
 
 namespace bcos::storage
 {
 const char* const TABLE_KEY_SPLIT = ":";
+// the ledger tables are append only, the state tables are updated randomly, the other system
+// tables are small and stay in the default column family
+const char* const LEDGER_COLUMN_FAMILY = "ledger";
+const char* const STATE_COLUMN_FAMILY = "state";
+// the key in the default column family written after the rows are moved to the column families,
+// it has no table key split so no table row collides with it
+const char* const COLUMN_FAMILIES_MIGRATED_KEY = "#column_families_migrated";
+// the key in the default column family written when the db is created with the compression, every
+// value of the db has the format byte of ValueCompressor
+const char* const VALUE_FORMAT_KEY = "#value_format";
+const char* const VALUE_FORMAT_VERSION = "1";
+
+enum class TableClass : uint8_t
+{
+    System = 0,
+    Ledger = 1,
+    State = 2,
+};
+
+inline TableClass tableClass(const std::string_view& tableName)
+{
+    static const std::set<std::string_view> ledgerTables = {ledger::SYS_HASH_2_NUMBER,
+        ledger::SYS_NUMBER_2_HASH, ledger::SYS_BLOCK_NUMBER_2_NONCES,
+        ledger::SYS_NUMBER_2_BLOCK_HEADER, ledger::SYS_NUMBER_2_TXS, ledger::SYS_HASH_2_TX,
+        ledger::SYS_HASH_2_RECEIPT};
+    if (ledgerTables.count(tableName))
+    {
+        return TableClass::Ledger;
+    }
+    if (tableName.substr(0, 2) == "s_")
+    {
+        return TableClass::System;
+    }
+    return TableClass::State;
+}
 
 inline std::string toDBKey(const std::string_view& tableName, const std::string_view& key)
 {
@@ -0,0 +1,122 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the options of the column families of RocksDBStorage
+ * @file RocksDBOptions.cpp
+ * @date: 2022-07-14
+ */
+
+#include "RocksDBOptions.h"
+#include "Common.h"
+#include <rocksdb/cache.h>
+#include <rocksdb/filter_policy.h>
+#include <rocksdb/table.h>
+#include <cstring>
+
+using namespace bcos::storage;
+
+namespace
+{
+class TablePrefixTransform : public rocksdb::SliceTransform
+{
+public:
+    // the name is persisted in the sst files, must not be changed
+    const char* Name() const override { return "bcos.TablePrefix"; }
+
+    rocksdb::Slice Transform(const rocksdb::Slice& key) const override
+    {
+        auto pos = std::memchr(key.data(), *TABLE_KEY_SPLIT, key.size());
+        return rocksdb::Slice(key.data(), (const char*)pos - key.data() + 1);
+    }
+
+    bool InDomain(const rocksdb::Slice& key) const override
+    {
+        return std::memchr(key.data(), *TABLE_KEY_SPLIT, key.size()) != nullptr;
+    }
+
+    bool InRange(const rocksdb::Slice&) const override { return false; }
+
+    bool SameResultWhenAppended(const rocksdb::Slice& prefix) const override
+    {
+        return InDomain(prefix) && Transform(prefix).size() == prefix.size();
+    }
+};
+
+void setBlockOptions(rocksdb::ColumnFamilyOptions& options, const RocksDBOption& option,
+    const std::shared_ptr<rocksdb::Cache>& blockCache, size_t blockSize)
+{
+    rocksdb::BlockBasedTableOptions tableOptions;
+    tableOptions.block_size = blockSize;
+    tableOptions.block_cache = blockCache;
+    if (option.bloomBitsPerKey > 0)
+    {
+        tableOptions.filter_policy.reset(rocksdb::NewBloomFilterPolicy(option.bloomBitsPerKey));
+        tableOptions.whole_key_filtering = true;
+    }
+    if (option.pinL0FilterAndIndex)
+    {
+        // the index and filter blocks are charged to the block cache instead of the table reader
+        tableOptions.cache_index_and_filter_blocks = true;
+        tableOptions.cache_index_and_filter_blocks_with_high_priority = true;
+        tableOptions.pin_l0_filter_and_index_blocks_in_cache = true;
+    }
+    options.table_factory.reset(rocksdb::NewBlockBasedTableFactory(tableOptions));
+    if (option.prefixBloom)
+    {
+        options.prefix_extractor = newTablePrefixTransform();
+    }
+}
+}  // namespace
+
+std::shared_ptr<const rocksdb::SliceTransform> bcos::storage::newTablePrefixTransform()
+{
+    return std::make_shared<TablePrefixTransform>();
+}
+
+std::vector<rocksdb::ColumnFamilyDescriptor> bcos::storage::createColumnFamilyDescriptors(
+    const rocksdb::Options& options, const RocksDBOption& option)
+{
+    std::shared_ptr<rocksdb::Cache> blockCache;
+    if (option.blockCacheSize > 0)
+    {
+        blockCache = rocksdb::NewLRUCache(option.blockCacheSize);
+    }
+
+    // the small system tables
+    rocksdb::ColumnFamilyOptions defaultOptions(options);
+    setBlockOptions(defaultOptions, option, blockCache, 4 * 1024);
+
+    // the ledger data is written once and read by block number or hash, compact it in sorted
+    // runs and compress it with larger blocks
+    rocksdb::ColumnFamilyOptions ledgerOptions(options);
+    ledgerOptions.compaction_style = rocksdb::kCompactionStyleUniversal;
+    ledgerOptions.compression = rocksdb::kZSTD;
+    ledgerOptions.write_buffer_size = 128 * 1024 * 1024;
+    setBlockOptions(ledgerOptions, option, blockCache, 64 * 1024);
+
+    // the state is updated randomly, keep level compaction and only compress the bottommost level
+    // which holds most of the data
+    rocksdb::ColumnFamilyOptions stateOptions(options);
+    stateOptions.compaction_style = rocksdb::kCompactionStyleLevel;
+    stateOptions.level_compaction_dynamic_level_bytes = true;
+    stateOptions.compression = rocksdb::kNoCompression;
+    stateOptions.bottommost_compression = rocksdb::kZSTD;
+    stateOptions.enable_blob_files = option.enableBlobFiles;
+    // options.min_blob_size = 1024;
+    setBlockOptions(stateOptions, option, blockCache, 16 * 1024);
+
+    return {{rocksdb::kDefaultColumnFamilyName, defaultOptions},
+        {LEDGER_COLUMN_FAMILY, ledgerOptions}, {STATE_COLUMN_FAMILY, stateOptions}};
+}
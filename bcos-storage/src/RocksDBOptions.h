@@ -0,0 +1,58 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief the options of the column families of RocksDBStorage
+ * @file RocksDBOptions.h
+ * @date: 2022-07-14
+ */
+
+#pragma once
+
+#include <rocksdb/options.h>
+#include <rocksdb/slice_transform.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bcos::storage
+{
+// the read tuning profile of RocksDBStorage
+struct RocksDBOption
+{
+    // extract the table name as the prefix, the prefix scan of a table and the lookup of the
+    // absent table can be filtered by the prefix bloom
+    bool prefixBloom = true;
+    // the bits of the bloom filter of every key, 0 means no bloom filter
+    int bloomBitsPerKey = 10;
+    // the block cache shared by all column families, in bytes
+    size_t blockCacheSize = 512 * 1024 * 1024;
+    // cache the index and filter blocks, and pin the ones of L0 which are read by every lookup
+    bool pinL0FilterAndIndex = true;
+    // store the large values such as the pages of KeyPageStorage in the blob files
+    bool enableBlobFiles = false;
+    // compress the values not smaller than the threshold by zstd before written, such as the
+    // contract code, abi and the pages of KeyPageStorage
+    bool compressValue = false;
+    size_t compressThreshold = 1024;
+    int compressLevel = 3;
+};
+
+// the prefix of "table:key" is "table:"
+std::shared_ptr<const rocksdb::SliceTransform> newTablePrefixTransform();
+
+// the descriptors of the default, ledger and state column families
+std::vector<rocksdb::ColumnFamilyDescriptor> createColumnFamilyDescriptors(
+    const rocksdb::Options& options, const RocksDBOption& option);
+}  // namespace bcos::storage
@@ -26,12 +26,14 @@
 #include <rocksdb/cleanable.h>
 #include <rocksdb/options.h>
 #include <rocksdb/slice.h>
+#include <rocksdb/write_batch.h>
 #include <tbb/concurrent_vector.h>
 #include <tbb/spin_mutex.h>
 #include <boost/algorithm/hex.hpp>
 #include <exception>
 #include <future>
 #include <optional>
+#include <tuple>
 
 using namespace bcos::storage;
 using namespace bcos::protocol;
@@ -41,10 +43,160 @@ using namespace std;
 #define STORAGE_ROCKSDB_LOG(LEVEL) BCOS_LOG(LEVEL) << "[STORAGE-RocksDB]"
 
 RocksDBStorage::RocksDBStorage(std::unique_ptr<rocksdb::DB>&& db,
-    const bcos::security::DataEncryptInterface::Ptr dataEncryption)
-  : m_db(std::move(db)), m_dataEncryption(dataEncryption)
+    const bcos::security::DataEncryptInterface::Ptr dataEncryption,
+    std::vector<rocksdb::ColumnFamilyHandle*> columnFamilies,
+    ValueCompressor::Ptr valueCompressor)
+  : m_db(std::move(db)),
+    m_columnFamilies(std::move(columnFamilies)),
+    m_dataEncryption(dataEncryption),
+    m_valueCompressor(std::move(valueCompressor))
 {
-    m_writeBatch = std::make_shared<WriteBatch>();
+    for (auto handle : m_columnFamilies)
+    {
+        if (handle->GetName() == LEDGER_COLUMN_FAMILY)
+        {
+            m_ledgerColumnFamily = handle;
+        }
+        else if (handle->GetName() == STATE_COLUMN_FAMILY)
+        {
+            m_stateColumnFamily = handle;
+        }
+    }
+    initValueFormat();
+}
+
+void RocksDBStorage::initValueFormat()
+{
+    std::string format;
+    auto status =
+        m_db->Get(ReadOptions(), m_db->DefaultColumnFamily(), Slice(VALUE_FORMAT_KEY), &format);
+    if (status.ok())
+    {
+        // the values have the format byte, even if the compression is disabled now
+        if (!m_valueCompressor)
+        {
+            m_valueCompressor = std::make_shared<ValueCompressor>(0);
+        }
+        return;
+    }
+    if (!status.IsNotFound())
+    {
+        BOOST_THROW_EXCEPTION(
+            BCOS_ERROR(ReadError, "Read the value format failed! " + status.ToString()));
+    }
+    if (!m_valueCompressor)
+    {
+        return;
+    }
+    // the raw values written before can't be told from the values with the format byte
+    std::vector<ColumnFamilyHandle*> handles{m_db->DefaultColumnFamily()};
+    for (auto handle : {m_ledgerColumnFamily, m_stateColumnFamily})
+    {
+        if (handle)
+        {
+            handles.push_back(handle);
+        }
+    }
+    ReadOptions readOptions;
+    readOptions.total_order_seek = true;
+    for (auto handle : handles)
+    {
+        std::unique_ptr<Iterator> iter(m_db->NewIterator(readOptions, handle));
+        iter->SeekToFirst();
+        // skip the markers of the default column family
+        while (iter->Valid() && !iter->key().empty() && iter->key()[0] == '#')
+        {
+            iter->Next();
+        }
+        if (iter->Valid())
+        {
+            STORAGE_ROCKSDB_LOG(WARNING)
+                << LOG_DESC("the compression is disabled, the db is created without it");
+            m_valueCompressor = nullptr;
+            return;
+        }
+    }
+    status = m_db->Put(WriteOptions(), m_db->DefaultColumnFamily(), Slice(VALUE_FORMAT_KEY),
+        Slice(VALUE_FORMAT_VERSION));
+    if (!status.ok())
+    {
+        BOOST_THROW_EXCEPTION(
+            BCOS_ERROR(WriteError, "Write the value format failed! " + status.ToString()));
+    }
+}
+
+RocksDBStorage::~RocksDBStorage()
+{
+    // the handles must be destroyed before the db is closed
+    for (auto handle : m_columnFamilies)
+    {
+        m_db->DestroyColumnFamilyHandle(handle);
+    }
+}
+
+rocksdb::ColumnFamilyHandle* RocksDBStorage::columnFamily(std::string_view table) const
+{
+    switch (tableClass(table))
+    {
+    case TableClass::Ledger:
+        return m_ledgerColumnFamily ? m_ledgerColumnFamily : m_db->DefaultColumnFamily();
+    case TableClass::State:
+        return m_stateColumnFamily ? m_stateColumnFamily : m_db->DefaultColumnFamily();
+    default:
+        return m_db->DefaultColumnFamily();
+    }
+}
+
+void RocksDBStorage::appendWriteBatch(WriteBatch& target, const WriteBatch& source) const
+{
+    // the batches only contain puts and deletes, replay them with the handles of the column
+    // families
+    struct Appender : public WriteBatch::Handler
+    {
+        Appender(WriteBatch& _target, std::vector<ColumnFamilyHandle*> const& _handles)
+          : target(_target), handles(_handles)
+        {}
+        Status PutCF(uint32_t columnFamilyID, const Slice& key, const Slice& value) override
+        {
+            auto handle = columnFamily(columnFamilyID);
+            return handle ? target.Put(handle, key, value) :
+                            Status::InvalidArgument("unknown column family");
+        }
+        Status DeleteCF(uint32_t columnFamilyID, const Slice& key) override
+        {
+            auto handle = columnFamily(columnFamilyID);
+            return handle ? target.Delete(handle, key) :
+                            Status::InvalidArgument("unknown column family");
+        }
+        ColumnFamilyHandle* columnFamily(uint32_t columnFamilyID) const
+        {
+            for (auto handle : handles)
+            {
+                if (handle->GetID() == columnFamilyID)
+                {
+                    return handle;
+                }
+            }
+            return nullptr;
+        }
+        WriteBatch& target;
+        std::vector<ColumnFamilyHandle*> const& handles;
+    };
+    std::vector<ColumnFamilyHandle*> handles{m_db->DefaultColumnFamily()};
+    for (auto handle : {m_ledgerColumnFamily, m_stateColumnFamily})
+    {
+        if (handle)
+        {
+            handles.push_back(handle);
+        }
+    }
+    Appender appender(target, handles);
+    auto status = source.Iterate(&appender);
+    if (!status.ok())
+    {
+        BOOST_THROW_EXCEPTION(
+            BCOS_ERROR(WriteError, "Append write batch failed! " + status.ToString()));
+    }
 }
 
 void RocksDBStorage::asyncGetPrimaryKeys(std::string_view _table,
@@ -58,8 +210,9 @@ void RocksDBStorage::asyncGetPrimaryKeys(std::string_view _table,
     keyPrefix = string(_table) + TABLE_KEY_SPLIT;
 
     ReadOptions read_options;
-    read_options.total_order_seek = true;
-    auto iter = m_db->NewIterator(read_options);
+    // the table name is the prefix, the sst files without the table are skipped by prefix bloom
+    read_options.prefix_same_as_start = true;
+    auto iter = m_db->NewIterator(read_options, columnFamily(_table));
 
     // FIXME: check performance and add limit of primary keys
     for (iter->Seek(keyPrefix); iter->Valid() && iter->key().starts_with(keyPrefix); iter->Next())
@@ -81,6 +234,49 @@ void RocksDBStorage::asyncGetPrimaryKeys(std::string_view _table,
                                << LOG_KV("callback time(ms)", utcTime() - end);
 }
 
+void RocksDBStorage::asyncGetPrimaryKeyPage(std::string_view _table,
+    const std::optional<Condition const>& _condition, std::string_view _cursor, size_t _limit,
+    std::function<void(Error::UniquePtr, std::vector<std::string>)> _callback)
+{
+    auto start = utcTime();
+    std::vector<std::string> result;
+
+    std::string keyPrefix = string(_table) + TABLE_KEY_SPLIT;
+    ReadOptions read_options;
+    read_options.prefix_same_as_start = true;
+    std::unique_ptr<Iterator> iter(m_db->NewIterator(read_options, columnFamily(_table)));
+    // seek to the cursor instead of the first key of the table
+    for (iter->Seek(keyPrefix + std::string(_cursor));
+         result.size() < _limit && iter->Valid() && iter->key().starts_with(keyPrefix);
+         iter->Next())
+    {
+        auto key = std::string_view(
+            iter->key().data() + keyPrefix.size(), iter->key().size() - keyPrefix.size());
+        if (key <= _cursor)
+        {
+            continue;
+        }
+        if (!_condition || _condition->isValid(key))
+        {
+            result.emplace_back(key);
+        }
+    }
+    if (!iter->status().ok())
+    {
+        _callback(BCOS_ERROR_UNIQUE_PTR(ReadError, "RocksDB iterate failed! " +
+                                                       iter->status().ToString()),
+            {});
+        return;
+    }
+    iter.reset();
+    auto end = utcTime();
+    STORAGE_ROCKSDB_LOG(TRACE) << LOG_DESC("asyncGetPrimaryKeyPage") << LOG_KV("table", _table)
+                               << LOG_KV("cursor", toHex(_cursor)) << LOG_KV("limit", _limit)
+                               << LOG_KV("count", result.size())
+                               << LOG_KV("read time(ms)", end - start);
+    _callback(nullptr, std::move(result));
+}
+
 void RocksDBStorage::asyncGetRow(std::string_view _table, std::string_view _key,
     std::function<void(Error::UniquePtr, std::optional<Entry>)> _callback)
 {
@@ -98,10 +294,12 @@ void RocksDBStorage::asyncGetRow(std::string_view _table, std::string_view _key,
         auto dbKey = toDBKey(_table, _key);
 
         auto status = m_db->Get(
-            ReadOptions(), m_db->DefaultColumnFamily(), Slice(dbKey.data(), dbKey.size()), &value);
+            ReadOptions(), columnFamily(_table), Slice(dbKey.data(), dbKey.size()), &value);
 
         if (false == value.empty() && nullptr != m_dataEncryption)
             value = m_dataEncryption->decrypt(value);
+        if (status.ok() && nullptr != m_valueCompressor)
+            m_valueCompressor->decompress(value);
 
         if (!status.ok())
         {
@@ -179,9 +377,10 @@ void RocksDBStorage::asyncGetRows(std::string_view _table,
 
                 std::vector<PinnableSlice> values(keys.size());
                 std::vector<Status> statusList(keys.size());
-                m_db->MultiGet(ReadOptions(), m_db->DefaultColumnFamily(), slices.size(),
+                m_db->MultiGet(ReadOptions(), columnFamily(_table), slices.size(),
                     slices.data(), values.data(), statusList.data());
                 auto end = utcTime();
+                std::vector<std::string> rawValues(keys.size());
                 tbb::parallel_for(tbb::blocked_range<size_t>(0, keys.size()),
                     [&](const tbb::blocked_range<size_t>& range) {
                         for (size_t i = range.begin(); i != range.end(); ++i)
@@ -192,14 +391,7 @@ void RocksDBStorage::asyncGetRows(std::string_view _table,
                             if (status.ok())
                             {
                                 entries[i] = std::make_optional(Entry());
-
-                                std::string v(value.data(), value.size());
-
-                                // Storage Security
-                                if (false == v.empty() && nullptr != m_dataEncryption)
-                                    v = m_dataEncryption->decrypt(v);
-
-                                entries[i]->set(std::move(v));
+                                rawValues[i].assign(value.data(), value.size());
                             }
                             else
                             {
@@ -220,6 +412,26 @@ void RocksDBStorage::asyncGetRows(std::string_view _table,
                             }
                         }
                     });
+                // Storage Security
+                if (nullptr != m_dataEncryption)
+                {
+                    m_dataEncryption->decryptBatch(rawValues);
+                }
+                tbb::parallel_for(tbb::blocked_range<size_t>(0, keys.size()),
+                    [&](const tbb::blocked_range<size_t>& range) {
+                        for (size_t i = range.begin(); i != range.end(); ++i)
+                        {
+                            if (!entries[i])
+                            {
+                                continue;
+                            }
+                            if (nullptr != m_valueCompressor)
+                            {
+                                m_valueCompressor->decompress(rawValues[i]);
+                            }
+                            entries[i]->set(std::move(rawValues[i]));
+                        }
+                    });
                 auto decode = utcTime();
                 _callback(nullptr, std::move(entries));
                 STORAGE_ROCKSDB_LOG(TRACE)
@@ -256,7 +468,7 @@ void RocksDBStorage::asyncSetRow(std::string_view _table, std::string_view _key,
             STORAGE_ROCKSDB_LOG(TRACE)
                 << LOG_DESC("asyncSetRow delete") << LOG_KV("table", _table)
                 << LOG_KV("key", boost::algorithm::hex_lower(std::string(_key)));
-            status = m_db->Delete(options, dbKey);
+            status = m_db->Delete(options, columnFamily(_table), dbKey);
         }
         else
         {
@@ -266,11 +478,13 @@ void RocksDBStorage::asyncSetRow(std::string_view _table, std::string_view _key,
 
             std::string value(_entry.get().data(), _entry.get().size());
 
+            if (nullptr != m_valueCompressor)
+                m_valueCompressor->compress(_table, value);
             // Storage Security
             if (false == value.empty() && nullptr != m_dataEncryption)
                 value = m_dataEncryption->encrypt(value);
 
-            status = m_db->Put(options, dbKey, std::move(value));
+            status = m_db->Put(options, columnFamily(_table), dbKey, std::move(value));
         }
 
         if (!status.ok())
@@ -295,17 +509,33 @@ void RocksDBStorage::asyncSetRow(std::string_view _table, std::string_view _key,
 void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorageInterface& storage,
     std::function<void(Error::Ptr, uint64_t startTS)> callback)
 {
-    std::ignore = param;
     try
     {
         auto start = utcTime();
-        {
-            tbb::spin_mutex::scoped_lock lock(m_writeBatchMutex);
-            if (!m_writeBatch)
+        auto writeBatch = std::make_shared<WriteBatch>();
+        tbb::spin_mutex writeBatchMutex;
+        // the rows are collected first if the values are encrypted, so the values can be
+        // encrypted in one batch, the value of the deleted row is std::nullopt
+        tbb::concurrent_vector<
+            std::tuple<ColumnFamilyHandle*, std::string, std::optional<std::string>>>
+            rows;
+        auto write = [&](ColumnFamilyHandle* handle, std::string dbKey,
+                         std::optional<std::string> value) {
+            if (nullptr != m_dataEncryption)
             {
-                m_writeBatch = std::make_shared<WriteBatch>();
+                rows.emplace_back(handle, std::move(dbKey), std::move(value));
+                return;
             }
-        }
+            tbb::spin_mutex::scoped_lock lock(writeBatchMutex);
+            if (value)
+            {
+                writeBatch->Put(handle, dbKey, *value);
+            }
+            else
+            {
+                writeBatch->Delete(handle, dbKey);
+            }
+        };
         atomic_bool isTableValid = true;
         storage.parallelTraverse(true,
             [&](const std::string_view& table, const std::string_view& key, Entry const& entry) {
@@ -323,8 +553,7 @@ void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorag
                         STORAGE_ROCKSDB_LOG(TRACE) << LOG_DESC("delete") << LOG_KV("table", table)
                                                    << LOG_KV("key", toHex(key));
                     }
-                    tbb::spin_mutex::scoped_lock lock(m_writeBatchMutex);
-                    m_writeBatch->Delete(dbKey);
+                    write(columnFamily(table), std::move(dbKey), std::nullopt);
                 }
                 else
                 {
@@ -334,27 +563,60 @@ void RocksDBStorage::asyncPrepare(const TwoPCParams& param, const TraverseStorag
                             << LOG_DESC("write") << LOG_KV("table", table)
                             << LOG_KV("key", toHex(key)) << LOG_KV("size", entry.size());
                     }
-                    tbb::spin_mutex::scoped_lock lock(m_writeBatchMutex);
-
                     std::string value(entry.get().data(), entry.get().size());
-
-                    // Storage security
-                    if (false == value.empty() && nullptr != m_dataEncryption)
-                        value = m_dataEncryption->encrypt(value);
-
-                    auto status = m_writeBatch->Put(dbKey, std::move(value));
+                    if (nullptr != m_valueCompressor)
+                    {
+                        m_valueCompressor->compress(table, value);
+                    }
+                    write(columnFamily(table), std::move(dbKey), std::move(value));
                 }
                 return true;
             });
         if (!isTableValid)
         {
-            {
-                tbb::spin_mutex::scoped_lock lock(m_writeBatchMutex);
-                m_writeBatch = nullptr;
-            }
             callback(BCOS_ERROR_UNIQUE_PTR(TableNotExists, "empty tableName or key"), 0);
             return;
         }
+        // Storage security
+        if (nullptr != m_dataEncryption)
+        {
+            std::vector<std::string> values(rows.size());
+            for (size_t i = 0; i < rows.size(); ++i)
+            {
+                if (auto& value = std::get<2>(rows[i]))
+                {
+                    values[i] = std::move(*value);
+                }
+            }
+            m_dataEncryption->encryptBatch(values);
+            for (size_t i = 0; i < rows.size(); ++i)
+            {
+                auto& [handle, dbKey, value] = rows[i];
+                if (value)
+                {
+                    writeBatch->Put(handle, dbKey, values[i]);
+                }
+                else
+                {
+                    writeBatch->Delete(handle, dbKey);
+                }
+            }
+        }
+        {
+            // the ledger data and the state of the block may be prepared by different callers
+            // sharing the storage, the batches of the same block are merged like the single
+            // pending batch before
+            std::lock_guard<std::mutex> lock(m_writeBatchesMutex);
+            auto it = m_writeBatches.find(param.number);
+            if (it == m_writeBatches.end())
+            {
+                m_writeBatches.emplace(param.number, std::move(writeBatch));
+            }
+            else
+            {
+                appendWriteBatch(*it->second, *writeBatch);
+            }
+        }
         auto end = utcTime();
         callback(nullptr, 0);
         STORAGE_ROCKSDB_LOG(INFO) << LOG_DESC("asyncPrepare") << LOG_KV("number", param.number)
@@ -373,37 +635,85 @@ void RocksDBStorage::asyncCommit(
 {
     size_t count = 0;
     auto start = utcTime();
-    std::ignore = params;
+    std::lock_guard<std::mutex> commitLock(m_commitMutex);
+    BlockNumber number = params.number;
+    std::shared_ptr<WriteBatch> writeBatch;
     {
-        tbb::spin_mutex::scoped_lock lock(m_writeBatchMutex);
-        if (m_writeBatch)
+        std::lock_guard<std::mutex> lock(m_writeBatchesMutex);
+        auto it = m_writeBatches.find(number);
+        if (it == m_writeBatches.end() && number == 0 && !m_writeBatches.empty())
         {
-            WriteOptions options;
-            options.sync = true;
-            count = m_writeBatch->Count();
-            m_db->Write(options, m_writeBatch.get());
-
-            m_writeBatch = nullptr;
+            // the caller without the block number commits the earliest prepared block
+            it = m_writeBatches.begin();
+            number = it->first;
+        }
+        if (it != m_writeBatches.end())
+        {
+            if (it != m_writeBatches.begin())
+            {
+                auto message = "Commit block " + std::to_string(number) +
+                               " before the prepared block " +
+                               std::to_string(m_writeBatches.begin()->first);
+                STORAGE_ROCKSDB_LOG(ERROR) << LOG_DESC("asyncCommit out of order")
+                                           << LOG_KV("number", number)
+                                           << LOG_KV("pending", m_writeBatches.begin()->first);
+                callback(BCOS_ERROR_UNIQUE_PTR(WriteError, std::move(message)), 0);
+                return;
+            }
+            // taken out, so the batch prepared for the block meanwhile is not appended to it
+            writeBatch = std::move(it->second);
+            m_writeBatches.erase(it);
+        }
+    }
+    if (writeBatch)
+    {
+        // write without the lock of the batches, so the next block can be prepared meanwhile
+        WriteOptions options;
+        options.sync = true;
+        count = writeBatch->Count();
+        auto status = m_db->Write(options, writeBatch.get());
+        if (!status.ok())
+        {
+            STORAGE_ROCKSDB_LOG(ERROR) << LOG_DESC("asyncCommit failed") << LOG_KV("number", number)
+                                       << LOG_KV("message", status.ToString());
+            {
+                // put the batch back for the retry
+                std::lock_guard<std::mutex> lock(m_writeBatchesMutex);
+                auto [it, inserted] = m_writeBatches.emplace(number, writeBatch);
+                if (!inserted)
+                {
+                    appendWriteBatch(*writeBatch, *it->second);
+                    it->second = std::move(writeBatch);
+                }
+            }
+            callback(BCOS_ERROR_UNIQUE_PTR(WriteError, "Commit failed! " + status.ToString()), 0);
+            return;
         }
     }
     auto end = utcTime();
     callback(nullptr, 0);
-    STORAGE_ROCKSDB_LOG(INFO) << LOG_DESC("asyncCommit") << LOG_KV("number", params.number)
+    STORAGE_ROCKSDB_LOG(INFO) << LOG_DESC("asyncCommit") << LOG_KV("number", number)
                               << LOG_KV("startTS", params.timestamp)
                               << LOG_KV("time(ms)", utcTime() - start)
                               << LOG_KV("callback time(ms)", utcTime() - end)
                               << LOG_KV("count", count);
+    if (m_valueCompressor)
+    {
+        m_valueCompressor->report();
+    }
 }
 
 void RocksDBStorage::asyncRollback(
     const TwoPCParams& params, std::function<void(Error::Ptr)> callback)
 {
     auto start = utcTime();
-
-    std::ignore = params;
     {
-        tbb::spin_mutex::scoped_lock lock(m_writeBatchMutex);
-        m_writeBatch = nullptr;
+        std::lock_guard<std::mutex> lock(m_writeBatchesMutex);
+        if (!m_writeBatches.erase(params.number) && params.number == 0)
+        {
+            // the caller without the block number discards all the prepared blocks
+            m_writeBatches.clear();
+        }
     }
     auto end = utcTime();
     callback(nullptr);
@@ -434,34 +744,119 @@ bcos::Error::Ptr RocksDBStorage::setRows(
         STORAGE_ROCKSDB_LOG(WARNING) << LOG_DESC("setRows empty keys") << LOG_KV("table", table);
         return nullptr;
     }
-    std::vector<std::string> realKeys(keys.size());
-    std::vector<std::string> encryptedValues;
-    encryptedValues.resize(values.size());
-    tbb::parallel_for(
-        tbb::blocked_range<size_t>(0, keys.size()), [&](const tbb::blocked_range<size_t>& range) {
-            for (size_t i = range.begin(); i != range.end(); ++i)
-            {
-                realKeys[i] = toDBKey(table, keys[i]);
-                if (m_dataEncryption)
+    try
+    {
+        std::vector<std::string> realKeys(keys.size());
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, keys.size()),
+            [&](const tbb::blocked_range<size_t>& range) {
+                for (size_t i = range.begin(); i != range.end(); ++i)
                 {
-                    encryptedValues[i] = m_dataEncryption->encrypt(values[i]);
+                    realKeys[i] = toDBKey(table, keys[i]);
+                    if (m_valueCompressor)
+                    {
+                        m_valueCompressor->compress(table, values[i]);
+                    }
                 }
-            }
-        });
-    auto writeBatch = WriteBatch();
-    for (size_t i = 0; i < values.size(); ++i)
-    {
+            });
         // Storage Security
         if (m_dataEncryption)
         {
-            writeBatch.Put(std::move(realKeys[i]), std::move(encryptedValues[i]));
+            m_dataEncryption->encryptBatch(values);
         }
-        else
+        auto writeBatch = WriteBatch();
+        auto handle = columnFamily(table);
+        for (size_t i = 0; i < values.size(); ++i)
         {
-            writeBatch.Put(std::move(realKeys[i]), std::move(values[i]));
+            writeBatch.Put(handle, std::move(realKeys[i]), std::move(values[i]));
+        }
+        WriteOptions options;
+        auto status = m_db->Write(options, &writeBatch);
+        if (!status.ok())
+        {
+            return BCOS_ERROR_PTR(WriteError, "setRows failed! " + status.ToString());
         }
     }
-    WriteOptions options;
-    m_db->Write(options, &writeBatch);
+    catch (const std::exception& e)
+    {
+        STORAGE_ROCKSDB_LOG(WARNING) << LOG_DESC("setRows failed") << LOG_KV("table", table)
+                                     << LOG_KV("message", e.what());
+        return BCOS_ERROR_WITH_PREV_PTR(WriteError, "setRows failed! ", e);
+    }
     return nullptr;
 }
+
+size_t RocksDBStorage::migrateColumnFamilies(size_t batchSize)
+{
+    if (!m_ledgerColumnFamily && !m_stateColumnFamily)
+    {
+        return 0;
+    }
+    std::string marker;
+    auto status = m_db->Get(ReadOptions(), m_db->DefaultColumnFamily(),
+        Slice(COLUMN_FAMILIES_MIGRATED_KEY), &marker);
+    if (status.ok())
+    {
+        return 0;
+    }
+    if (!status.IsNotFound())
+    {
+        BOOST_THROW_EXCEPTION(
+            BCOS_ERROR(ReadError, "Migrate column families failed! " + status.ToString()));
+    }
+    auto start = utcTime();
+    size_t count = 0;
+    WriteOptions options;
+    options.sync = true;
+    WriteBatch writeBatch;
+    auto flush = [&]() {
+        auto status = m_db->Write(options, &writeBatch);
+        if (!status.ok())
+        {
+            std::string errorMessage = "Migrate column families failed!";
+            if (status.getState())
+            {
+                errorMessage.append(" ").append(status.getState());
+            }
+            BOOST_THROW_EXCEPTION(BCOS_ERROR(WriteError, errorMessage));
+        }
+        writeBatch.Clear();
+    };
+
+    ReadOptions readOptions;
+    readOptions.total_order_seek = true;
+    std::unique_ptr<Iterator> iter(m_db->NewIterator(readOptions, m_db->DefaultColumnFamily()));
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next())
+    {
+        auto dbKey = std::string_view(iter->key().data(), iter->key().size());
+        auto table = dbKey.substr(0, dbKey.find(TABLE_KEY_SPLIT));
+        auto handle = columnFamily(table);
+        if (handle == m_db->DefaultColumnFamily())
+        {
+            continue;
+        }
+        // the value is moved as it is, the encrypted value needn't be decrypted
+        writeBatch.Put(handle, iter->key(), iter->value());
+        writeBatch.Delete(m_db->DefaultColumnFamily(), iter->key());
+        ++count;
+        if (writeBatch.Count() >= batchSize * 2)
+        {
+            flush();
+        }
+    }
+    if (!iter->status().ok())
+    {
+        BOOST_THROW_EXCEPTION(BCOS_ERROR(ReadError, "Migrate column families failed! " +
+                                                        iter->status().ToString()));
+    }
+    // the marker is written with the last moved rows, the next startup skips the scan
+    writeBatch.Put(m_db->DefaultColumnFamily(), Slice(COLUMN_FAMILIES_MIGRATED_KEY), Slice("1"));
+    flush();
+    if (count > 0)
+    {
+        // reclaim the space of the moved rows
+        m_db->CompactRange(CompactRangeOptions(), m_db->DefaultColumnFamily(), nullptr, nullptr);
+    }
+    STORAGE_ROCKSDB_LOG(INFO) << LOG_DESC("migrateColumnFamilies") << LOG_KV("count", count)
+                              << LOG_KV("time(ms)", utcTime() - start);
+    return count;
+}
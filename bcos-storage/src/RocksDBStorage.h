@@ -23,10 +23,13 @@
  */
 #pragma once
 
+#include "ValueCompressor.h"
 #include <bcos-framework/interfaces/storage/StorageInterface.h>
 #include <bcos-security/bcos-security/DataEncryption.h>
 #include <rocksdb/db.h>
 #include <tbb/parallel_for.h>
+#include <map>
+#include <mutex>
 
 namespace rocksdb
 {
@@ -39,15 +42,25 @@ class RocksDBStorage : public TransactionalStorageInterface
 {
 public:
     using Ptr = std::shared_ptr<RocksDBStorage>;
+    // the storage takes the ownership of the column families, the rows of all tables are stored
+    // in the default column family if the ledger and state column families are not provided,
+    // the values are not compressed if the value compressor is not provided or the db is created
+    // without it
     explicit RocksDBStorage(std::unique_ptr<rocksdb::DB>&& db,
-        const bcos::security::DataEncryptInterface::Ptr dataEncryption);
+        const bcos::security::DataEncryptInterface::Ptr dataEncryption,
+        std::vector<rocksdb::ColumnFamilyHandle*> columnFamilies = {},
+        ValueCompressor::Ptr valueCompressor = nullptr);
 
-    ~RocksDBStorage() {}
+    ~RocksDBStorage();
 
     void asyncGetPrimaryKeys(std::string_view _table,
         const std::optional<Condition const>& _condition,
         std::function<void(Error::UniquePtr, std::vector<std::string>)> _callback) override;
 
+    void asyncGetPrimaryKeyPage(std::string_view _table,
+        const std::optional<Condition const>& _condition, std::string_view _cursor, size_t _limit,
+        std::function<void(Error::UniquePtr, std::vector<std::string>)> _callback) override;
+
     void asyncGetRow(std::string_view table, std::string_view _key,
         std::function<void(Error::UniquePtr, std::optional<Entry>)> _callback) override;
 
@@ -72,12 +85,32 @@ public:
     Error::Ptr setRows(std::string_view table, std::vector<std::string> keys,
         std::vector<std::string> values) noexcept override;
 
+    // move the rows of the ledger and state tables written before the column families are
+    // divided out of the default column family, return the number of the moved rows
+    size_t migrateColumnFamilies(size_t batchSize = 10000);
+
 private:
-    std::shared_ptr<rocksdb::WriteBatch> m_writeBatch = nullptr;
-    tbb::spin_mutex m_writeBatchMutex;
+    rocksdb::ColumnFamilyHandle* columnFamily(std::string_view table) const;
+    // the values of the db marked when it is created with the compression have the format byte,
+    // the compression is disabled for the db created without it
+    void initValueFormat();
+    // append the puts and deletes of the source batch to the target batch
+    void appendWriteBatch(rocksdb::WriteBatch& target, const rocksdb::WriteBatch& source) const;
+
+    // the prepared write batches of the blocks not committed, keyed by the block number, so the
+    // next block can be prepared while the previous one is being written
+    std::map<bcos::protocol::BlockNumber, std::shared_ptr<rocksdb::WriteBatch>> m_writeBatches;
+    std::mutex m_writeBatchesMutex;
+    // serialize the commits, the blocks must be committed in the order of the block number
+    std::mutex m_commitMutex;
     std::unique_ptr<rocksdb::DB> m_db;
+    std::vector<rocksdb::ColumnFamilyHandle*> m_columnFamilies;
+    rocksdb::ColumnFamilyHandle* m_ledgerColumnFamily = nullptr;
+    rocksdb::ColumnFamilyHandle* m_stateColumnFamily = nullptr;
 
     // Security Storage
     bcos::security::DataEncryptInterface::Ptr m_dataEncryption{nullptr};
+    // compress before encrypt, and decompress after decrypt
+    ValueCompressor::Ptr m_valueCompressor{nullptr};
 };
 }  // namespace bcos::storage
@@ -103,6 +103,44 @@ void TiKVStorage::asyncGetPrimaryKeys(std::string_view _table,
     _callback(nullptr, std::move(result));
 }
 
+void TiKVStorage::asyncGetPrimaryKeyPage(std::string_view _table,
+    const std::optional<Condition const>& _condition, std::string_view _cursor, size_t _limit,
+    std::function<void(Error::UniquePtr, std::vector<std::string>)> _callback) noexcept
+{
+    try
+    {
+        auto start = utcTime();
+        std::vector<std::string> result;
+
+        std::string keyPrefix = string(_table) + TABLE_KEY_SPLIT;
+        auto snap = Snapshot(m_cluster.get());
+        // scan from the cursor instead of the first key of the table
+        auto scanner = snap.Scan(keyPrefix + std::string(_cursor), string());
+        for (; result.size() < _limit && scanner.valid && scanner.key().rfind(keyPrefix, 0) == 0;
+             scanner.next())
+        {
+            auto key = scanner.key().substr(keyPrefix.size());
+            if (key <= _cursor)
+            {
+                continue;
+            }
+            if (!_condition || _condition->isValid(key))
+            {  // filter by condition, remove keyPrefix
+                result.push_back(std::move(key));
+            }
+        }
+        auto end = utcTime();
+        STORAGE_TIKV_LOG(DEBUG) << LOG_DESC("asyncGetPrimaryKeyPage") << LOG_KV("table", _table)
+                                << LOG_KV("limit", _limit) << LOG_KV("count", result.size())
+                                << LOG_KV("read time(ms)", end - start);
+        _callback(nullptr, std::move(result));
+    }
+    catch (const std::exception& e)
+    {
+        _callback(BCOS_ERROR_WITH_PREV_UNIQUE_PTR(ReadError, "Get primary keys failed!", e), {});
+    }
+}
+
 void TiKVStorage::asyncGetRow(std::string_view _table, std::string_view _key,
     std::function<void(Error::UniquePtr, std::optional<Entry>)> _callback) noexcept
 {
@@ -56,6 +56,11 @@ public:
         std::function<void(Error::UniquePtr, std::vector<std::string>)> _callback) noexcept
         override;
 
+    void asyncGetPrimaryKeyPage(std::string_view _table,
+        const std::optional<Condition const>& _condition, std::string_view _cursor, size_t _limit,
+        std::function<void(Error::UniquePtr, std::vector<std::string>)> _callback) noexcept
+        override;
+
     void asyncGetRow(std::string_view table, std::string_view _key,
         std::function<void(Error::UniquePtr, std::optional<Entry>)> _callback) noexcept override;
 
@@ -0,0 +1,203 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief compress the large values written to the storage
+ * @file ValueCompressor.cpp
+ * @date: 2022-07-18
+ */
+
+#include "ValueCompressor.h"
+#include <bcos-utilities/BoostLog.h>
+#include <bcos-utilities/Error.h>
+#include <zstd.h>
+#include <chrono>
+#include <cstring>
+
+using namespace bcos::storage;
+
+#define STORAGE_COMPRESS_LOG(LEVEL) BCOS_LOG(LEVEL) << "[STORAGE-Compress]"
+
+namespace
+{
+// the format byte of every value
+const char c_rawValue = 0;
+const char c_zstdValue = 1;
+
+// the contexts are reused by the thread, creating them for every value is expensive
+struct ZstdContexts
+{
+    ZstdContexts() : cctx(ZSTD_createCCtx()), dctx(ZSTD_createDCtx()) {}
+    ~ZstdContexts()
+    {
+        ZSTD_freeCCtx(cctx);
+        ZSTD_freeDCtx(dctx);
+    }
+    ZSTD_CCtx* cctx;
+    ZSTD_DCtx* dctx;
+};
+
+ZstdContexts& zstdContexts()
+{
+    thread_local ZstdContexts contexts;
+    return contexts;
+}
+
+uint64_t elapsed(std::chrono::steady_clock::time_point _start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - _start)
+        .count();
+}
+}  // namespace
+
+ValueCompressor::ValueCompressor(size_t _threshold, int _level) : m_level(_level)
+{
+    m_classThresholds[(size_t)TableClass::System] = _threshold;
+    m_classThresholds[(size_t)TableClass::Ledger] = 0;
+    m_classThresholds[(size_t)TableClass::State] = _threshold;
+}
+
+void ValueCompressor::setThreshold(TableClass _tableClass, size_t _threshold)
+{
+    m_classThresholds[(size_t)_tableClass] = _threshold;
+}
+
+void ValueCompressor::setThreshold(std::string_view _table, size_t _threshold)
+{
+    m_tableThresholds[std::string(_table)] = _threshold;
+}
+
+size_t ValueCompressor::threshold(std::string_view _table) const
+{
+    if (!m_tableThresholds.empty())
+    {
+        auto it = m_tableThresholds.find(_table);
+        if (it != m_tableThresholds.end())
+        {
+            return it->second;
+        }
+    }
+    return m_classThresholds[(size_t)tableClass(_table)];
+}
+
+bool ValueCompressor::isCompressed(std::string_view _value)
+{
+    return !_value.empty() && _value[0] == c_zstdValue;
+}
+
+void ValueCompressor::compress(std::string_view _table, std::string& _value)
+{
+    auto tableThreshold = threshold(_table);
+    if (tableThreshold == 0 || _value.size() < tableThreshold)
+    {
+        _value.insert(_value.begin(), c_rawValue);
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::string compressed(ZSTD_compressBound(_value.size()) + 1, '\0');
+    compressed[0] = c_zstdValue;
+    auto size = ZSTD_compressCCtx(zstdContexts().cctx, compressed.data() + 1,
+        compressed.size() - 1, _value.data(), _value.size(), m_level);
+    if (ZSTD_isError(size))
+    {
+        BOOST_THROW_EXCEPTION(BCOS_ERROR(
+            WriteError, std::string("Compress value failed! ") + ZSTD_getErrorName(size)));
+    }
+    if (size >= _value.size())
+    {
+        _value.insert(_value.begin(), c_rawValue);
+        return;
+    }
+    compressed.resize(size + 1);
+    m_compressedValues.fetch_add(1);
+    m_rawBytes.fetch_add(_value.size());
+    m_compressedBytes.fetch_add(size);
+    _value.swap(compressed);
+    m_compressTime.fetch_add(elapsed(start));
+}
+
+void ValueCompressor::decompress(std::string& _value)
+{
+    if (_value.empty())
+    {
+        BOOST_THROW_EXCEPTION(BCOS_ERROR(ReadError, "Decompress value failed! no format byte"));
+    }
+    if (_value[0] == c_rawValue)
+    {
+        _value.erase(0, 1);
+        return;
+    }
+    if (_value[0] != c_zstdValue)
+    {
+        BOOST_THROW_EXCEPTION(BCOS_ERROR(
+            ReadError, "Decompress value failed! unknown format " + std::to_string(_value[0])));
+    }
+    auto start = std::chrono::steady_clock::now();
+    auto frame = _value.data() + 1;
+    auto frameSize = _value.size() - 1;
+    auto rawSize = ZSTD_getFrameContentSize(frame, frameSize);
+    if (rawSize == ZSTD_CONTENTSIZE_ERROR || rawSize == ZSTD_CONTENTSIZE_UNKNOWN)
+    {
+        BOOST_THROW_EXCEPTION(BCOS_ERROR(ReadError, "Decompress value failed! invalid frame"));
+    }
+    std::string decompressed(rawSize, '\0');
+    auto size = ZSTD_decompressDCtx(
+        zstdContexts().dctx, decompressed.data(), decompressed.size(), frame, frameSize);
+    if (ZSTD_isError(size))
+    {
+        BOOST_THROW_EXCEPTION(BCOS_ERROR(
+            ReadError, std::string("Decompress value failed! ") + ZSTD_getErrorName(size)));
+    }
+    decompressed.resize(size);
+    m_decompressedValues.fetch_add(1);
+    m_decompressedBytes.fetch_add(size);
+    _value.swap(decompressed);
+    m_decompressTime.fetch_add(elapsed(start));
+}
+
+ValueCompressor::Statistics ValueCompressor::statistics() const
+{
+    Statistics statistics;
+    statistics.compressedValues = m_compressedValues;
+    statistics.rawBytes = m_rawBytes;
+    statistics.compressedBytes = m_compressedBytes;
+    statistics.compressTime = m_compressTime;
+    statistics.decompressedValues = m_decompressedValues;
+    statistics.decompressedBytes = m_decompressedBytes;
+    statistics.decompressTime = m_decompressTime;
+    return statistics;
+}
+
+void ValueCompressor::report() const
+{
+    auto statistics = this->statistics();
+    // bytes per microsecond is MB per second
+    auto throughput = [](uint64_t _bytes, uint64_t _time) {
+        return _time == 0 ? 0 : (double)_bytes / _time;
+    };
+    auto ratio = statistics.rawBytes == 0 ?
+                     1.0 :
+                     (double)statistics.compressedBytes / statistics.rawBytes;
+    STORAGE_COMPRESS_LOG(INFO)
+        << METRIC << LOG_DESC("valueCompression")
+        << LOG_KV("compressedValues", statistics.compressedValues)
+        << LOG_KV("rawBytes", statistics.rawBytes)
+        << LOG_KV("compressedBytes", statistics.compressedBytes)
+        << LOG_KV("ratio", ratio)
+        << LOG_KV("compress(MB/s)", throughput(statistics.rawBytes, statistics.compressTime))
+        << LOG_KV("decompressedValues", statistics.decompressedValues)
+        << LOG_KV("decompress(MB/s)",
+               throughput(statistics.decompressedBytes, statistics.decompressTime));
+}
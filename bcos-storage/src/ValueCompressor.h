@@ -0,0 +1,89 @@
+/*
+ *  Copyright (C) 2022 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief compress the large values written to the storage
+ * @file ValueCompressor.h
+ * @date: 2022-07-18
+ */
+
+#pragma once
+
+#include "Common.h"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace bcos::storage
+{
+/**
+ * compress the values not smaller than the threshold of the table by zstd. Every value written
+ * starts with a format byte telling whether the rest is raw or a zstd frame, so the compression can
+ * be disabled later. The format byte is only used by the db marked with VALUE_FORMAT_KEY when it is
+ * created, the values of the db created without the compression have no format byte.
+ */
+class ValueCompressor
+{
+public:
+    using Ptr = std::shared_ptr<ValueCompressor>;
+    struct Statistics
+    {
+        uint64_t compressedValues = 0;
+        // the size of the compressed values before and after the compression
+        uint64_t rawBytes = 0;
+        uint64_t compressedBytes = 0;
+        uint64_t compressTime = 0;
+        uint64_t decompressedValues = 0;
+        uint64_t decompressedBytes = 0;
+        uint64_t decompressTime = 0;
+    };
+
+    // the ledger tables are compressed by the column family, not compressed by default
+    explicit ValueCompressor(size_t _threshold = 1024, int _level = 3);
+    ~ValueCompressor() = default;
+
+    // 0 means not compress the values of the table
+    // Note: the thresholds should be set before the compressor is used, they are not thread safe
+    void setThreshold(TableClass _tableClass, size_t _threshold);
+    void setThreshold(std::string_view _table, size_t _threshold);
+    size_t threshold(std::string_view _table) const;
+
+    // compress the value in place if it is large enough and becomes smaller, and prepend the format
+    // byte, throw if the compression fails
+    void compress(std::string_view _table, std::string& _value);
+    // decompress the value in place if it is compressed, and remove the format byte, throw if the
+    // value is invalid
+    void decompress(std::string& _value);
+    static bool isCompressed(std::string_view _value);
+
+    // the time in microseconds
+    Statistics statistics() const;
+    void report() const;
+
+private:
+    int m_level;
+    size_t m_classThresholds[3];
+    std::map<std::string, size_t, std::less<>> m_tableThresholds;
+
+    std::atomic<uint64_t> m_compressedValues = {0};
+    std::atomic<uint64_t> m_rawBytes = {0};
+    std::atomic<uint64_t> m_compressedBytes = {0};
+    std::atomic<uint64_t> m_compressTime = {0};
+    std::atomic<uint64_t> m_decompressedValues = {0};
+    std::atomic<uint64_t> m_decompressedBytes = {0};
+    std::atomic<uint64_t> m_decompressTime = {0};
+};
+}  // namespace bcos::storage
@@ -1,7 +1,10 @@
 #include "bcos-framework/interfaces/storage/StorageInterface.h"
+#include "bcos-storage/src/Common.h"
 #include "bcos-storage/src/RocksDBStorage.h"
+#include "bcos-storage/src/ValueCompressor.h"
 #include "bcos-table/src/StateStorage.h"
 #include "boost/filesystem.hpp"
+#include <bcos-crypto/encrypt/AESCrypto.h>
 #include <bcos-utilities/DataConvertUtility.h>
 #include <rocksdb/write_batch.h>
 #include <tbb/concurrent_vector.h>
@@ -50,6 +53,17 @@ public:
     // final the hashContext
     bcos::crypto::HashType final(void*) override { return bcos::crypto::HashType(); }
 };
+// the data encryption with a fixed data key instead of the one of the key center
+class FakeDataEncryption : public bcos::security::DataEncryption
+{
+public:
+    FakeDataEncryption() : DataEncryption(nullptr)
+    {
+        m_dataKey = std::string(32, 'k');
+        m_symmetricEncrypt = std::make_shared<bcos::crypto::AESCrypto>();
+    }
+};
+
 struct TestRocksDBStorageFixture
 {
     TestRocksDBStorageFixture()
@@ -381,6 +395,51 @@ BOOST_AUTO_TEST_CASE(asyncGetPrimaryKeys)
     cleanupTestTableData();
 }
 
+BOOST_AUTO_TEST_CASE(asyncGetPrimaryKeyPage)
+{
+    prepareTestTableData();
+    std::vector<std::string> sortedKeys;
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        sortedKeys.emplace_back("key" + boost::lexical_cast<std::string>(i));
+    }
+    std::sort(sortedKeys.begin(), sortedKeys.end());
+
+    std::vector<std::string> pagedKeys;
+    std::string cursor;
+    while (true)
+    {
+        std::vector<std::string> page;
+        rocksDBStorage->asyncGetPrimaryKeyPage(testTableName, std::nullopt, cursor, 300,
+            [&](Error::UniquePtr error, std::vector<std::string> keys) {
+                BOOST_CHECK_EQUAL(error.get(), nullptr);
+                page = std::move(keys);
+            });
+        BOOST_CHECK_LE(page.size(), 300);
+        pagedKeys.insert(pagedKeys.end(), page.begin(), page.end());
+        if (page.size() < 300)
+        {
+            break;
+        }
+        cursor = page.back();
+    }
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        sortedKeys.begin(), sortedKeys.end(), pagedKeys.begin(), pagedKeys.end());
+
+    Condition condition;
+    condition.NE("key100");
+    rocksDBStorage->asyncGetPrimaryKeyPage(testTableName, condition, "key1", 3,
+        [&](Error::UniquePtr error, std::vector<std::string> keys) {
+            BOOST_CHECK_EQUAL(error.get(), nullptr);
+            BOOST_REQUIRE_EQUAL(keys.size(), 3);
+            BOOST_CHECK_EQUAL(keys[0], "key10");
+            BOOST_CHECK_EQUAL(keys[1], "key101");
+            BOOST_CHECK_EQUAL(keys[2], "key102");
+        });
+
+    cleanupTestTableData();
+}
+
 BOOST_AUTO_TEST_CASE(asyncGetRows)
 {
     prepareTestTableData();
@@ -511,6 +570,99 @@ BOOST_AUTO_TEST_CASE(asyncPrepare)
     cleanupTestTableData();
 }
 
+BOOST_AUTO_TEST_CASE(pipelinedCommit)
+{
+    auto prepare = [&](bcos::protocol::BlockNumber number) {
+        auto state = std::make_shared<StateStorage>(rocksDBStorage);
+        Entry entry(testTableInfo);
+        entry.importFields({"value_" + boost::lexical_cast<std::string>(number)});
+        state->asyncSetRow(testTableName, "key_" + boost::lexical_cast<std::string>(number),
+            std::move(entry), [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+        bcos::protocol::TwoPCParams params;
+        params.number = number;
+        rocksDBStorage->asyncPrepare(
+            params, *state, [](Error::Ptr error, uint64_t) { BOOST_CHECK(!error); });
+        return params;
+    };
+    auto exists = [&](bcos::protocol::BlockNumber number) {
+        bool found = false;
+        auto key = "key_" + boost::lexical_cast<std::string>(number);
+        rocksDBStorage->asyncGetRow(testTableName, key,
+            [&found](Error::UniquePtr error, std::optional<Entry> entry) {
+                BOOST_CHECK(!error);
+                found = entry.has_value();
+            });
+        return found;
+    };
+
+    // the next block is prepared before the previous one committed
+    auto params1 = prepare(1);
+    auto params2 = prepare(2);
+    auto params3 = prepare(3);
+    BOOST_CHECK(!exists(1));
+
+    // the blocks must be committed in order
+    rocksDBStorage->asyncCommit(params2, [](Error::Ptr error, uint64_t) { BOOST_CHECK(error); });
+    BOOST_CHECK(!exists(2));
+
+    rocksDBStorage->asyncCommit(params1, [](Error::Ptr error, uint64_t) { BOOST_CHECK(!error); });
+    BOOST_CHECK(exists(1));
+    BOOST_CHECK(!exists(2));
+
+    // the rollback only discards the batch of the block
+    rocksDBStorage->asyncRollback(params3, [](Error::Ptr error) { BOOST_CHECK(!error); });
+    rocksDBStorage->asyncCommit(params2, [](Error::Ptr error, uint64_t) { BOOST_CHECK(!error); });
+    BOOST_CHECK(exists(2));
+    rocksDBStorage->asyncCommit(params3, [](Error::Ptr error, uint64_t) { BOOST_CHECK(!error); });
+    BOOST_CHECK(!exists(3));
+}
+
+BOOST_AUTO_TEST_CASE(pipelinedCommitSharedNumber)
+{
+    // the ledger data and the state of the block are prepared separately with the same storage
+    auto prepare = [&](bcos::protocol::BlockNumber number, std::string const& key) {
+        auto state = std::make_shared<StateStorage>(rocksDBStorage);
+        Entry entry(testTableInfo);
+        entry.importFields({key + "_value"});
+        state->asyncSetRow(testTableName, key, std::move(entry),
+            [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+        bcos::protocol::TwoPCParams params;
+        params.number = number;
+        rocksDBStorage->asyncPrepare(
+            params, *state, [](Error::Ptr error, uint64_t) { BOOST_CHECK(!error); });
+        return params;
+    };
+    auto get = [&](std::string const& key) {
+        std::optional<Entry> result;
+        rocksDBStorage->asyncGetRow(
+            testTableName, key, [&result](Error::UniquePtr error, std::optional<Entry> entry) {
+                BOOST_CHECK(!error);
+                result = std::move(entry);
+            });
+        return result;
+    };
+
+    auto params = prepare(1, "ledger_1");
+    prepare(1, "state_1");
+    prepare(2, "ledger_2");
+    BOOST_CHECK(!get("ledger_1"));
+    BOOST_CHECK(!get("state_1"));
+
+    rocksDBStorage->asyncCommit(params, [](Error::Ptr error, uint64_t) { BOOST_CHECK(!error); });
+    auto ledger = get("ledger_1");
+    BOOST_REQUIRE(ledger);
+    BOOST_CHECK_EQUAL(ledger->getField(0), "ledger_1_value");
+    auto state = get("state_1");
+    BOOST_REQUIRE(state);
+    BOOST_CHECK_EQUAL(state->getField(0), "state_1_value");
+    BOOST_CHECK(!get("ledger_2"));
+
+    // the batch of the next block is kept
+    params.number = 2;
+    rocksDBStorage->asyncCommit(params, [](Error::Ptr error, uint64_t) { BOOST_CHECK(!error); });
+    BOOST_CHECK(get("ledger_2"));
+}
+
 BOOST_AUTO_TEST_CASE(boostSerialize)
 {
     // encode the vector
@@ -594,6 +746,357 @@ BOOST_AUTO_TEST_CASE(rocksDBiter)
     }
 }
 
+BOOST_AUTO_TEST_CASE(columnFamilies)
+{
+    std::string testPath = "./columnFamiliesTest";
+    rocksdb::Options options;
+    options.create_if_missing = true;
+    options.create_missing_column_families = true;
+
+    // the db written before the column families are divided
+    rocksdb::DB* db;
+    rocksdb::Status s = rocksdb::DB::Open(options, testPath, &db);
+    BOOST_REQUIRE(s.ok());
+    std::vector<std::string> tables = {ledger::SYS_NUMBER_2_BLOCK_HEADER, ledger::SYS_CONFIG,
+        "/apps/test_table"};
+    for (auto& table : tables)
+    {
+        for (size_t i = 0; i < 100; ++i)
+        {
+            db->Put(rocksdb::WriteOptions(), toDBKey(table, boost::lexical_cast<std::string>(i)),
+                table + "_value");
+        }
+    }
+    delete db;
+
+    std::vector<rocksdb::ColumnFamilyDescriptor> columnFamilies{
+        {rocksdb::kDefaultColumnFamilyName, rocksdb::ColumnFamilyOptions(options)},
+        {LEDGER_COLUMN_FAMILY, rocksdb::ColumnFamilyOptions(options)},
+        {STATE_COLUMN_FAMILY, rocksdb::ColumnFamilyOptions(options)}};
+    std::vector<rocksdb::ColumnFamilyHandle*> handles;
+    s = rocksdb::DB::Open(options, testPath, columnFamilies, &handles, &db);
+    BOOST_REQUIRE(s.ok());
+    BOOST_REQUIRE_EQUAL(handles.size(), 3);
+    auto ledgerHandle = handles[1];
+    auto stateHandle = handles[2];
+    auto storage =
+        std::make_shared<RocksDBStorage>(std::unique_ptr<rocksdb::DB>(db), nullptr, handles);
+    BOOST_CHECK_EQUAL(storage->migrateColumnFamilies(7), 200);
+    BOOST_CHECK_EQUAL(storage->migrateColumnFamilies(), 0);
+
+    std::string value;
+    auto headerKey = toDBKey(ledger::SYS_NUMBER_2_BLOCK_HEADER, "1");
+    BOOST_CHECK(db->Get(rocksdb::ReadOptions(), ledgerHandle, headerKey, &value).ok());
+    BOOST_CHECK(db->Get(rocksdb::ReadOptions(), headerKey, &value).IsNotFound());
+    BOOST_CHECK(db->Get(rocksdb::ReadOptions(), COLUMN_FAMILIES_MIGRATED_KEY, &value).ok());
+
+    // the default column family is not scanned again once migrated
+    auto unmovedKey = toDBKey(ledger::SYS_NUMBER_2_BLOCK_HEADER, "unmoved");
+    BOOST_REQUIRE(db->Put(rocksdb::WriteOptions(), unmovedKey, "value").ok());
+    BOOST_CHECK_EQUAL(storage->migrateColumnFamilies(), 0);
+    BOOST_CHECK(db->Get(rocksdb::ReadOptions(), unmovedKey, &value).ok());
+    BOOST_REQUIRE(db->Delete(rocksdb::WriteOptions(), unmovedKey).ok());
+    auto stateKey = toDBKey("/apps/test_table", "1");
+    BOOST_CHECK(db->Get(rocksdb::ReadOptions(), stateHandle, stateKey, &value).ok());
+    auto configKey = toDBKey(ledger::SYS_CONFIG, "1");
+    BOOST_CHECK(db->Get(rocksdb::ReadOptions(), configKey, &value).ok());
+
+    for (auto& table : tables)
+    {
+        storage->asyncGetPrimaryKeys(table, std::optional<storage::Condition const>(),
+            [](Error::UniquePtr error, std::vector<std::string> keys) {
+                BOOST_CHECK(!error);
+                BOOST_CHECK_EQUAL(keys.size(), 100);
+            });
+        storage->asyncGetRow(table, "99", [&](Error::UniquePtr error, std::optional<Entry> entry) {
+            BOOST_CHECK(!error);
+            BOOST_REQUIRE(entry);
+            BOOST_CHECK_EQUAL(entry->get(), table + "_value");
+        });
+    }
+
+    // the new rows are written to the column family of the table
+    auto state = std::make_shared<StateStorage>(storage);
+    Entry entry;
+    entry.set("new_value");
+    state->asyncSetRow(ledger::SYS_NUMBER_2_BLOCK_HEADER, "100", std::move(entry),
+        [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+    bcos::protocol::TwoPCParams params;
+    params.number = 100;
+    storage->asyncPrepare(params, *state, [](Error::Ptr error, uint64_t) { BOOST_CHECK(!error); });
+    storage->asyncCommit(params, [](Error::Ptr error, uint64_t) { BOOST_CHECK(!error); });
+    headerKey = toDBKey(ledger::SYS_NUMBER_2_BLOCK_HEADER, "100");
+    BOOST_CHECK(db->Get(rocksdb::ReadOptions(), ledgerHandle, headerKey, &value).ok());
+    BOOST_CHECK_EQUAL(value, "new_value");
+
+    storage.reset();
+    if (boost::filesystem::exists(testPath))
+    {
+        boost::filesystem::remove_all(testPath);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(valueCompression)
+{
+    std::string testPath = "./valueCompressionTest";
+    rocksdb::Options options;
+    options.create_if_missing = true;
+    rocksdb::DB* db;
+    rocksdb::Status s = rocksdb::DB::Open(options, testPath, &db);
+    BOOST_REQUIRE(s.ok());
+    auto compressor = std::make_shared<ValueCompressor>(64);
+    compressor->setThreshold("/apps/raw_table", 0);
+    auto storage = std::make_shared<RocksDBStorage>(
+        std::unique_ptr<rocksdb::DB>(db), nullptr, std::vector<rocksdb::ColumnFamilyHandle*>{},
+        compressor);
+
+    std::string largeValue(1024, 'a');
+    std::string smallValue = "small";
+    // the raw value looks like a zstd frame
+    std::string magicValue("\x28\xB5\x2F\xFDvalue", 9);
+    auto state = std::make_shared<StateStorage>(storage);
+    std::vector<std::pair<std::string, std::string>> rows = {{"/apps/test_table", largeValue},
+        {"/apps/test_table", smallValue}, {"/apps/test_table", magicValue},
+        {"/apps/raw_table", largeValue}};
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+        Entry entry;
+        entry.set(rows[i].second);
+        state->asyncSetRow(rows[i].first, boost::lexical_cast<std::string>(i), std::move(entry),
+            [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+    }
+    bcos::protocol::TwoPCParams params;
+    params.number = 1;
+    storage->asyncPrepare(params, *state, [](Error::Ptr error, uint64_t) { BOOST_CHECK(!error); });
+    storage->asyncCommit(params, [](Error::Ptr error, uint64_t) { BOOST_CHECK(!error); });
+
+    std::string value;
+    BOOST_CHECK(db->Get(rocksdb::ReadOptions(), VALUE_FORMAT_KEY, &value).ok());
+    std::vector<bool> compressed = {true, false, false, false};
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+        auto key = boost::lexical_cast<std::string>(i);
+        BOOST_CHECK(db->Get(rocksdb::ReadOptions(), toDBKey(rows[i].first, key), &value).ok());
+        BOOST_CHECK_EQUAL(ValueCompressor::isCompressed(value), compressed[i]);
+        if (!compressed[i])
+        {
+            // the raw value with the format byte
+            BOOST_CHECK_EQUAL(value.substr(1), rows[i].second);
+        }
+
+        storage->asyncGetRow(
+            rows[i].first, key, [&](Error::UniquePtr error, std::optional<Entry> entry) {
+                BOOST_CHECK(!error);
+                BOOST_REQUIRE(entry);
+                BOOST_CHECK_EQUAL(entry->get(), rows[i].second);
+            });
+    }
+    std::vector<std::string> keys = {"0", "1", "2"};
+    storage->asyncGetRows("/apps/test_table", keys,
+        [&](Error::UniquePtr error, std::vector<std::optional<Entry>> entries) {
+            BOOST_CHECK(!error);
+            BOOST_REQUIRE_EQUAL(entries.size(), 3);
+            for (size_t i = 0; i < entries.size(); ++i)
+            {
+                BOOST_REQUIRE(entries[i]);
+                BOOST_CHECK_EQUAL(entries[i]->get(), rows[i].second);
+            }
+        });
+
+    auto statistics = compressor->statistics();
+    BOOST_CHECK_EQUAL(statistics.compressedValues, 1);
+    BOOST_CHECK_LT(statistics.compressedBytes, statistics.rawBytes);
+    BOOST_CHECK_EQUAL(statistics.decompressedValues, 2);
+
+    // the compression is disabled, the values written before are still read
+    storage.reset();
+    s = rocksdb::DB::Open(options, testPath, &db);
+    BOOST_REQUIRE(s.ok());
+    storage = std::make_shared<RocksDBStorage>(std::unique_ptr<rocksdb::DB>(db), nullptr);
+    BOOST_CHECK(!storage->setRows("/apps/test_table", {"4"}, {largeValue}));
+    BOOST_CHECK(db->Get(rocksdb::ReadOptions(), toDBKey("/apps/test_table", "4"), &value).ok());
+    BOOST_CHECK_EQUAL(value.substr(1), largeValue);
+    keys = {"0", "1", "2", "4"};
+    storage->asyncGetRows("/apps/test_table", keys,
+        [&](Error::UniquePtr error, std::vector<std::optional<Entry>> entries) {
+            BOOST_CHECK(!error);
+            BOOST_REQUIRE_EQUAL(entries.size(), 4);
+            for (size_t i = 0; i < entries.size(); ++i)
+            {
+                BOOST_REQUIRE(entries[i]);
+                BOOST_CHECK_EQUAL(entries[i]->get(), i < 3 ? rows[i].second : largeValue);
+            }
+        });
+
+    storage.reset();
+    if (boost::filesystem::exists(testPath))
+    {
+        boost::filesystem::remove_all(testPath);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(valueCompressionExistingDB)
+{
+    std::string testPath = "./valueCompressionExistingDBTest";
+    rocksdb::Options options;
+    options.create_if_missing = true;
+    rocksdb::DB* db;
+    rocksdb::Status s = rocksdb::DB::Open(options, testPath, &db);
+    BOOST_REQUIRE(s.ok());
+    // the raw value looks like a zstd frame, written before the compression is enabled
+    std::string magicValue("\x28\xB5\x2F\xFDvalue", 9);
+    auto storage = std::make_shared<RocksDBStorage>(std::unique_ptr<rocksdb::DB>(db), nullptr);
+    BOOST_CHECK(!storage->setRows("/apps/test_table", {"0"}, {magicValue}));
+    storage.reset();
+
+    s = rocksdb::DB::Open(options, testPath, &db);
+    BOOST_REQUIRE(s.ok());
+    auto compressor = std::make_shared<ValueCompressor>(64);
+    storage = std::make_shared<RocksDBStorage>(
+        std::unique_ptr<rocksdb::DB>(db), nullptr, std::vector<rocksdb::ColumnFamilyHandle*>{},
+        compressor);
+    std::string value;
+    BOOST_CHECK(db->Get(rocksdb::ReadOptions(), VALUE_FORMAT_KEY, &value).IsNotFound());
+    std::string largeValue(1024, 'a');
+    BOOST_CHECK(!storage->setRows("/apps/test_table", {"1"}, {largeValue}));
+    BOOST_CHECK(db->Get(rocksdb::ReadOptions(), toDBKey("/apps/test_table", "1"), &value).ok());
+    BOOST_CHECK_EQUAL(value, largeValue);
+    std::vector<std::string> keys = {"0", "1"};
+    storage->asyncGetRows("/apps/test_table", keys,
+        [&](Error::UniquePtr error, std::vector<std::optional<Entry>> entries) {
+            BOOST_CHECK(!error);
+            BOOST_REQUIRE_EQUAL(entries.size(), 2);
+            BOOST_REQUIRE(entries[0] && entries[1]);
+            BOOST_CHECK_EQUAL(entries[0]->get(), magicValue);
+            BOOST_CHECK_EQUAL(entries[1]->get(), largeValue);
+        });
+    BOOST_CHECK_EQUAL(compressor->statistics().compressedValues, 0);
+
+    storage.reset();
+    if (boost::filesystem::exists(testPath))
+    {
+        boost::filesystem::remove_all(testPath);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(dataEncryptionBatch)
+{
+    auto dataEncryption = std::make_shared<FakeDataEncryption>();
+    // more values than one task of the batch, the empty values are kept empty
+    std::vector<std::string> values;
+    for (size_t i = 0; i < 200; ++i)
+    {
+        values.emplace_back(i % 10 == 0 ? "" : "value_" + std::string(i, 'v'));
+    }
+    auto encrypted = values;
+    dataEncryption->encryptBatch(encrypted);
+    BOOST_REQUIRE_EQUAL(encrypted.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        if (values[i].empty())
+        {
+            BOOST_CHECK(encrypted[i].empty());
+            continue;
+        }
+        BOOST_CHECK_NE(encrypted[i], values[i]);
+        BOOST_CHECK_EQUAL(dataEncryption->decrypt(encrypted[i]), values[i]);
+    }
+    auto decrypted = encrypted;
+    dataEncryption->decryptBatch(decrypted);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        decrypted.begin(), decrypted.end(), values.begin(), values.end());
+
+    // the values encrypted one by one are decrypted in the batch
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        encrypted[i] = values[i].empty() ? "" : dataEncryption->encrypt(values[i]);
+    }
+    dataEncryption->decryptBatch(encrypted);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        encrypted.begin(), encrypted.end(), values.begin(), values.end());
+
+    std::vector<std::string> empty;
+    dataEncryption->encryptBatch(empty);
+    dataEncryption->decryptBatch(empty);
+    BOOST_CHECK(empty.empty());
+}
+
+BOOST_AUTO_TEST_CASE(encryptedRoundTrip)
+{
+    std::string testPath = "./encryptedRoundTripTest";
+    rocksdb::Options options;
+    options.create_if_missing = true;
+    rocksdb::DB* db;
+    rocksdb::Status s = rocksdb::DB::Open(options, testPath, &db);
+    BOOST_REQUIRE(s.ok());
+    auto dataEncryption = std::make_shared<FakeDataEncryption>();
+    auto storage =
+        std::make_shared<RocksDBStorage>(std::unique_ptr<rocksdb::DB>(db), dataEncryption);
+    std::string table = "/apps/test_table";
+    auto valueOf = [](size_t i) { return "value_" + boost::lexical_cast<std::string>(i); };
+
+    // the rows written by the prepare
+    auto state = std::make_shared<StateStorage>(storage);
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        keys.emplace_back(boost::lexical_cast<std::string>(i));
+        Entry entry;
+        entry.set(valueOf(i));
+        state->asyncSetRow(table, keys.back(), std::move(entry),
+            [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+    }
+    bcos::protocol::TwoPCParams params;
+    params.number = 1;
+    storage->asyncPrepare(params, *state, [](Error::Ptr error, uint64_t) { BOOST_CHECK(!error); });
+    storage->asyncCommit(params, [](Error::Ptr error, uint64_t) { BOOST_CHECK(!error); });
+
+    // the values are stored encrypted
+    std::string value;
+    BOOST_REQUIRE(db->Get(rocksdb::ReadOptions(), toDBKey(table, "1"), &value).ok());
+    BOOST_CHECK_NE(value, valueOf(1));
+    BOOST_CHECK_EQUAL(dataEncryption->decrypt(value), valueOf(1));
+
+    auto checkRows = [&](std::vector<std::string> const& expected) {
+        storage->asyncGetRows(
+            table, keys, [&](Error::UniquePtr error, std::vector<std::optional<Entry>> entries) {
+                BOOST_CHECK(!error);
+                BOOST_REQUIRE_EQUAL(entries.size(), expected.size());
+                for (size_t i = 0; i < entries.size(); ++i)
+                {
+                    BOOST_REQUIRE(entries[i]);
+                    BOOST_CHECK_EQUAL(entries[i]->get(), expected[i]);
+                }
+            });
+    };
+    std::vector<std::string> expected;
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        expected.emplace_back(valueOf(i));
+    }
+    checkRows(expected);
+
+    // the rows overwritten by setRows
+    std::vector<std::string> values;
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        values.emplace_back("new_" + valueOf(i));
+    }
+    BOOST_CHECK(!storage->setRows(table, keys, values));
+    checkRows(values);
+    storage->asyncGetRow(table, "99", [&](Error::UniquePtr error, std::optional<Entry> entry) {
+        BOOST_CHECK(!error);
+        BOOST_REQUIRE(entry);
+        BOOST_CHECK_EQUAL(entry->get(), "new_" + valueOf(99));
+    });
+
+    storage.reset();
+    if (boost::filesystem::exists(testPath))
+    {
+        boost::filesystem::remove_all(testPath);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(writeReadDelete_1Table)
 {
     writeReadDeleteSingleTable(1000);
@@ -92,7 +92,21 @@ int main(int argc, const char* argv[])
     options.IncreaseParallelism();
     options.OptimizeLevelStyleCompaction();
     options.create_if_missing = false;
-    rocksdb::Status s = rocksdb::DB::Open(options, storagePath, &db);
+    // all column families must be opened
+    std::vector<std::string> columnFamilyNames;
+    rocksdb::DB::ListColumnFamilies(options, storagePath, &columnFamilyNames);
+    std::vector<rocksdb::ColumnFamilyDescriptor> columnFamilies;
+    for (auto& name : columnFamilyNames)
+    {
+        columnFamilies.emplace_back(name, rocksdb::ColumnFamilyOptions(options));
+    }
+    if (columnFamilies.empty())
+    {
+        columnFamilies.emplace_back(
+            rocksdb::kDefaultColumnFamilyName, rocksdb::ColumnFamilyOptions(options));
+    }
+    std::vector<rocksdb::ColumnFamilyHandle*> handles;
+    rocksdb::Status s = rocksdb::DB::Open(options, storagePath, columnFamilies, &handles, &db);
 
     std::string configPath("./config.ini");
     if (params.count("config"))
@@ -131,7 +145,7 @@ int main(int argc, const char* argv[])
     dataEncryption->init();
 
     auto adapter =
-        std::make_shared<RocksDBStorage>(std::unique_ptr<rocksdb::DB>(db), dataEncryption);
+        std::make_shared<RocksDBStorage>(std::unique_ptr<rocksdb::DB>(db), dataEncryption, handles);
 
     if (iterate)
     {
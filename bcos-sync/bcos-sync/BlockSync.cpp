@@ -630,65 +630,72 @@ void BlockSync::maintainBlockRequest()
                                << LOG_KV("from", blocksReq->fromNumber())
                                << LOG_KV("size", blocksReq->size()) << LOG_KV("to", numberLimit - 1)
                                << LOG_KV("peer", _p->nodeId()->shortHex());
-            for (BlockNumber number = blocksReq->fromNumber(); number < numberLimit; number++)
-            {
-                fetchAndSendBlock(reqQueue, _p->nodeId(), number);
-            }
+            fetchAndSendBlocks(reqQueue, _p->nodeId(), blocksReq->fromNumber(), numberLimit - 1);
         }
         return true;
     });
 }
 
-void BlockSync::fetchAndSendBlock(
-    DownloadRequestQueue::Ptr _reqQueue, PublicPtr _peer, BlockNumber _number)
+void BlockSync::fetchAndSendBlocks(
+    DownloadRequestQueue::Ptr _reqQueue, PublicPtr _peer, BlockNumber _from, BlockNumber _to)
 {
     // only fetch blockHeader and transactions
     auto blockFlag = HEADER | TRANSACTIONS;
     auto self = std::weak_ptr<BlockSync>(shared_from_this());
-    m_config->ledger()->asyncGetBlockDataByNumber(_number, blockFlag,
-        [self, _reqQueue, _peer, _number](Error::Ptr _error, Block::Ptr _block) {
+    // the blocks before the number have been sent
+    auto nextNumber = std::make_shared<BlockNumber>(_from);
+    m_config->ledger()->asyncGetBlockDataByRange(_from, _to, blockFlag,
+        [self, _reqQueue, _peer, _to, nextNumber](Error::Ptr _error, BlocksPtr _blocks, bool) {
             if (_error != nullptr)
             {
                 BLKSYNC_LOG(WARNING)
-                    << LOG_DESC("fetchAndSendBlock failed for asyncGetBlockDataByNumber failed")
-                    << LOG_KV("number", _number) << LOG_KV("errorCode", _error->errorCode())
+                    << LOG_DESC("fetchAndSendBlocks failed for asyncGetBlockDataByRange failed")
+                    << LOG_KV("from", *nextNumber) << LOG_KV("to", _to)
+                    << LOG_KV("errorCode", _error->errorCode())
                     << LOG_KV("errorMessage", _error->errorMessage());
-                _reqQueue->push(_number, 1);
+                _reqQueue->push(*nextNumber, _to - *nextNumber + 1);
                 return;
             }
-            try
+            auto sync = self.lock();
+            if (!sync)
             {
-                auto sync = self.lock();
-                if (!sync)
-                {
-                    return;
-                }
-                auto blockHeader = _block->blockHeader();
-                auto signature = blockHeader->signatureList();
-                auto config = sync->m_config;
-                auto blocksReq = config->msgFactory()->createBlocksMsg();
-                bytesPointer blockData = std::make_shared<bytes>();
-                _block->encode(*blockData);
-                blocksReq->appendBlockData(std::move(*blockData));
-                blocksReq->setNumber(_number);
-                config->frontService()->asyncSendMessageByNodeID(
-                    ModuleID::BlockSync, _peer, ref(*(blocksReq->encode())), 0, nullptr);
-                BLKSYNC_LOG(DEBUG)
-                    << LOG_DESC("fetchAndSendBlock: response block")
-                    << LOG_KV("toPeer", _peer->shortHex()) << LOG_KV("number", _number)
-                    << LOG_KV("hash", blockHeader->hash().abridged())
-                    << LOG_KV("signatureSize", signature.size())
-                    << LOG_KV("transactionsSize", _block->transactionsSize());
+                return;
             }
-            catch (std::exception const& e)
+            for (auto const& block : *_blocks)
             {
-                BLKSYNC_LOG(WARNING)
-                    << LOG_DESC("fetchAndSendBlock exception") << LOG_KV("number", _number)
-                    << LOG_KV("error", boost::diagnostic_information(e));
+                sync->sendBlock(_peer, block);
+                (*nextNumber)++;
             }
         });
 }
 
+void BlockSync::sendBlock(PublicPtr _peer, Block::Ptr _block)
+{
+    try
+    {
+        auto blockHeader = _block->blockHeader();
+        auto signature = blockHeader->signatureList();
+        auto blocksReq = m_config->msgFactory()->createBlocksMsg();
+        bytesPointer blockData = std::make_shared<bytes>();
+        _block->encode(*blockData);
+        blocksReq->appendBlockData(std::move(*blockData));
+        blocksReq->setNumber(blockHeader->number());
+        m_config->frontService()->asyncSendMessageByNodeID(
+            ModuleID::BlockSync, _peer, ref(*(blocksReq->encode())), 0, nullptr);
+        BLKSYNC_LOG(DEBUG) << LOG_DESC("fetchAndSendBlocks: response block")
+                           << LOG_KV("toPeer", _peer->shortHex())
+                           << LOG_KV("number", blockHeader->number())
+                           << LOG_KV("hash", blockHeader->hash().abridged())
+                           << LOG_KV("signatureSize", signature.size())
+                           << LOG_KV("transactionsSize", _block->transactionsSize());
+    }
+    catch (std::exception const& e)
+    {
+        BLKSYNC_LOG(WARNING) << LOG_DESC("sendBlock exception")
+                             << LOG_KV("error", boost::diagnostic_information(e));
+    }
+}
+
 void BlockSync::maintainPeersConnection()
 {
     if (!m_config->existsInGroup())
@@ -110,8 +110,10 @@ protected:
 
 protected:
     void requestBlocks(bcos::protocol::BlockNumber _from, bcos::protocol::BlockNumber _to);
-    void fetchAndSendBlock(DownloadRequestQueue::Ptr _reqQueue, bcos::crypto::PublicPtr _peer,
-        bcos::protocol::BlockNumber _number);
+    // fetch the blocks in [_from, _to] by range and send them to the peer one by one
+    void fetchAndSendBlocks(DownloadRequestQueue::Ptr _reqQueue, bcos::crypto::PublicPtr _peer,
+        bcos::protocol::BlockNumber _from, bcos::protocol::BlockNumber _to);
+    void sendBlock(bcos::crypto::PublicPtr _peer, bcos::protocol::Block::Ptr _block);
     void printSyncInfo();
 
 protected:
@@ -85,6 +85,53 @@ void KeyPageStorage::asyncGetPrimaryKeys(std::string_view tableView,
     readLock.unlock();
     _callback(nullptr, std::move(ret));
 }
+void KeyPageStorage::asyncGetPrimaryKeyPage(std::string_view tableView,
+    const std::optional<storage::Condition const>& _condition, std::string_view _cursor,
+    size_t _limit, std::function<void(Error::UniquePtr, std::vector<std::string>)> _callback)
+{
+    if (m_ignoreTables->find(tableView) != m_ignoreTables->end())
+    {
+        _callback(BCOS_ERROR_UNIQUE_PTR(StorageError::ReadError, "scan s_tables is not supported"),
+            std::vector<std::string>());
+        return;
+    }
+    auto [error, data] = getData(tableView, TABLE_META_KEY);
+    if (error)
+    {
+        _callback(BCOS_ERROR_WITH_PREV_UNIQUE_PTR(StorageError::ReadError,
+                      std::string("get table meta data failed, table:").append(tableView), *error),
+            std::vector<std::string>());
+        return;
+    }
+    std::vector<std::string> ret;
+    auto meta = &std::get<1>(data.value()->data);
+    auto readLock = meta->rLock();
+    auto& pageInfo = meta->getAllPageInfoNoLock();
+    // the page key is the last key of the page, the pages before the cursor are skipped
+    auto it = std::upper_bound(pageInfo.begin(), pageInfo.end(), _cursor,
+        [](const std::string_view& lhs, const PageInfo& rhs) { return lhs < rhs.getPageKey(); });
+    for (; it != pageInfo.end() && ret.size() < _limit; ++it)
+    {
+        auto [error, data] = getData(tableView, it->getPageKey(), true);
+        boost::ignore_unused(error);
+        assert(!error);
+        auto page = &std::get<0>(data.value()->data);
+        auto [entries, pageLock] = page->getEntries();
+        boost::ignore_unused(pageLock);
+        for (auto entryIt = entries.upper_bound(_cursor);
+             entryIt != entries.end() && ret.size() < _limit; ++entryIt)
+        {
+            if (entryIt->second.status() != Entry::DELETED &&
+                (!_condition || _condition->isValid(entryIt->first)))
+            {
+                ret.emplace_back(entryIt->first);
+            }
+        }
+    }
+    readLock.unlock();
+    _callback(nullptr, std::move(ret));
+}
+
 // TODO: add interface and cow to avoid page copy
 void KeyPageStorage::asyncGetRow(std::string_view tableView, std::string_view keyView,
     std::function<void(Error::UniquePtr, std::optional<Entry>)> _callback)
@@ -237,7 +284,7 @@ void KeyPageStorage::parallelTraverse(bool onlyDirty,
                     auto meta = &std::get<1>(it.second->data);
                     auto readLock = meta->rLock();
                     Entry entry;
-                    entry.setObject(*meta);
+                    entry.set(meta->encode());
                     readLock.unlock();
                     if (c_fileLogLevel >= bcos::LogLevel::TRACE)
                     {  // FIXME: this log is only for debug, comment it when release
@@ -273,7 +320,7 @@ void KeyPageStorage::parallelTraverse(bool onlyDirty,
                     }
                     else
                     {
-                        entry.setObject(*page);
+                        entry.set(page->encode());
                         entry.setStatus(it.second->entry.status());
                         if (c_fileLogLevel >= TRACE)
                         {
@@ -362,6 +409,136 @@ crypto::HashType KeyPageStorage::hash(const bcos::crypto::Hash::Ptr& hashImpl) c
     return totalHash;
 }
 
+void KeyPageStorage::updateStatistics(protocol::BlockNumber _number)
+{
+    if (!m_statistics)
+    {
+        return;
+    }
+    struct TableCounters
+    {
+        uint64_t reads = 0;
+        uint64_t writes = 0;
+        uint64_t writtenEntriesSize = 0;
+        uint64_t writtenBytes = 0;
+    };
+    std::map<std::string_view, TableCounters, std::less<>> tables;
+    for (auto& bucket : m_buckets)
+    {
+        std::shared_lock lock(bucket.mutex);
+        for (auto& it : bucket.container)
+        {
+            auto& data = it.second;
+            auto& counters = tables[data->table];
+            if (data->type == Data::Type::TableMeta)
+            {
+                auto& meta = std::get<1>(data->data);
+                counters.reads += meta.reads();
+                counters.writes += meta.writes();
+                counters.writtenEntriesSize += meta.writtenEntriesSize();
+                if (data->entry.dirty())
+                {
+                    counters.writtenBytes += meta.encodedSize();
+                }
+            }
+            else if (data->entry.dirty())
+            {
+                counters.writtenBytes += data->type == Data::Type::Page ?
+                                             std::get<0>(data->data).size() :
+                                             data->entry.size();
+            }
+        }
+    }
+
+    uint64_t totalWrittenBytes = 0;
+    for (auto& [table, counters] : tables)
+    {
+        if (counters.reads == 0 && counters.writes == 0 && counters.writtenBytes == 0)
+        {
+            continue;
+        }
+        m_statistics->update(_number, table, counters.reads, counters.writes,
+            counters.writtenEntriesSize, counters.writtenBytes);
+        totalWrittenBytes += counters.writtenBytes;
+        if (counters.writtenBytes > 0)
+        {
+            KeyPage_LOG(DEBUG) << METRIC << LOG_DESC("table written bytes")
+                               << LOG_KV("number", _number) << LOG_KV("table", table)
+                               << LOG_KV("reads", counters.reads)
+                               << LOG_KV("writes", counters.writes)
+                               << LOG_KV("writtenBytes", counters.writtenBytes)
+                               << LOG_KV("pageSize", m_statistics->pageSize(table));
+        }
+    }
+    KeyPage_LOG(INFO) << METRIC << LOG_DESC("block written bytes") << LOG_KV("number", _number)
+                      << LOG_KV("tables", tables.size())
+                      << LOG_KV("writtenBytes", totalWrittenBytes);
+}
+
+size_t KeyPageStatistics::pageSize(std::string_view table) const
+{
+    std::shared_lock lock(x_tables);
+    auto it = m_tables.find(table);
+    if (it == m_tables.end())
+    {
+        return m_pageSize;
+    }
+    auto& stat = it->second.current;
+    auto pageSize = m_pageSize;
+    if (stat.writeRatio >= c_writeHeavyRatio)
+    {
+        pageSize = m_pageSize / 2;
+    }
+    else if (stat.writeRatio <= c_readMostlyRatio)
+    {
+        pageSize = m_pageSize * 2;
+    }
+    pageSize = std::max(pageSize, (size_t)stat.entrySize * c_minEntriesPerPage);
+    return std::clamp(pageSize, MIN_PAGE_SIZE, std::max(m_pageSize, c_maxPageSize));
+}
+
+void KeyPageStatistics::update(protocol::BlockNumber number, std::string_view table,
+    uint64_t reads, uint64_t writes, uint64_t writtenEntriesSize, uint64_t writtenBytes)
+{
+    std::unique_lock lock(x_tables);
+    auto it = m_tables.find(table);
+    if (it == m_tables.end())
+    {
+        it = m_tables.emplace(std::string(table), TableStat()).first;
+    }
+    auto& stat = it->second;
+    if (stat.number != number)
+    {
+        stat.base = stat.current;
+        stat.number = number;
+    }
+    // fold from the base, the retried prepare of the block is not counted twice
+    auto writeRatio = (double)writes / std::max(reads + writes, (uint64_t)1);
+    auto entrySize = writes > 0 ? (double)writtenEntriesSize / writes : 0;
+    auto& base = stat.base;
+    auto& current = stat.current;
+    current.initialized = true;
+    if (!base.initialized)
+    {
+        current.writeRatio = writeRatio;
+        current.entrySize = entrySize;
+    }
+    else
+    {
+        current.writeRatio = base.writeRatio * (1 - c_alpha) + writeRatio * c_alpha;
+        current.entrySize =
+            writes > 0 ? base.entrySize * (1 - c_alpha) + entrySize * c_alpha : base.entrySize;
+    }
+    stat.writtenBytes = writtenBytes;
+}
+
+uint64_t KeyPageStatistics::writtenBytes(std::string_view table) const
+{
+    std::shared_lock lock(x_tables);
+    auto it = m_tables.find(table);
+    return it == m_tables.end() ? 0 : it->second.writtenBytes;
+}
+
 void KeyPageStorage::rollback(const Recoder& recoder)
 {
     if (m_readOnly)
@@ -604,6 +781,7 @@ std::pair<Error::UniquePtr, std::optional<Entry>> KeyPageStorage::getEntryFromPa
     }
     auto meta = &std::get<1>(data.value()->data);
     auto readLock = meta->rLock();
+    meta->countRead();
     if (key.empty())
     {  // table meta
         if (meta->size() > 0)
@@ -618,7 +796,7 @@ std::pair<Error::UniquePtr, std::optional<Entry>> KeyPageStorage::getEntryFromPa
             if (data.value()->entry.dirty())
             {
                 Entry entry;
-                entry.setObject(*meta);
+                entry.set(meta->encode());
                 entry.setStatus(data.value()->entry.status());
                 return std::make_pair(nullptr, std::move(entry));
             }
@@ -671,7 +849,7 @@ std::pair<Error::UniquePtr, std::optional<Entry>> KeyPageStorage::getEntryFromPa
                         << LOG_KV("dirty", data.value()->entry.dirty());
                 }
                 Entry entry;
-                entry.setObject(*page);
+                entry.set(page->encode());
                 entry.setStatus(pageData->entry.status());
                 return std::make_pair(nullptr, std::move(entry));
             }
@@ -699,6 +877,14 @@ Error::UniquePtr KeyPageStorage::setEntryToPage(std::string table, std::string k
     }
     auto meta = &std::get<1>(data.value()->data);
     auto metaWriteLock = meta->lock();
+    meta->countWrite(entry.size());
+    if (meta->pageSize() == 0)
+    {
+        meta->setPageSize(m_statistics ? m_statistics->pageSize(table) : m_pageSize);
+    }
+    auto pageSize = meta->pageSize();
+    auto splitSize = pageSize / 3 * 2;
+    auto mergeSize = pageSize / 4;
     // insert or update
     auto pageInfoOption = meta->getPageInfoNoLock(key);
     std::string pageKey = key;
@@ -766,17 +952,17 @@ Error::UniquePtr KeyPageStorage::setEntryToPage(std::string table, std::string k
         data.value()->entry.setStatus(Entry::Status::MODIFIED);
     }
     pageKey = page->endKey();
-    if (page->size() > m_pageSize && page->validCount() > 1)
+    if (page->size() > pageSize && page->validCount() > 1)
     {  // split page, TODO: if dag trigger split, it maybe split to different page?
         if (c_fileLogLevel >= TRACE)
         {
             KeyPage_LOG(TRACE) << LOG_DESC("trigger split page") << LOG_KV("table", table)
                                << LOG_KV("pageKey", toHex(pageKey)) << LOG_KV("size", page->size())
-                               << LOG_KV("m_pageSize", m_pageSize)
+                               << LOG_KV("pageSize", pageSize)
                                << LOG_KV("validCount", page->validCount())
                                << LOG_KV("count", page->count());
         }
-        auto newPage = page->split(m_splitSize);
+        auto newPage = page->split(splitSize);
         // update old meta pageInfo
         auto oldStartKey = meta->updatePageInfoNoLock(
             pageKey, page->endKey(), page->validCount(), page->size(), pageInfoOption);
@@ -798,7 +984,7 @@ Error::UniquePtr KeyPageStorage::setEntryToPage(std::string table, std::string k
         insertNewPage(table, newPage.endKey(), meta, std::move(newPage));
         data.value()->entry.setStatus(Entry::Status::MODIFIED);
     }
-    else if (page->size() < m_mergeSize)
+    else if (page->size() < mergeSize)
     {  // merge operation
         // get next page, check size and merge current into next
         auto nextPageKey = meta->getNextPageKeyNoLock(page->endKey());
@@ -813,7 +999,7 @@ Error::UniquePtr KeyPageStorage::setEntryToPage(std::string table, std::string k
                     << LOG_KV("key", toHex(key)) << LOG_KV("pageKey", toHex(pageKey));
             }
             auto nextPage = &std::get<0>(nextPageData.value()->data);
-            if (nextPage->size() < m_splitSize && nextPage != page)
+            if (nextPage->size() < splitSize && nextPage != page)
             {
                 auto endKey = page->endKey();
                 auto nextEndKey = nextPage->endKey();
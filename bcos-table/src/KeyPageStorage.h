@@ -36,8 +36,10 @@
 #include <boost/multi_index_container.hpp>
 #include <boost/property_map/property_map.hpp>
 #include <boost/serialization/vector.hpp>
+#include <atomic>
 #include <cstddef>
 #include <exception>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -83,19 +85,122 @@ constexpr static int32_t ARCHIVE_FLAG =
 
 const char* const TABLE_META_KEY = "";
 const size_t MIN_PAGE_SIZE = 2048;
+// the flat encoding of Page and TableMeta starts with FLAT_ENCODING_MAGIC and the version, the
+// pages encoded by boost::serialization start with the entry count which never reaches the magic
+const uint32_t FLAT_ENCODING_MAGIC = 0xFFFFFFFF;
+const uint8_t FLAT_ENCODING_VERSION = 1;
+
+namespace keypage
+{
+inline void appendUint32(std::string& buffer, uint32_t value)
+{
+    for (size_t i = 0; i < sizeof(value); ++i)
+    {
+        buffer.push_back((char)((value >> (i * 8)) & 0xFF));
+    }
+}
+inline void appendUint16(std::string& buffer, uint16_t value)
+{
+    buffer.push_back((char)(value & 0xFF));
+    buffer.push_back((char)(value >> 8));
+}
+inline uint32_t readUint32(std::string_view buffer, size_t offset)
+{
+    if (offset + sizeof(uint32_t) > buffer.size())
+    {
+        BOOST_THROW_EXCEPTION(BCOS_ERROR(StorageError::UnknownError, "invalid flat encoding"));
+    }
+    uint32_t value = 0;
+    for (size_t i = 0; i < sizeof(value); ++i)
+    {
+        value |= ((uint32_t)(uint8_t)buffer[offset + i]) << (i * 8);
+    }
+    return value;
+}
+inline uint16_t readUint16(std::string_view buffer, size_t offset)
+{
+    if (offset + sizeof(uint16_t) > buffer.size())
+    {
+        BOOST_THROW_EXCEPTION(BCOS_ERROR(StorageError::UnknownError, "invalid flat encoding"));
+    }
+    return (uint16_t)((uint8_t)buffer[offset]) | ((uint16_t)(uint8_t)buffer[offset + 1] << 8);
+}
+inline std::string_view readBytes(std::string_view buffer, size_t offset, size_t length)
+{
+    if (offset + length > buffer.size())
+    {
+        BOOST_THROW_EXCEPTION(BCOS_ERROR(StorageError::UnknownError, "invalid flat encoding"));
+    }
+    return buffer.substr(offset, length);
+}
+inline bool isFlatEncoded(std::string_view buffer)
+{
+    return buffer.size() > sizeof(uint32_t) && readUint32(buffer, 0) == FLAT_ENCODING_MAGIC;
+}
+}  // namespace keypage
+
+// the workload of the tables observed by the KeyPageStorages of the blocks, used to adapt the page
+// size of every table: the write-heavy tables use smaller pages to reduce the bytes rewritten by
+// every write, the read-mostly tables use larger pages to reduce the pages loaded
+class KeyPageStatistics
+{
+public:
+    using Ptr = std::shared_ptr<KeyPageStatistics>;
+    explicit KeyPageStatistics(size_t _pageSize)
+      : m_pageSize(std::max(_pageSize, MIN_PAGE_SIZE))
+    {}
+    virtual ~KeyPageStatistics() = default;
+
+    size_t pageSize(std::string_view table) const;
+    // fold the counters of a block into the statistics of the table, the counters of the block
+    // prepared again replace the ones folded before
+    void update(protocol::BlockNumber number, std::string_view table, uint64_t reads,
+        uint64_t writes, uint64_t writtenEntriesSize, uint64_t writtenBytes);
+    // the bytes of the pages and meta written by the last block
+    uint64_t writtenBytes(std::string_view table) const;
+
+private:
+    struct Averages
+    {
+        double writeRatio = 0;
+        double entrySize = 0;
+        bool initialized = false;
+    };
+    struct TableStat
+    {
+        // the averages before the last block folded
+        Averages base;
+        Averages current;
+        uint64_t writtenBytes = 0;
+        protocol::BlockNumber number = -1;
+    };
+    // the weight of the latest block in the moving averages
+    constexpr static double c_alpha = 0.2;
+    constexpr static double c_writeHeavyRatio = 0.5;
+    constexpr static double c_readMostlyRatio = 0.1;
+    // the page should contain some entries at least
+    constexpr static size_t c_minEntriesPerPage = 8;
+    // the size in PageInfo is uint16_t
+    constexpr static size_t c_maxPageSize = 32 * 1024;
+
+    size_t m_pageSize;
+    mutable std::shared_mutex x_tables;
+    std::map<std::string, TableStat, std::less<>> m_tables;
+};
+
 class KeyPageStorage : public virtual storage::StateStorageInterface
 {
 public:
     using Ptr = std::shared_ptr<KeyPageStorage>;
 
     explicit KeyPageStorage(std::shared_ptr<StorageInterface> _prev, size_t _pageSize = 1024,
-        std::shared_ptr<const std::set<std::string, std::less<>>> _ignoreTables = nullptr)
+        std::shared_ptr<const std::set<std::string, std::less<>>> _ignoreTables = nullptr,
+        KeyPageStatistics::Ptr _statistics = nullptr)
       : storage::StateStorageInterface(_prev),
         m_pageSize(_pageSize > MIN_PAGE_SIZE ? _pageSize : MIN_PAGE_SIZE),
-        m_splitSize(m_pageSize / 3 * 2),
-        m_mergeSize(m_pageSize / 4),
         m_buckets(std::thread::hardware_concurrency()),
-        m_ignoreTables(_ignoreTables)
+        m_ignoreTables(_ignoreTables),
+        m_statistics(std::move(_statistics))
     {
         if (!m_ignoreTables.get())
         {
@@ -125,6 +230,11 @@ public:
         const std::optional<storage::Condition const>& _condition,
         std::function<void(Error::UniquePtr, std::vector<std::string>)> _callback) override;
 
+    void asyncGetPrimaryKeyPage(std::string_view table,
+        const std::optional<storage::Condition const>& _condition, std::string_view _cursor,
+        size_t _limit,
+        std::function<void(Error::UniquePtr, std::vector<std::string>)> _callback) override;
+
     void asyncGetRow(std::string_view tableView, std::string_view keyView,
         std::function<void(Error::UniquePtr, std::optional<Entry>)> _callback) override;
 
@@ -145,6 +255,10 @@ public:
 
     void rollback(const Recoder& recoder) override;
 
+    // fold the reads and writes of this storage into the statistics and report the bytes of every
+    // table to be written, should be called once when the block is prepared
+    void updateStatistics(protocol::BlockNumber _number);
+
     struct Data;
     class PageInfo
     {  // all methods is not thread safe
@@ -236,6 +350,11 @@ public:
             {
                 return;
             }
+            if (keypage::isFlatEncoded(value))
+            {
+                decode(value);
+                return;
+            }
             boost::iostreams::stream<boost::iostreams::array_source> inputStream(
                 value.data(), value.size());
             boost::archive::binary_iarchive archive(inputStream, ARCHIVE_FLAG);
@@ -245,6 +364,7 @@ public:
         {
             pages = std::make_unique<std::vector<PageInfo>>();
             *pages = *t.pages;
+            m_pageSize = t.m_pageSize;
         }
         TableMeta& operator=(const TableMeta& t)
         {
@@ -252,15 +372,21 @@ public:
             {
                 pages = std::make_unique<std::vector<PageInfo>>();
                 *pages = *t.pages;
+                m_pageSize = t.m_pageSize;
             }
             return *this;
         }
-        TableMeta(TableMeta&& t) { pages = std::move(t.pages); }
+        TableMeta(TableMeta&& t)
+        {
+            pages = std::move(t.pages);
+            m_pageSize = t.m_pageSize;
+        }
         TableMeta& operator=(TableMeta&& t)
         {
             if (this != &t)
             {
                 pages = std::move(t.pages);
+                m_pageSize = t.m_pageSize;
             }
             return *this;
         }
@@ -452,28 +578,87 @@ public:
         }
         double hitRate() { return hit / (double)getPageInfoCount; }
 
+        // the counters of the table in this storage, only the counters are thread safe
+        void countRead() { ++m_reads; }
+        void countWrite(size_t entrySize)
+        {
+            ++m_writes;
+            m_writtenEntriesSize += entrySize;
+        }
+        uint64_t reads() const { return m_reads; }
+        uint64_t writes() const { return m_writes; }
+        uint64_t writtenEntriesSize() const { return m_writtenEntriesSize; }
+        // the page size of the table, decided when the table is written first in this storage
+        size_t pageSize() const { return m_pageSize; }
+        void setPageSize(size_t pageSize) { m_pageSize = pageSize; }
+
+        // the length of the flat encoding, the empty pages are not encoded
+        size_t encodedSize() const
+        {
+            size_t length = sizeof(uint32_t) * 2 + 1;
+            for (auto& pageInfo : *pages)
+            {
+                if (pageInfo.getCount() > 0)
+                {
+                    length +=
+                        sizeof(uint32_t) + pageInfo.getPageKey().size() + sizeof(uint16_t) * 2;
+                }
+            }
+            return length;
+        }
+        // flat encoding: magic|version|count|{keyLen|pageKey|count|size}..., the empty pages are
+        // removed like the boost::serialization one
+        std::string encode() const
+        {
+            removeEmptyPages();
+            std::string buffer;
+            buffer.reserve(encodedSize());
+            keypage::appendUint32(buffer, FLAT_ENCODING_MAGIC);
+            buffer.push_back((char)FLAT_ENCODING_VERSION);
+            keypage::appendUint32(buffer, (uint32_t)pages->size());
+            for (auto& pageInfo : *pages)
+            {
+                auto pageKey = pageInfo.getPageKey();
+                keypage::appendUint32(buffer, (uint32_t)pageKey.size());
+                buffer.append(pageKey);
+                keypage::appendUint16(buffer, pageInfo.getCount());
+                keypage::appendUint16(buffer, pageInfo.getSize());
+            }
+            return buffer;
+        }
+
     private:
         uint32_t getPageInfoCount = 0;
         uint32_t hit = 0;
+        std::atomic_uint64_t m_reads = 0;
+        std::atomic_uint64_t m_writes = 0;
+        std::atomic_uint64_t m_writtenEntriesSize = 0;
+        size_t m_pageSize = 0;
         mutable std::shared_mutex mutex;
         std::unique_ptr<std::vector<PageInfo>> pages = nullptr;
         friend class boost::serialization::access;
         size_t lastPageInfoIndex = 0;
-        template <class Archive>
-        void save(Archive& ar, const unsigned int version) const
+        void decode(std::string_view value)
+        {
+            size_t offset = sizeof(uint32_t) + 1;
+            auto count = keypage::readUint32(value, offset);
+            offset += sizeof(uint32_t);
+            pages = std::make_unique<std::vector<PageInfo>>();
+            pages->reserve(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto keyLength = keypage::readUint32(value, offset);
+                offset += sizeof(uint32_t);
+                auto pageKey = keypage::readBytes(value, offset, keyLength);
+                offset += keyLength;
+                auto pageCount = keypage::readUint16(value, offset);
+                auto pageSize = keypage::readUint16(value, offset + sizeof(uint16_t));
+                offset += sizeof(uint16_t) * 2;
+                pages->emplace_back(std::string(pageKey), pageCount, pageSize, nullptr);
+            }
+        }
+        void removeEmptyPages() const
         {
-            std::ignore = version;
-            // auto len = (uint32_t)pages->size();
-            // ar& len;
-            // for (size_t i = 0; i < pages->size(); ++i)
-            // {
-            //     if (pages->at(i).getCount() == 0)
-            //     {
-            //         continue;
-            //     }
-            //     ar & pages->at(i);
-            // }
-
             for (auto it = pages->begin(); it < pages->end();)
             {
                 if (it->getCount() == 0)
@@ -492,6 +677,23 @@ public:
                     ++it;
                 }
             }
+        }
+        // the boost::serialization encoding, only used to read the existing table meta
+        template <class Archive>
+        void save(Archive& ar, const unsigned int version) const
+        {
+            std::ignore = version;
+            // auto len = (uint32_t)pages->size();
+            // ar& len;
+            // for (size_t i = 0; i < pages->size(); ++i)
+            // {
+            //     if (pages->at(i).getCount() == 0)
+            //     {
+            //         continue;
+            //     }
+            //     ar & pages->at(i);
+            // }
+            removeEmptyPages();
             ar << *pages;
         }
         template <class Archive>
@@ -521,17 +723,32 @@ public:
             {
                 return;
             }
-            boost::iostreams::stream<boost::iostreams::array_source> inputStream(
-                value.data(), value.size());
-            boost::archive::binary_iarchive archive(inputStream, ARCHIVE_FLAG);
-            archive >> *this;
-            if (pageKey != entries.rbegin()->first)
+            if (keypage::isFlatEncoded(value))
+            {  // the entries are decoded lazily
+                m_encoded = std::make_shared<const std::string>(value);
+                m_encodedCount = keypage::readUint32(*m_encoded, sizeof(uint32_t) + 1);
+                m_size = keypage::readUint32(*m_encoded, sizeof(uint32_t) * 2 + 1);
+                m_validCount = m_encodedCount;
+                if (encodedRecordsOffset() > m_encoded->size())
+                {
+                    BOOST_THROW_EXCEPTION(
+                        BCOS_ERROR(StorageError::UnknownError, "invalid flat encoded page"));
+                }
+            }
+            else
+            {
+                boost::iostreams::stream<boost::iostreams::array_source> inputStream(
+                    value.data(), value.size());
+                boost::archive::binary_iarchive archive(inputStream, ARCHIVE_FLAG);
+                archive >> *this;
+            }
+            if (pageKey != endKeyNoLock())
             {
                 KeyPage_LOG(WARNING)
                     << LOG_DESC("load page with invalid pageKey")
                     << LOG_KV("pageKey", toHex(pageKey))
-                    << LOG_KV("validPageKey", toHex(entries.rbegin()->first))
-                    << LOG_KV("valid", m_validCount) << LOG_KV("count", entries.size());
+                    << LOG_KV("validPageKey", toHex(endKeyNoLock()))
+                    << LOG_KV("valid", m_validCount) << LOG_KV("count", countNoLock());
                 m_invalidPageKeys.insert(std::string(pageKey));
             }
         }
@@ -541,6 +758,8 @@ public:
             m_size = p.m_size;
             m_validCount = p.m_validCount;
             m_invalidPageKeys = p.m_invalidPageKeys;
+            m_encoded = p.m_encoded;
+            m_encodedCount = p.m_encodedCount;
         }
         Page& operator=(const Page& p)
         {
@@ -550,6 +769,8 @@ public:
                 m_size = p.m_size;
                 m_validCount = p.m_validCount;
                 m_invalidPageKeys = p.m_invalidPageKeys;
+                m_encoded = p.m_encoded;
+                m_encodedCount = p.m_encodedCount;
             }
             return *this;
         }
@@ -559,6 +780,8 @@ public:
             m_size = p.m_size;
             m_validCount = p.m_validCount;
             m_invalidPageKeys = std::move(p.m_invalidPageKeys);
+            m_encoded = std::move(p.m_encoded);
+            m_encodedCount = p.m_encodedCount;
         }
         Page& operator=(Page&& p)
         {
@@ -568,6 +791,8 @@ public:
                 m_size = p.m_size;
                 m_validCount = p.m_validCount;
                 m_invalidPageKeys = std::move(p.m_invalidPageKeys);
+                m_encoded = std::move(p.m_encoded);
+                m_encodedCount = p.m_encodedCount;
             }
             return *this;
         }
@@ -575,6 +800,18 @@ public:
         std::optional<Entry> getEntry(std::string_view key)
         {
             std::shared_lock lock(mutex);
+            if (m_encoded)
+            {  // binary search the encoded entries, all of them are NORMAL
+                auto value = findEncoded(key);
+                if (!value)
+                {
+                    return std::nullopt;
+                }
+                Entry entry;
+                entry.set(std::string(*value));
+                entry.setStatus(Entry::Status::NORMAL);
+                return std::make_optional(std::move(entry));
+            }
             auto it = entries.find(key);
             if (it != entries.end())
             {
@@ -612,6 +849,7 @@ public:
         getEntries()
         {
             std::unique_lock lock(mutex);
+            decodeEntries();
             return std::make_pair(std::ref(entries), std::move(lock));
         }
         inline std::tuple<std::optional<Entry>, bool> setEntry(
@@ -621,6 +859,7 @@ public:
             bool pageInfoChanged = false;
             std::optional<Entry> ret;
             std::unique_lock lock(mutex);
+            decodeEntries();
             auto it = entries.lower_bound(key);
             m_size += entry.size();
             if (it != entries.end() && it->first == key)
@@ -708,7 +947,7 @@ public:
         size_t count() const
         {
             std::shared_lock lock(mutex);
-            return entries.size();
+            return countNoLock();
         }
         const std::set<std::string>& invalidKeySet() const
         {
@@ -719,25 +958,18 @@ public:
         std::string startKey() const
         {
             std::shared_lock lock(mutex);
-            if (entries.empty())
-            {
-                return "";
-            }
-            return entries.begin()->first;
+            return startKeyNoLock();
         }
         std::string endKey() const
         {
             std::shared_lock lock(mutex);
-            if (entries.empty())
-            {
-                return "";
-            }
-            return entries.rbegin()->first;
+            return endKeyNoLock();
         }
         auto split(size_t threshold)
         {
             auto page = Page();
             std::unique_lock lock(mutex);
+            decodeEntries();
             // split this page to two pages
             auto iter = entries.begin();
             while (iter != entries.end())
@@ -777,6 +1009,8 @@ public:
             if (this != &p)
             {
                 std::unique_lock lock(mutex);
+                decodeEntries();
+                p.decodeEntries();
                 for (auto iter = p.entries.begin(); iter != p.entries.end();)
                 {
                     m_size += iter->second.size();
@@ -797,14 +1031,15 @@ public:
             else
             {
                 KeyPage_LOG(ERROR)
-                    << LOG_DESC("merge self") << LOG_KV("startKey", toHex(entries.begin()->first))
-                    << LOG_KV("endKey", toHex(entries.rbegin()->first))
-                    << LOG_KV("valid", m_validCount) << LOG_KV("count", entries.size());
+                    << LOG_DESC("merge self") << LOG_KV("startKey", toHex(startKeyNoLock()))
+                    << LOG_KV("endKey", toHex(endKeyNoLock())) << LOG_KV("valid", m_validCount)
+                    << LOG_KV("count", countNoLock());
             }
         }
         void clean(const std::string_view& pageKey)
         {
             std::unique_lock lock(mutex);
+            // the encoded entries are all NORMAL, needn't decode them
             for (auto iter = entries.begin(); iter != entries.end();)
             {
                 if (iter->second.status() != Entry::Status::DELETED)
@@ -818,19 +1053,18 @@ public:
                 }
             }
             m_invalidPageKeys.clear();
-            if (!entries.empty() && pageKey != entries.rbegin()->first)
+            if (countNoLock() > 0 && pageKey != endKeyNoLock())
             {
                 KeyPage_LOG(WARNING) << LOG_DESC("import page with invalid pageKey")
                                      << LOG_KV("pageKey", toHex(pageKey))
-                                     << LOG_KV("validPageKey", toHex(entries.rbegin()->first))
-                                     << LOG_KV("count", entries.size());
+                                     << LOG_KV("validPageKey", toHex(endKeyNoLock()))
+                                     << LOG_KV("count", countNoLock());
                 m_invalidPageKeys.insert(std::string(pageKey));
             }
-            if (entries.empty())
+            if (countNoLock() == 0)
             {
-                KeyPage_LOG(DEBUG)
-                    << LOG_DESC("import empty page") << LOG_KV("pageKey", toHex(pageKey))
-                    << LOG_KV("count", entries.size());
+                KeyPage_LOG(DEBUG) << LOG_DESC("import empty page")
+                                   << LOG_KV("pageKey", toHex(pageKey)) << LOG_KV("count", 0);
             }
         }
         crypto::HashType hash(
@@ -861,6 +1095,7 @@ public:
         void rollback(const Recoder::Change& change)
         {
             std::unique_lock lock(mutex);
+            decodeEntries();
             auto it = entries.find(change.key);
             if (change.entry)
             {
@@ -938,15 +1173,152 @@ public:
         std::unique_lock<std::shared_mutex> lock() { return std::unique_lock(mutex); }
         std::shared_lock<std::shared_mutex> rLock() { return std::shared_lock(mutex); }
 
+        // flat encoding: magic|version|count|size|offsets|{keyLen|key|valueLen|value}..., the
+        // offsets of the sorted entries make the page searchable without decoding, the caller
+        // should hold the lock of the page
+        std::string encode() const
+        {
+            if (m_encoded)
+            {
+                return *m_encoded;
+            }
+            // the size of the valid entries, same as the decoded one
+            uint32_t validSize = 0;
+            for (auto& it : entries)
+            {
+                if (it.second.status() != Entry::Status::DELETED)
+                {
+                    validSize += it.first.size() + it.second.size();
+                }
+            }
+            auto recordsLength = validSize + sizeof(uint32_t) * 2 * m_validCount;
+            std::string buffer;
+            buffer.reserve(c_encodedHeaderLength + m_validCount * sizeof(uint32_t) + recordsLength);
+            keypage::appendUint32(buffer, FLAT_ENCODING_MAGIC);
+            buffer.push_back((char)FLAT_ENCODING_VERSION);
+            keypage::appendUint32(buffer, m_validCount);
+            keypage::appendUint32(buffer, validSize);
+            uint32_t offset = 0;
+            size_t count = 0;
+            for (auto& it : entries)
+            {
+                if (it.second.status() == Entry::Status::DELETED)
+                {  // skip deleted entry
+                    continue;
+                }
+                ++count;
+                keypage::appendUint32(buffer, offset);
+                offset += sizeof(uint32_t) * 2 + it.first.size() + it.second.size();
+            }
+            assert(count == m_validCount);
+            for (auto& it : entries)
+            {
+                if (it.second.status() == Entry::Status::DELETED)
+                {
+                    continue;
+                }
+                auto value = it.second.get();
+                keypage::appendUint32(buffer, (uint32_t)it.first.size());
+                buffer.append(it.first);
+                keypage::appendUint32(buffer, (uint32_t)value.size());
+                buffer.append(value.data(), value.size());
+            }
+            return buffer;
+        }
+
     private:
+        size_t encodedRecordsOffset() const
+        {
+            return c_encodedHeaderLength + m_encodedCount * sizeof(uint32_t);
+        }
+        std::pair<std::string_view, std::string_view> encodedEntry(size_t index) const
+        {
+            std::string_view encoded(*m_encoded);
+            size_t offset = encodedRecordsOffset() +
+                            keypage::readUint32(
+                                encoded, c_encodedHeaderLength + index * sizeof(uint32_t));
+            auto keyLength = keypage::readUint32(encoded, offset);
+            auto key = keypage::readBytes(encoded, offset + sizeof(uint32_t), keyLength);
+            offset += sizeof(uint32_t) + keyLength;
+            auto valueLength = keypage::readUint32(encoded, offset);
+            return std::make_pair(
+                key, keypage::readBytes(encoded, offset + sizeof(uint32_t), valueLength));
+        }
+        std::optional<std::string_view> findEncoded(std::string_view key) const
+        {
+            size_t low = 0;
+            size_t high = m_encodedCount;
+            while (low < high)
+            {
+                auto middle = low + (high - low) / 2;
+                auto [middleKey, value] = encodedEntry(middle);
+                if (middleKey == key)
+                {
+                    return value;
+                }
+                if (middleKey < key)
+                {
+                    low = middle + 1;
+                }
+                else
+                {
+                    high = middle;
+                }
+            }
+            return std::nullopt;
+        }
+        // decode all entries before modifying the page, the caller should hold the unique lock
+        void decodeEntries()
+        {
+            if (!m_encoded)
+            {
+                return;
+            }
+            auto iter = entries.begin();
+            for (size_t i = 0; i < m_encodedCount; ++i)
+            {
+                auto [key, value] = encodedEntry(i);
+                Entry entry;
+                entry.set(std::string(value));
+                entry.setStatus(Entry::Status::NORMAL);
+                iter = entries.emplace_hint(iter, std::string(key), std::move(entry));
+            }
+            m_encoded.reset();
+            m_encodedCount = 0;
+        }
+        size_t countNoLock() const { return m_encoded ? m_encodedCount : entries.size(); }
+        std::string startKeyNoLock() const
+        {
+            if (countNoLock() == 0)
+            {
+                return "";
+            }
+            return m_encoded ? std::string(encodedEntry(0).first) : entries.begin()->first;
+        }
+        std::string endKeyNoLock() const
+        {
+            if (countNoLock() == 0)
+            {
+                return "";
+            }
+            return m_encoded ? std::string(encodedEntry(m_encodedCount - 1).first) :
+                               entries.rbegin()->first;
+        }
+
+        static constexpr size_t c_encodedHeaderLength = sizeof(uint32_t) * 3 + 1;
         //   PageInfo* pageInfo;
         mutable std::shared_mutex mutex;
         std::map<std::string, Entry, std::less<>> entries;
+        // the flat encoded page loaded from the storage, it is decoded into entries when the
+        // page is modified
+        std::shared_ptr<const std::string> m_encoded;
+        uint32_t m_encodedCount = 0;
         uint32_t m_size = 0;        // page real size
         uint32_t m_validCount = 0;  // valid entry count
         friend class boost::serialization::access;
         // if startKey changed the old startKey need keep to delete old page
         std::set<std::string> m_invalidPageKeys;
+        // the boost::serialization encoding, only used to read the existing pages
         template <class Archive>
         void save(Archive& ar, const unsigned int version) const
         {
@@ -1210,10 +1582,9 @@ private:
     Error::UniquePtr setEntryToPage(std::string table, std::string key, Entry entry);
 
     size_t m_pageSize = 8 * 1024;
-    size_t m_splitSize;
-    size_t m_mergeSize;
     std::vector<Bucket> m_buckets;
     std::shared_ptr<const std::set<std::string, std::less<>>> m_ignoreTables;
+    KeyPageStatistics::Ptr m_statistics;
 };
 
 }  // namespace bcos::storage
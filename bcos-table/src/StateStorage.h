@@ -35,6 +35,8 @@
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index_container.hpp>
 #include <boost/property_map/property_map.hpp>
+#include <map>
+#include <shared_mutex>
 
 namespace bcos::storage
 {
@@ -107,7 +109,7 @@ public:
             for (size_t i = 0; i < m_buckets.size(); ++i)
             {
                 auto& bucket = m_buckets[i];
-                std::unique_lock<std::mutex> lock(bucket.mutex);
+                std::shared_lock<std::shared_mutex> lock(bucket.mutex);
 
                 decltype(localKeys) bucketKeys;
                 for (auto& it : bucket.container)
@@ -184,10 +186,67 @@ public:
             });
     }
 
+    void asyncGetPrimaryKeyPage(std::string_view table,
+        const std::optional<storage::Condition const>& _condition, std::string_view _cursor,
+        size_t _limit,
+        std::function<void(Error::UniquePtr, std::vector<std::string>)> _callback) override
+    {
+        if (_limit == 0)
+        {
+            _callback(nullptr, std::vector<std::string>());
+            return;
+        }
+        auto localKeys = std::make_shared<LocalKeys>();
+        if (m_enableTraverse)
+        {
+#pragma omp parallel for
+            for (size_t i = 0; i < m_buckets.size(); ++i)
+            {
+                auto& bucket = m_buckets[i];
+                std::shared_lock<std::shared_mutex> lock(bucket.mutex);
+
+                LocalKeys bucketKeys;
+                for (auto& it : bucket.container)
+                {
+                    if (it.table == table && it.key > _cursor &&
+                        (!_condition || _condition->isValid(it.key)))
+                    {
+                        bucketKeys.emplace(it.key, it.entry.status());
+                    }
+                }
+
+#pragma omp critical
+                localKeys->merge(std::move(bucketKeys));
+            }
+        }
+
+        auto prev = getPrev();
+        if (!prev)
+        {
+            std::vector<std::string> resultKeys;
+            for (auto& localIt : *localKeys)
+            {
+                if (resultKeys.size() == _limit)
+                {
+                    break;
+                }
+                if (localIt.second == Entry::NORMAL || localIt.second == Entry::MODIFIED)
+                {
+                    resultKeys.push_back(localIt.first);
+                }
+            }
+            _callback(nullptr, std::move(resultKeys));
+            return;
+        }
+
+        mergePrimaryKeyPage(std::move(prev), std::string(table), _condition,
+            std::string(_cursor), _limit, std::move(localKeys), {}, std::move(_callback));
+    }
+
     void asyncGetRow(std::string_view tableView, std::string_view keyView,
         std::function<void(Error::UniquePtr, std::optional<Entry>)> _callback) override
     {
-        auto [bucket, lock] = getBucket(tableView, keyView);
+        auto [bucket, lock] = getBucketForRead(tableView, keyView);
         boost::ignore_unused(lock);
 
         auto it = bucket->container.template get<0>().find(std::make_tuple(tableView, keyView));
@@ -205,13 +264,12 @@ public:
             else
             {
                 auto optionalEntry = std::make_optional(entry);
+                lock.unlock();
                 if constexpr (enableLRU)
                 {
-                    updateMRUAndCheck(*bucket, it);
+                    tryUpdateMRU(*bucket, tableView, keyView);
                 }
 
-                lock.unlock();
-
                 STORAGE_REPORT_GET(tableView, keyView, optionalEntry, "FOUND");
                 _callback(nullptr, std::move(optionalEntry));
             }
@@ -274,7 +332,7 @@ public:
 #pragma omp parallel for
                 for (gsl::index i = 0; i < _keys.size(); ++i)
                 {
-                    auto [bucket, lock] = getBucket(tableView, _keys[i]);
+                    auto [bucket, lock] = getBucketForRead(tableView, _keys[i]);
                     boost::ignore_unused(lock);
 
                     auto it = bucket->container.find(
@@ -288,7 +346,8 @@ public:
 
                             if constexpr (enableLRU)
                             {
-                                updateMRUAndCheck(*bucket, it);
+                                lock.unlock();
+                                tryUpdateMRU(*bucket, tableView, _keys[i]);
                             }
                         }
                         else
@@ -360,6 +419,9 @@ public:
 
         ssize_t updatedCapacity = entry.size();
         std::optional<Entry> entryOld;
+        // hash the entry before locking the bucket
+        auto entryHash = m_hashImpl ? dirtyHash(tableView, keyView, entry, m_hashImpl) :
+                                      crypto::HashType();
 
         auto [bucket, lock] = getBucket(tableView, keyView);
         boost::ignore_unused(lock);
@@ -371,9 +433,13 @@ public:
             entryOld.emplace(std::move(existsEntry));
 
             updatedCapacity -= entryOld->size();
+            bucket->hash ^= (it->hash ^ entryHash);
 
             STORAGE_REPORT_SET(tableView, keyView, entry, "UPDATE");
-            bucket->container.modify(it, [&entry](Data& data) { data.entry = std::move(entry); });
+            bucket->container.modify(it, [&entry, &entryHash](Data& data) {
+                data.entry = std::move(entry);
+                data.hash = entryHash;
+            });
 
             if constexpr (enableLRU)
             {
@@ -383,7 +449,8 @@ public:
         else
         {
             bucket->container.emplace(
-                Data{std::string(tableView), std::string(keyView), std::move(entry)});
+                Data{std::string(tableView), std::string(keyView), std::move(entry), entryHash});
+            bucket->hash ^= entryHash;
 
             STORAGE_REPORT_SET(tableView, keyView, std::nullopt, "INSERT");
         }
@@ -443,6 +510,15 @@ public:
     crypto::HashType hash(const bcos::crypto::Hash::Ptr& hashImpl) const override
     {
         bcos::crypto::HashType totalHash(0);
+        if (m_hashImpl && hashImpl == m_hashImpl)
+        {
+            // the hash of the dirty entries has been folded into the buckets when writing
+            for (auto& bucket : m_buckets)
+            {
+                totalHash ^= bucket.hash;
+            }
+            return totalHash;
+        }
 
 #pragma omp parallel for
         for (size_t i = 0; i < m_buckets.size(); ++i)
@@ -452,13 +528,7 @@ public:
 
             for (auto& it : bucket.container)
             {
-                auto& entry = it.entry;
-                if (entry.dirty())
-                {
-                    auto entryHash = hashImpl->hash(it.table) ^ hashImpl->hash(it.key) ^
-                                     entry.hash(it.table, it.key, hashImpl);
-                    bucketHash ^= entryHash;
-                }
+                bucketHash ^= dirtyHash(it.table, it.key, it.entry, hashImpl);
             }
 #pragma omp critical
             totalHash ^= bucketHash;
@@ -467,6 +537,26 @@ public:
         return totalHash;
     }
 
+    // fold the hash of the dirty entries incrementally when writing, then hash() with the same
+    // hashImpl needn't traverse the storage
+    void setHashImpl(bcos::crypto::Hash::Ptr hashImpl)
+    {
+        m_hashImpl = std::move(hashImpl);
+        for (auto& bucket : m_buckets)
+        {
+            std::unique_lock<std::shared_mutex> lock(bucket.mutex);
+            bucket.hash = bcos::crypto::HashType();
+            for (auto it = bucket.container.begin(); it != bucket.container.end(); ++it)
+            {
+                auto entryHash = m_hashImpl ?
+                                     dirtyHash(it->table, it->key, it->entry, m_hashImpl) :
+                                     crypto::HashType();
+                bucket.container.modify(it, [&entryHash](Data& data) { data.hash = entryHash; });
+                bucket.hash ^= entryHash;
+            }
+        }
+    }
+
 
     void rollback(const Recoder& recoder) override
     {
@@ -495,10 +585,16 @@ public:
                     }
 
                     updateCapacity = change.entry->size() - it->entry.size();
+                    auto entryHash = m_hashImpl ? dirtyHash(change.table, change.key,
+                                                      *(change.entry), m_hashImpl) :
+                                                  crypto::HashType();
+                    bucket->hash ^= (it->hash ^ entryHash);
 
                     auto& rollbackEntry = change.entry;
-                    bucket->container.modify(it,
-                        [&rollbackEntry](Data& data) { data.entry = std::move(*rollbackEntry); });
+                    bucket->container.modify(it, [&rollbackEntry, &entryHash](Data& data) {
+                        data.entry = std::move(*rollbackEntry);
+                        data.hash = entryHash;
+                    });
                 }
                 else
                 {
@@ -509,8 +605,12 @@ public:
                             << " | " << toHex(change.entry->get());
                     }
                     updateCapacity = change.entry->size();
+                    auto entryHash = m_hashImpl ? dirtyHash(change.table, change.key,
+                                                      *(change.entry), m_hashImpl) :
+                                                  crypto::HashType();
+                    bucket->hash ^= entryHash;
                     bucket->container.emplace(
-                        Data{change.table, change.key, std::move(*(change.entry))});
+                        Data{change.table, change.key, std::move(*(change.entry)), entryHash});
                 }
             }
             else
@@ -524,6 +624,7 @@ public:
                     }
 
                     updateCapacity = 0 - it->entry.size();
+                    bucket->hash ^= it->hash;
                     bucket->container.erase(it);
                 }
                 else
@@ -582,6 +683,74 @@ private:
         return it->entry;
     }
 
+    static crypto::HashType dirtyHash(std::string_view table, std::string_view key,
+        const Entry& entry, const bcos::crypto::Hash::Ptr& hashImpl)
+    {
+        if (!entry.dirty())
+        {
+            return crypto::HashType();
+        }
+        return hashImpl->hash(table) ^ hashImpl->hash(key) ^ entry.hash(table, key, hashImpl);
+    }
+
+    using LocalKeys = std::map<std::string, storage::Entry::Status, std::less<>>;
+    // merge the sorted local keys into the pages of prev, the local deleted keys may drop some
+    // keys of a page, so more pages of prev are read until the result is full
+    static void mergePrimaryKeyPage(std::shared_ptr<StorageInterface> prev, std::string table,
+        std::optional<storage::Condition const> condition, std::string cursor, size_t limit,
+        std::shared_ptr<LocalKeys> localKeys, std::vector<std::string> result,
+        std::function<void(Error::UniquePtr, std::vector<std::string>)> callback)
+    {
+        auto remoteLimit = limit - result.size();
+        prev->asyncGetPrimaryKeyPage(table, condition, cursor, remoteLimit,
+            [prev, table, condition, limit, remoteLimit, localKeys, result = std::move(result),
+                callback = std::move(callback)](auto&& error, auto&& remoteKeys) mutable {
+                if (error)
+                {
+                    callback(BCOS_ERROR_WITH_PREV_UNIQUE_PTR(StorageError::ReadError,
+                                 "Get primary keys from prev failed!", *error),
+                        std::vector<std::string>());
+                    return;
+                }
+                // the local keys after the last remote key belong to the next page of prev
+                bool exhausted = remoteKeys.size() < remoteLimit;
+                std::string lastRemoteKey = exhausted ? std::string() : remoteKeys.back();
+                auto localIt = localKeys->begin();
+                auto localEnd =
+                    exhausted ? localKeys->end() : localKeys->upper_bound(lastRemoteKey);
+                auto remoteIt = remoteKeys.begin();
+                while ((localIt != localEnd || remoteIt != remoteKeys.end()) &&
+                       result.size() < limit)
+                {
+                    if (localIt == localEnd ||
+                        (remoteIt != remoteKeys.end() && *remoteIt < localIt->first))
+                    {
+                        result.push_back(std::move(*remoteIt));
+                        ++remoteIt;
+                        continue;
+                    }
+                    if (remoteIt != remoteKeys.end() && *remoteIt == localIt->first)
+                    {  // the local entry overrides the remote one
+                        ++remoteIt;
+                    }
+                    if (localIt->second == Entry::NORMAL || localIt->second == Entry::MODIFIED)
+                    {
+                        result.push_back(localIt->first);
+                    }
+                    ++localIt;
+                }
+                if (result.size() == limit || exhausted)
+                {
+                    callback(nullptr, std::move(result));
+                    return;
+                }
+                localKeys->erase(localKeys->begin(), localEnd);
+                mergePrimaryKeyPage(std::move(prev), std::move(table), std::move(condition),
+                    std::move(lastRemoteKey), limit, std::move(localKeys), std::move(result),
+                    std::move(callback));
+            });
+    }
+
     std::shared_ptr<StorageInterface> getPrev()
     {
         std::shared_lock<std::shared_mutex> lock(m_prevMutex);
@@ -590,6 +759,7 @@ private:
     }
 
     bool m_enableTraverse = false;
+    bcos::crypto::Hash::Ptr m_hashImpl;
 
     ssize_t m_maxCapacity = 32 * 1024 * 1024;
 
@@ -598,6 +768,8 @@ private:
         std::string table;
         std::string key;
         Entry entry;
+        // the hash of the dirty entry, folded into the bucket hash
+        crypto::HashType hash;
 
         std::tuple<std::string_view, std::string_view> view() const
         {
@@ -615,23 +787,52 @@ private:
             boost::multi_index::sequenced<>>>;
     using Container = std::conditional_t<enableLRU, LRUHashContainer, HashContainer>;
 
+    // Note: the readers share the bucket, the container and entries are only changed under the
+    // unique lock
     struct Bucket
     {
         Container container;
-        std::mutex mutex;
+        std::shared_mutex mutex;
         ssize_t capacity = 0;
+        crypto::HashType hash;
     };
     std::vector<Bucket> m_buckets;
 
-    std::tuple<Bucket*, std::unique_lock<std::mutex>> getBucket(
-        std::string_view table, std::string_view key)
+    Bucket& bucketOf(std::string_view table, std::string_view key)
     {
         auto hash = std::hash<std::string_view>{}(table);
         boost::hash_combine(hash, std::hash<std::string_view>{}(key));
-        auto index = hash % m_buckets.size();
+        return m_buckets[hash % m_buckets.size()];
+    }
 
-        auto& bucket = m_buckets[index];
-        return std::make_tuple(&bucket, std::unique_lock<std::mutex>(bucket.mutex));
+    std::tuple<Bucket*, std::unique_lock<std::shared_mutex>> getBucket(
+        std::string_view table, std::string_view key)
+    {
+        auto& bucket = bucketOf(table, key);
+        return std::make_tuple(&bucket, std::unique_lock<std::shared_mutex>(bucket.mutex));
+    }
+
+    std::tuple<Bucket*, std::shared_lock<std::shared_mutex>> getBucketForRead(
+        std::string_view table, std::string_view key)
+    {
+        auto& bucket = bucketOf(table, key);
+        return std::make_tuple(&bucket, std::shared_lock<std::shared_mutex>(bucket.mutex));
+    }
+
+    // the MRU order is only a hint for the eviction, skip it when the bucket is busy instead of
+    // blocking the reader
+    void tryUpdateMRU(Bucket& bucket, std::string_view table, std::string_view key)
+    {
+        std::unique_lock<std::shared_mutex> lock(bucket.mutex, std::try_to_lock);
+        if (!lock.owns_lock())
+        {
+            return;
+        }
+        auto it = bucket.container.find(std::make_tuple(table, key));
+        if (it != bucket.container.end())
+        {
+            updateMRUAndCheck(bucket, it);
+        }
     }
 
     void updateMRUAndCheck(
@@ -646,6 +847,7 @@ private:
         {
             auto& item = bucket.container.template get<1>().front();
             bucket.capacity -= item.entry.size();
+            bucket.hash ^= item.hash;
 
             bucket.container.template get<1>().pop_front();
             ++clearCount;
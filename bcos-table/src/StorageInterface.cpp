@@ -1,5 +1,6 @@
 #include "bcos-framework/interfaces/storage/StorageInterface.h"
 #include "bcos-framework/interfaces/storage/Table.h"
+#include <algorithm>
 #include <optional>
 
 using namespace bcos::storage;
@@ -25,6 +26,27 @@ TableInfo::ConstPtr StorageInterface::getSysTableInfo(std::string_view tableName
     return nullptr;
 }
 
+void StorageInterface::asyncGetPrimaryKeyPage(std::string_view table,
+    const std::optional<Condition const>& _condition, std::string_view _cursor, size_t _limit,
+    std::function<void(Error::UniquePtr, std::vector<std::string>)> _callback)
+{
+    // the storage without the cursor support gets all keys
+    asyncGetPrimaryKeys(table, _condition,
+        [cursor = std::string(_cursor), _limit, callback = std::move(_callback)](
+            Error::UniquePtr error, std::vector<std::string> keys) {
+            if (error)
+            {
+                callback(std::move(error), {});
+                return;
+            }
+            std::sort(keys.begin(), keys.end());
+            auto it = std::upper_bound(keys.begin(), keys.end(), cursor);
+            auto end = it + std::min(_limit, (size_t)(keys.end() - it));
+            callback(nullptr, std::vector<std::string>(
+                                  std::make_move_iterator(it), std::make_move_iterator(end)));
+        });
+}
+
 void StorageInterface::asyncCreateTable(std::string _tableName, std::string _valueFields,
     std::function<void(Error::UniquePtr, std::optional<Table>)> callback)
 {
@@ -86,6 +86,23 @@ std::vector<std::string> Table::getPrimaryKeys(std::optional<const Condition> co
     return std::get<1>(result);
 }
 
+std::vector<std::string> Table::getPrimaryKeyPage(
+    std::optional<const Condition> const& _condition, std::string_view _cursor, size_t _limit)
+{
+    std::promise<std::tuple<Error::UniquePtr, std::vector<std::string>>> promise;
+    asyncGetPrimaryKeyPage(_condition, _cursor, _limit, [&promise](auto&& error, auto&& keys) {
+        promise.set_value(std::tuple{std::move(error), std::move(keys)});
+    });
+    auto result = promise.get_future().get();
+
+    if (std::get<0>(result))
+    {
+        BOOST_THROW_EXCEPTION(*(std::get<0>(result)));
+    }
+
+    return std::get<1>(result);
+}
+
 void Table::setRow(std::string_view _key, Entry _entry)
 {
     std::promise<Error::UniquePtr> promise;
@@ -105,6 +122,14 @@ void Table::asyncGetPrimaryKeys(std::optional<const Condition> const& _condition
     m_storage->asyncGetPrimaryKeys(m_tableInfo->name(), _condition, _callback);
 }
 
+void Table::asyncGetPrimaryKeyPage(std::optional<const Condition> const& _condition,
+    std::string_view _cursor, size_t _limit,
+    std::function<void(Error::UniquePtr, std::vector<std::string>)> _callback) noexcept
+{
+    m_storage->asyncGetPrimaryKeyPage(
+        m_tableInfo->name(), _condition, _cursor, _limit, std::move(_callback));
+}
+
 void Table::asyncGetRow(std::string_view _key,
     std::function<void(Error::UniquePtr, std::optional<Entry>)> _callback) noexcept
 {
@@ -1,4 +1,5 @@
 #include "Hash.h"
+#include "bcos-table/src/KeyPageStorage.h"
 #include "bcos-table/src/StateStorage.h"
 #include <bcos-utilities/Common.h>
 #include <bcos-utilities/testutils/TestPromptFixture.h>
@@ -128,6 +129,40 @@ BOOST_AUTO_TEST_CASE(asyncToSyncGet)
     std::cout << "asyncToSync cost: " << bcos::utcSteadyTime() - now << std::endl;
 }
 
+BOOST_AUTO_TEST_CASE(pageDecode)
+{
+    // a page of 8KB with 64 entries
+    KeyPageStorage::Page page;
+    for (size_t i = 0; i < 64; ++i)
+    {
+        Entry entry;
+        entry.set(std::string(96, 'v'));
+        page.setEntry("key_" + boost::lexical_cast<std::string>(1000 + i), std::move(entry));
+    }
+    auto pageKey = page.endKey();
+    Entry legacy;
+    legacy.setObject(page);
+    auto legacyPage = std::string(legacy.get());
+    auto flatPage = page.encode();
+
+    size_t decodeCount = count / 10;
+    for (auto& [name, encoded] : std::initializer_list<std::pair<std::string, std::string>>{
+             {"boost::serialization", legacyPage}, {"flat", flatPage}})
+    {
+        auto now = bcos::utcSteadyTime();
+        for (size_t i = 0; i < decodeCount; ++i)
+        {
+            // decode the page and read one entry, like a page miss
+            KeyPageStorage::Page decoded(encoded, pageKey);
+            auto entry = decoded.getEntry("key_" + boost::lexical_cast<std::string>(1000 + i % 64));
+            BOOST_CHECK(entry);
+        }
+        auto cost = bcos::utcSteadyTime() - now;
+        std::cout << name << " page decode cost: " << cost << "ms, "
+                  << decodeCount * 1000 / std::max<int64_t>(cost, 1) << " pages/s" << std::endl;
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }  // namespace bcos::test
@@ -2471,6 +2471,203 @@ BOOST_AUTO_TEST_CASE(pageMergeBig)
         }
     }
 }
+BOOST_AUTO_TEST_CASE(pageEncoding)
+{
+    KeyPageStorage::Page page;
+    auto keyOf = [](size_t i) { return (boost::format("key_%04d") % i).str(); };
+    for (size_t i = 0; i < 100; ++i)
+    {
+        Entry entry;
+        entry.set(std::string(i, 'v'));
+        page.setEntry(keyOf(i), std::move(entry));
+    }
+    Entry deleted;
+    deleted.setStatus(Entry::Status::DELETED);
+    page.setEntry(keyOf(50), std::move(deleted));
+    auto pageKey = page.endKey();
+
+    Entry legacy;
+    legacy.setObject(page);
+    auto flat = page.encode();
+    BOOST_REQUIRE_NE(flat, std::string(legacy.get()));
+
+    for (auto& encoded : {std::string(legacy.get()), flat})
+    {
+        KeyPageStorage::Page decoded(encoded, pageKey);
+        BOOST_CHECK_EQUAL(decoded.count(), 99);
+        BOOST_CHECK_EQUAL(decoded.validCount(), 99);
+        BOOST_CHECK_EQUAL(decoded.startKey(), keyOf(0));
+        BOOST_CHECK_EQUAL(decoded.endKey(), keyOf(99));
+        BOOST_CHECK(decoded.invalidKeySet().empty());
+        for (size_t i = 0; i < 100; ++i)
+        {
+            auto entry = decoded.getEntry(keyOf(i));
+            if (i == 50)
+            {
+                BOOST_CHECK(!entry);
+                continue;
+            }
+            BOOST_REQUIRE(entry);
+            BOOST_CHECK_EQUAL(entry->get(), std::string(i, 'v'));
+            BOOST_CHECK_EQUAL(entry->status(), Entry::Status::NORMAL);
+        }
+        BOOST_CHECK(!decoded.getEntry("key_"));
+        BOOST_CHECK(!decoded.getEntry("key_9999"));
+        // both formats are encoded to the same flat page
+        BOOST_CHECK_EQUAL(decoded.encode(), flat);
+
+        Entry entry;
+        entry.set(std::string("new value"));
+        decoded.setEntry(keyOf(0), std::move(entry));
+        BOOST_CHECK_EQUAL(decoded.getEntry(keyOf(0))->get(), "new value");
+        BOOST_CHECK_EQUAL(decoded.getEntry(keyOf(99))->get(), std::string(99, 'v'));
+        BOOST_CHECK_EQUAL(decoded.count(), 99);
+    }
+
+    KeyPageStorage::TableMeta meta;
+    meta.insertPageInfo(KeyPageStorage::PageInfo("key_1", 10, 1000, nullptr));
+    meta.insertPageInfo(KeyPageStorage::PageInfo("key_2", 0, 0, nullptr));
+    meta.insertPageInfo(KeyPageStorage::PageInfo("key_3", 20, 2000, nullptr));
+    Entry legacyMeta;
+    legacyMeta.setObject(meta);
+    auto flatMeta = meta.encode();
+    for (auto& encoded : {std::string(legacyMeta.get()), flatMeta})
+    {
+        KeyPageStorage::TableMeta decoded(encoded);
+        auto& pages = decoded.getAllPageInfoNoLock();
+        // the empty page is removed when encoding
+        BOOST_REQUIRE_EQUAL(pages.size(), 2);
+        BOOST_CHECK_EQUAL(pages[0].getPageKey(), "key_1");
+        BOOST_CHECK_EQUAL(pages[0].getCount(), 10);
+        BOOST_CHECK_EQUAL(pages[0].getSize(), 1000);
+        BOOST_CHECK_EQUAL(pages[1].getPageKey(), "key_3");
+        BOOST_CHECK_EQUAL(pages[1].getCount(), 20);
+        BOOST_CHECK_EQUAL(pages[1].getSize(), 2000);
+        BOOST_CHECK_EQUAL(decoded.encode(), flatMeta);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(adaptivePageSize)
+{
+    auto statistics = std::make_shared<KeyPageStatistics>(4096);
+    auto storage = std::make_shared<KeyPageStorage>(memoryStorage, 4096, nullptr, statistics);
+    auto writeTable = storage->createTable("t_write", valueField);
+    auto readTable = storage->createTable("t_read", valueField);
+    auto largeTable = storage->createTable("t_large", valueField);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        auto key = boost::lexical_cast<std::string>(i);
+        Entry entry;
+        entry.importFields({std::string(10, 'v')});
+        writeTable->setRow(key, entry);
+        if (i < 10)
+        {
+            readTable->setRow(key, entry);
+        }
+        Entry large;
+        large.importFields({std::string(1000, 'v')});
+        largeTable->setRow(key, large);
+    }
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        BOOST_REQUIRE(readTable->getRow(boost::lexical_cast<std::string>(i % 10)));
+    }
+    BOOST_CHECK_EQUAL(statistics->pageSize("t_write"), 4096);
+    storage->updateStatistics(m_blockNumber);
+
+    BOOST_CHECK_EQUAL(statistics->pageSize("t_write"), 2048);
+    BOOST_CHECK_EQUAL(statistics->pageSize("t_read"), 8192);
+    // the page should contain at least 8 entries
+    BOOST_CHECK_GE(statistics->pageSize("t_large"), 8000);
+    BOOST_CHECK_GT(statistics->writtenBytes("t_write"), 100 * 10);
+    BOOST_CHECK_EQUAL(statistics->writtenBytes("t_unknown"), 0);
+
+    // the retried prepare of the same block replaces the statistics
+    auto writtenBytes = statistics->writtenBytes("t_write");
+    storage->updateStatistics(m_blockNumber);
+    BOOST_CHECK_EQUAL(statistics->pageSize("t_write"), 2048);
+    BOOST_CHECK_EQUAL(statistics->pageSize("t_read"), 8192);
+    BOOST_CHECK_EQUAL(statistics->writtenBytes("t_write"), writtenBytes);
+
+    // the next block uses the adapted page size
+    auto next = std::make_shared<KeyPageStorage>(storage, 4096, nullptr, statistics);
+    auto nextTable = next->openTable("t_write");
+    BOOST_REQUIRE(nextTable);
+    for (size_t i = 100; i < 400; ++i)
+    {
+        Entry entry;
+        entry.importFields({std::string(10, 'v')});
+        nextTable->setRow(boost::lexical_cast<std::string>(i), entry);
+    }
+    for (size_t i = 0; i < 400; ++i)
+    {
+        BOOST_REQUIRE(nextTable->getRow(boost::lexical_cast<std::string>(i)));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(retriedStatistics)
+{
+    KeyPageStatistics statistics(4096);
+    // read mostly block
+    statistics.update(1, "t_test", 100, 0, 0, 0);
+    BOOST_CHECK_EQUAL(statistics.pageSize("t_test"), 8192);
+    // the write only block moves the average back to the default page size
+    statistics.update(2, "t_test", 0, 100, 100 * 10, 2000);
+    BOOST_CHECK_EQUAL(statistics.pageSize("t_test"), 4096);
+    // prepared again with the same counters, the block is not folded twice
+    for (size_t i = 0; i < 10; ++i)
+    {
+        statistics.update(2, "t_test", 0, 100, 100 * 10, 2000);
+    }
+    BOOST_CHECK_EQUAL(statistics.pageSize("t_test"), 4096);
+    BOOST_CHECK_EQUAL(statistics.writtenBytes("t_test"), 2000);
+    // the retry replaces the counters of the block
+    statistics.update(2, "t_test", 100, 0, 0, 0);
+    BOOST_CHECK_EQUAL(statistics.pageSize("t_test"), 8192);
+    BOOST_CHECK_EQUAL(statistics.writtenBytes("t_test"), 0);
+}
+
+BOOST_AUTO_TEST_CASE(primaryKeyPage)
+{
+    auto keyOf = [](size_t i) { return (boost::format("key_%04d") % i).str(); };
+    auto storage = std::make_shared<KeyPageStorage>(memoryStorage, 4096);
+    auto table = storage->createTable("t_page", valueField);
+    BOOST_REQUIRE(table);
+    for (size_t i = 0; i < 2000; ++i)
+    {
+        auto entry = table->newEntry();
+        entry.setField(0, std::string(100, 'v'));
+        table->setRow(keyOf(i), std::move(entry));
+    }
+    for (size_t i = 500; i < 700; ++i)
+    {
+        table->setRow(keyOf(i), table->newDeletedEntry());
+    }
+
+    Condition c;
+    c.NE(keyOf(1000));
+    std::vector<std::string> pagedKeys;
+    std::string cursor;
+    while (true)
+    {
+        auto page = table->getPrimaryKeyPage(c, cursor, 128);
+        BOOST_CHECK_LE(page.size(), 128);
+        pagedKeys.insert(pagedKeys.end(), page.begin(), page.end());
+        if (page.size() < 128)
+        {
+            break;
+        }
+        cursor = page.back();
+    }
+    BOOST_REQUIRE_EQUAL(pagedKeys.size(), 2000 - 200 - 1);
+    BOOST_CHECK(std::is_sorted(pagedKeys.begin(), pagedKeys.end()));
+    BOOST_CHECK_EQUAL(pagedKeys.front(), keyOf(0));
+    BOOST_CHECK_EQUAL(pagedKeys[500], keyOf(700));
+    BOOST_CHECK_EQUAL(pagedKeys.back(), keyOf(1999));
+    BOOST_CHECK(table->getPrimaryKeyPage(std::nullopt, keyOf(1999), 128).empty());
+    BOOST_CHECK_EQUAL(table->getPrimaryKeyPage(std::nullopt, keyOf(1500), 0).size(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 }  // namespace test
 }  // namespace bcos
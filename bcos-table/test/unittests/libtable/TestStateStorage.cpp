@@ -34,6 +34,7 @@
 #include <optional>
 #include <random>
 #include <string>
+#include <thread>
 
 using namespace std;
 using namespace bcos;
@@ -1145,6 +1146,79 @@ BOOST_AUTO_TEST_CASE(randomRWHash)
     }
 }
 
+BOOST_AUTO_TEST_CASE(incrementalHash)
+{
+    auto prev = std::make_shared<StateStorage>(nullptr);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        Entry entry;
+        entry.importFields({"prev" + boost::lexical_cast<std::string>(i)});
+        prev->asyncSetRow("t_prev", boost::lexical_cast<std::string>(i), std::move(entry),
+            [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+    }
+    prev->setReadOnly(true);
+
+    auto storage = std::make_shared<StateStorage>(prev);
+    storage->setHashImpl(hashImpl);
+    // another instance of the same hash, hash() with it traverses the whole storage
+    auto fullHashImpl = make_shared<Header256Hash>();
+    auto checkHash = [&]() {
+        auto hash = storage->hash(hashImpl);
+        BOOST_CHECK_EQUAL(hash.hex(), storage->hash(fullHashImpl).hex());
+        return hash;
+    };
+
+    std::mt19937 random(1024);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        auto table = "t_" + boost::lexical_cast<std::string>(random() % 5);
+        auto key = boost::lexical_cast<std::string>(random() % 200);
+        Entry entry;
+        if (random() % 4 == 0)
+        {
+            entry.setStatus(Entry::DELETED);
+        }
+        else
+        {
+            entry.importFields({boost::lexical_cast<std::string>(random())});
+        }
+        storage->asyncSetRow(
+            table, key, std::move(entry), [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+    }
+    // import the clean entries from prev
+    for (size_t i = 0; i < 100; i += 3)
+    {
+        storage->asyncGetRow("t_prev", boost::lexical_cast<std::string>(i),
+            [](Error::UniquePtr error, std::optional<Entry> entry) {
+                BOOST_CHECK(!error);
+                BOOST_CHECK(entry);
+            });
+    }
+    auto hash = checkHash();
+    BOOST_CHECK_NE(hash.hex(), crypto::HashType().hex());
+
+    auto recoder = std::make_shared<Recoder>();
+    storage->setRecoder(recoder);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        auto table = (i % 2) ? "t_prev" : "t_" + boost::lexical_cast<std::string>(random() % 5);
+        auto key = boost::lexical_cast<std::string>(random() % 200);
+        Entry entry;
+        entry.importFields({boost::lexical_cast<std::string>(random())});
+        storage->asyncSetRow(
+            table, key, std::move(entry), [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+    }
+    BOOST_CHECK_NE(checkHash().hex(), hash.hex());
+
+    storage->rollback(*recoder);
+    BOOST_CHECK_EQUAL(checkHash().hex(), hash.hex());
+
+    // reset the hashImpl after writing
+    storage->setHashImpl(fullHashImpl);
+    BOOST_CHECK_EQUAL(storage->hash(fullHashImpl).hex(), hash.hex());
+    BOOST_CHECK_EQUAL(storage->hash(hashImpl).hex(), hash.hex());
+}
+
 BOOST_AUTO_TEST_CASE(hash_map)
 {
     class EntryKey
@@ -1219,6 +1293,125 @@ BOOST_AUTO_TEST_CASE(hash_map)
     BOOST_CHECK(data.find(findIt, EntryKey("table", std::string_view("key"))));
 }
 
+BOOST_AUTO_TEST_CASE(concurrentReadWriteLRU)
+{
+    auto storage = std::make_shared<LRUStateStorage>(nullptr);
+    storage->setMaxCapacity(1024 * 1024);
+    std::string tableName = "t_concurrent";
+    size_t keys = 1000;
+    for (size_t i = 0; i < keys; ++i)
+    {
+        Entry entry;
+        entry.importFields({boost::lexical_cast<std::string>(i)});
+        storage->asyncSetRow(tableName, boost::lexical_cast<std::string>(i), std::move(entry),
+            [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+    }
+
+    std::atomic<size_t> wrongValues = 0;
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < 8; ++t)
+    {
+        workers.emplace_back([&, t]() {
+            for (size_t i = 0; i < 10000; ++i)
+            {
+                auto key = boost::lexical_cast<std::string>((i * 7 + t) % keys);
+                if (t % 4 == 0)
+                {
+                    // the value is always the same as the key
+                    Entry entry;
+                    entry.importFields({key});
+                    storage->asyncSetRow(tableName, key, std::move(entry),
+                        [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+                    continue;
+                }
+                storage->asyncGetRow(
+                    tableName, key, [&](Error::UniquePtr error, std::optional<Entry> entry) {
+                        if (error || !entry || entry->get() != key)
+                        {
+                            ++wrongValues;
+                        }
+                    });
+            }
+        });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    BOOST_CHECK_EQUAL(wrongValues.load(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(primaryKeyPage)
+{
+    auto storage1 = std::make_shared<StateStorage>(nullptr);
+    storage1->setEnableTraverse(true);
+    auto keyOf = [](size_t i) { return (boost::format("key_%04d") % i).str(); };
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        Entry entry;
+        entry.importFields({"value"});
+        storage1->asyncSetRow("table", keyOf(i), std::move(entry),
+            [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+    }
+
+    // the deleted keys span more than one page of prev
+    auto storage2 = std::make_shared<StateStorage>(storage1);
+    storage2->setEnableTraverse(true);
+    for (size_t i = 100; i < 400; ++i)
+    {
+        Entry deleted;
+        deleted.setStatus(Entry::DELETED);
+        storage2->asyncSetRow("table", keyOf(i), std::move(deleted),
+            [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+    }
+    for (size_t i = 0; i < 1000; i += 10)
+    {
+        Entry entry;
+        entry.importFields({"value"});
+        storage2->asyncSetRow("table", keyOf(i) + "_new", std::move(entry),
+            [](Error::UniquePtr error) { BOOST_CHECK(!error); });
+    }
+
+    auto storage3 = std::make_shared<StateStorage>(storage2);
+    Condition range;
+    range.GT(keyOf(50));
+    range.LT(keyOf(900));
+    for (auto withCondition : {false, true})
+    {
+        auto c = withCondition ? std::optional<Condition const>(range) : std::nullopt;
+        std::vector<std::string> allKeys;
+        storage3->asyncGetPrimaryKeys(
+            "table", c, [&](Error::UniquePtr error, std::vector<std::string> keys) {
+                BOOST_CHECK(!error);
+                allKeys = std::move(keys);
+            });
+        std::sort(allKeys.begin(), allKeys.end());
+        BOOST_CHECK_EQUAL(allKeys.size(), c ? 849 - 300 + 85 : 1000 - 300 + 100);
+
+        std::vector<std::string> pagedKeys;
+        std::string cursor;
+        for (size_t pages = 0;; ++pages)
+        {
+            BOOST_REQUIRE_LT(pages, 100);
+            std::vector<std::string> page;
+            storage3->asyncGetPrimaryKeyPage(
+                "table", c, cursor, 64, [&](Error::UniquePtr error, std::vector<std::string> keys) {
+                    BOOST_CHECK(!error);
+                    page = std::move(keys);
+                });
+            BOOST_CHECK_LE(page.size(), 64);
+            pagedKeys.insert(pagedKeys.end(), page.begin(), page.end());
+            if (page.size() < 64)
+            {
+                break;
+            }
+            cursor = page.back();
+        }
+        BOOST_CHECK_EQUAL_COLLECTIONS(
+            pagedKeys.begin(), pagedKeys.end(), allKeys.begin(), allKeys.end());
+    }
+}
+
 BOOST_AUTO_TEST_CASE(importPrev) {}
 
 BOOST_AUTO_TEST_SUITE_END()
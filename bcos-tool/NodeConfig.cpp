@@ -57,6 +57,7 @@ void NodeConfig::loadConfig(boost::property_tree::ptree const& _pt, bool _enforc
     loadSealerConfig(_pt);
     loadStorageConfig(_pt);
     loadConsensusConfig(_pt);
+    loadExecutorRuntimeConfig(_pt);
 }
 
 void NodeConfig::loadGenesisConfig(boost::property_tree::ptree const& _genesisConfig)
@@ -298,6 +299,14 @@ void NodeConfig::loadTxPoolConfig(boost::property_tree::ptree const& _pt)
         BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
                                   "Please set txpool.verify_worker_num to positive !"));
     }
+    // the txs are sharded by the txHash, every shard is locked separately
+    auto shardsNum = checkAndGetValue(_pt, "txpool.shards_num", "16");
+    if (shardsNum <= 0)
+    {
+        BOOST_THROW_EXCEPTION(
+            InvalidConfig() << errinfo_comment("Please set txpool.shards_num to positive !"));
+    }
+    m_txpoolShardsNum = shardsNum;
     // the txs expiration time, in second
     auto txsExpirationTime = checkAndGetValue(_pt, "txpool.txs_expiration_time", "600");
     if (txsExpirationTime * 1000 <= DEFAULT_MIN_CONSENSUS_TIME_MS)
@@ -314,10 +323,57 @@ void NodeConfig::loadTxPoolConfig(boost::property_tree::ptree const& _pt)
     {
         m_txsExpirationTime = txsExpirationTime * 1000;
     }
+    // the seal order of the txs: import_time or priority
+    auto sealOrder = _pt.get<std::string>("txpool.seal_order", "import_time");
+    boost::trim(sealOrder);
+    if (sealOrder != "import_time" && sealOrder != "priority")
+    {
+        BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                  "Please set txpool.seal_order to import_time or priority!"));
+    }
+    m_txsPrioritySealOrder = (sealOrder == "priority");
+    // the priority of the senders, in format of address1:priority1,address2:priority2
+    auto prioritySenders = _pt.get<std::string>("txpool.priority_senders", "");
+    boost::trim(prioritySenders);
+    if (!prioritySenders.empty())
+    {
+        std::vector<std::string> senderList;
+        boost::split(senderList, prioritySenders, boost::is_any_of(","));
+        for (auto& senderInfo : senderList)
+        {
+            std::vector<std::string> senderPriority;
+            boost::split(senderPriority, senderInfo, boost::is_any_of(":"));
+            if (senderPriority.size() != 2)
+            {
+                BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                          "Invalid txpool.priority_senders: " + senderInfo));
+            }
+            auto sender = senderPriority[0];
+            boost::trim(sender);
+            boost::to_lower(sender);
+            if (sender.find("0x") == 0)
+            {
+                sender = sender.substr(2);
+            }
+            boost::trim(senderPriority[1]);
+            auto priority = boost::lexical_cast<int>(senderPriority[1]);
+            if (priority < 0 || priority > UINT8_MAX)
+            {
+                BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                          "The priority of txpool.priority_senders should be in "
+                                          "[0, 255]: " +
+                                          senderInfo));
+            }
+            m_txsSenderPriority[sender] = (uint8_t)priority;
+        }
+    }
     NodeConfig_LOG(INFO) << LOG_DESC("loadTxPoolConfig") << LOG_KV("txpoolLimit", m_txpoolLimit)
                          << LOG_KV("notifierWorkers", m_notifyWorkerNum)
                          << LOG_KV("verifierWorkers", m_verifierWorkerNum)
-                         << LOG_KV("txsExpirationTime(ms)", m_txsExpirationTime);
+                         << LOG_KV("shardsNum", m_txpoolShardsNum)
+                         << LOG_KV("txsExpirationTime(ms)", m_txsExpirationTime)
+                         << LOG_KV("sealOrder", sealOrder)
+                         << LOG_KV("prioritySenders", m_txsSenderPriority.size());
 }
 
 void NodeConfig::loadChainConfig(boost::property_tree::ptree const& _pt)
@@ -413,10 +469,54 @@ void NodeConfig::loadStorageConfig(boost::property_tree::ptree const& _pt)
     boost::split(m_pd_addrs, pd_addrs, boost::is_any_of(","));
     m_enableLRUCacheStorage = _pt.get<bool>("storage.enable_cache", true);
     m_cacheSize = _pt.get<ssize_t>("storage.cache_size", DEFAULT_CACHE_SIZE);
+    m_enableRocksDBPrefixBloom = _pt.get<bool>("storage.prefix_bloom", true);
+    m_rocksDBBloomBitsPerKey = _pt.get<int>("storage.bloom_bits_per_key", 10);
+    if (m_rocksDBBloomBitsPerKey < 0 || m_rocksDBBloomBitsPerKey > 32)
+    {
+        BOOST_THROW_EXCEPTION(
+            InvalidConfig() << errinfo_comment("Please set storage.bloom_bits_per_key in 0~32"));
+    }
+    // in MB
+    auto blockCacheSize = _pt.get<int64_t>("storage.block_cache_size", 512);
+    if (blockCacheSize < 0)
+    {
+        BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                  "Please set storage.block_cache_size to a non-negative value"));
+    }
+    m_rocksDBBlockCacheSize = blockCacheSize * 1024 * 1024;
+    m_pinRocksDBL0FilterAndIndex = _pt.get<bool>("storage.pin_l0_filter_and_index", true);
+    m_enableValueCompression = _pt.get<bool>("storage.compress_value", false);
+    auto compressThreshold = _pt.get<int64_t>("storage.compress_threshold", 1024);
+    if (compressThreshold < 0)
+    {
+        BOOST_THROW_EXCEPTION(InvalidConfig() << errinfo_comment(
+                                  "Please set storage.compress_threshold to a non-negative value"));
+    }
+    m_valueCompressionThreshold = compressThreshold;
+    m_valueCompressionLevel = _pt.get<int>("storage.compress_level", 3);
+    if (m_valueCompressionLevel < 1 || m_valueCompressionLevel > 19)
+    {
+        BOOST_THROW_EXCEPTION(
+            InvalidConfig() << errinfo_comment("Please set storage.compress_level in 1~19"));
+    }
     NodeConfig_LOG(INFO) << LOG_DESC("loadStorageConfig") << LOG_KV("storagePath", m_storagePath)
                          << LOG_KV("KeyPage", m_keyPageSize) << LOG_KV("storageType", m_storageType)
                          << LOG_KV("pd_addrs", pd_addrs)
-                         << LOG_KV("enableLRUCacheStorage", m_enableLRUCacheStorage);
+                         << LOG_KV("enableLRUCacheStorage", m_enableLRUCacheStorage)
+                         << LOG_KV("prefixBloom", m_enableRocksDBPrefixBloom)
+                         << LOG_KV("bloomBitsPerKey", m_rocksDBBloomBitsPerKey)
+                         << LOG_KV("blockCacheSize(MB)", blockCacheSize)
+                         << LOG_KV("pinL0FilterAndIndex", m_pinRocksDBL0FilterAndIndex)
+                         << LOG_KV("compressValue", m_enableValueCompression)
+                         << LOG_KV("compressThreshold", m_valueCompressionThreshold)
+                         << LOG_KV("compressLevel", m_valueCompressionLevel);
+}
+
+void NodeConfig::loadExecutorRuntimeConfig(boost::property_tree::ptree const& _pt)
+{
+    m_optimisticExecution = _pt.get<bool>("executor.enable_optimistic_execution", false);
+    NodeConfig_LOG(INFO) << LOG_DESC("loadExecutorRuntimeConfig")
+                         << LOG_KV("optimisticExecution", m_optimisticExecution);
 }
 
 // Note: In components that do not require failover, do not need to set member_id
@@ -27,6 +27,7 @@
 #include <bcos-framework/interfaces/protocol/Protocol.h>
 #include <boost/property_tree/ini_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
+#include <map>
 
 #define NodeConfig_LOG(LEVEL) BCOS_LOG(LEVEL) << LOG_BADGE("NodeConfig")
 namespace bcos
@@ -90,6 +91,11 @@ public:
     size_t notifyWorkerNum() const { return m_notifyWorkerNum; }
     size_t verifierWorkerNum() const { return m_verifierWorkerNum; }
     int64_t txsExpirationTime() const { return m_txsExpirationTime; }
+    size_t txpoolShardsNum() const { return m_txpoolShardsNum; }
+    // seal the txs in the order of importing or priority
+    bool txsPrioritySealOrder() const { return m_txsPrioritySealOrder; }
+    // the hex address of the sender => priority
+    std::map<std::string, uint8_t> const& txsSenderPriority() const { return m_txsSenderPriority; }
 
     bool smCryptoType() const { return m_smCryptoType; }
     std::string const& chainId() const { return m_chainId; }
@@ -119,6 +125,7 @@ public:
     bool isWasm() const { return m_isWasm; }
     bool isAuthCheck() const { return m_isAuthCheck; }
     std::string const& authAdminAddress() const { return m_authAdminAddress; }
+    bool optimisticExecution() const { return m_optimisticExecution; }
 
     std::string const& rpcServiceName() const { return m_rpcServiceName; }
     std::string const& gatewayServiceName() const { return m_gatewayServiceName; }
@@ -179,6 +186,14 @@ public:
     bool enableLRUCacheStorage() const { return m_enableLRUCacheStorage; }
     ssize_t cacheSize() const { return m_cacheSize; }
 
+    bool enableRocksDBPrefixBloom() const { return m_enableRocksDBPrefixBloom; }
+    int rocksDBBloomBitsPerKey() const { return m_rocksDBBloomBitsPerKey; }
+    size_t rocksDBBlockCacheSize() const { return m_rocksDBBlockCacheSize; }
+    bool pinRocksDBL0FilterAndIndex() const { return m_pinRocksDBL0FilterAndIndex; }
+    bool enableValueCompression() const { return m_enableValueCompression; }
+    size_t valueCompressionThreshold() const { return m_valueCompressionThreshold; }
+    int valueCompressionLevel() const { return m_valueCompressionLevel; }
+
     uint32_t compatibilityVersion() const { return m_compatibilityVersion; }
     std::string const& compatibilityVersionStr() const { return m_compatibilityVersionStr; }
 
@@ -204,6 +219,7 @@ protected:
 
     virtual void loadStorageConfig(boost::property_tree::ptree const& _pt);
     virtual void loadConsensusConfig(boost::property_tree::ptree const& _pt);
+    virtual void loadExecutorRuntimeConfig(boost::property_tree::ptree const& _pt);
     virtual void loadFailOverConfig(
         boost::property_tree::ptree const& _pt, bool _enforceMemberID = true);
 
@@ -234,6 +250,9 @@ private:
     size_t m_notifyWorkerNum;
     size_t m_verifierWorkerNum;
     int64_t m_txsExpirationTime;
+    size_t m_txpoolShardsNum = 16;
+    bool m_txsPrioritySealOrder = false;
+    std::map<std::string, uint8_t> m_txsSenderPriority;
     // TODO: the block sync module need some configurations?
 
     // chain configuration
@@ -273,6 +292,8 @@ private:
     bool m_isWasm = false;
     bool m_isAuthCheck = false;
     std::string m_authAdminAddress;
+    // execute the leading transactions of every contract in parallel optimistically before DMC
+    bool m_optimisticExecution = false;
 
     std::string m_rpcServiceName;
     std::string m_gatewayServiceName;
@@ -312,6 +333,14 @@ private:
 
     bool m_enableLRUCacheStorage = true;
     ssize_t m_cacheSize = DEFAULT_CACHE_SIZE;  // 32MB for default
+    // the read tuning of rocksdb
+    bool m_enableRocksDBPrefixBloom = true;
+    int m_rocksDBBloomBitsPerKey = 10;
+    size_t m_rocksDBBlockCacheSize = 512 * 1024 * 1024;
+    bool m_pinRocksDBL0FilterAndIndex = true;
+    bool m_enableValueCompression = false;
+    size_t m_valueCompressionThreshold = 1024;
+    int m_valueCompressionLevel = 3;
     uint32_t m_compatibilityVersion;
     std::string m_compatibilityVersionStr;
 
@@ -66,9 +66,23 @@ void TxPool::stop()
 
 void TxPool::asyncSubmit(bytesPointer _txData, TxSubmitCallback _txSubmitCallback)
 {
-    // verify and try to submit the valid transaction
+    {
+        Guard l(x_pendingTxs);
+        m_pendingTxs.emplace_back(_txData, _txSubmitCallback);
+        // the txs will be submitted by the scheduled task together
+        if (m_pendingTxs.size() > 1)
+        {
+            return;
+        }
+    }
+    scheduleSubmitPendingTxs();
+}
+
+void TxPool::scheduleSubmitPendingTxs()
+{
+    // verify and try to submit the valid transactions
     auto self = std::weak_ptr<TxPool>(shared_from_this());
-    m_worker->enqueue([self, _txData, _txSubmitCallback]() {
+    m_worker->enqueue([self]() {
         try
         {
             auto txpool = self.lock();
@@ -76,12 +90,7 @@ void TxPool::asyncSubmit(bytesPointer _txData, TxSubmitCallback _txSubmitCallbac
             {
                 return;
             }
-            auto txpoolStorage = txpool->m_txpoolStorage;
-            if (!txpool->checkExistsInGroup(_txSubmitCallback))
-            {
-                return;
-            }
-            txpoolStorage->submitTransaction(_txData, _txSubmitCallback);
+            txpool->submitPendingTxs();
         }
         catch (std::exception const& e)
         {
@@ -91,6 +100,45 @@ void TxPool::asyncSubmit(bytesPointer _txData, TxSubmitCallback _txSubmitCallbac
     });
 }
 
+void TxPool::submitPendingTxs()
+{
+    TxSubmitRequests requests;
+    {
+        Guard l(x_pendingTxs);
+        if (m_pendingTxs.size() <= c_maxSubmitBatchSize)
+        {
+            requests.swap(m_pendingTxs);
+        }
+        else
+        {
+            auto end = m_pendingTxs.begin() + c_maxSubmitBatchSize;
+            requests.assign(std::make_move_iterator(m_pendingTxs.begin()),
+                std::make_move_iterator(end));
+            m_pendingTxs.erase(m_pendingTxs.begin(), end);
+        }
+    }
+    // submit the remaining txs in another task
+    if (requests.size() == c_maxSubmitBatchSize)
+    {
+        scheduleSubmitPendingTxs();
+    }
+    TxSubmitRequests validRequests;
+    validRequests.reserve(requests.size());
+    for (auto& request : requests)
+    {
+        if (!checkExistsInGroup(request.second))
+        {
+            continue;
+        }
+        validRequests.emplace_back(std::move(request));
+    }
+    if (validRequests.empty())
+    {
+        return;
+    }
+    m_txpoolStorage->batchSubmitTransaction(validRequests);
+}
+
 bool TxPool::checkExistsInGroup(TxSubmitCallback _txSubmitCallback)
 {
     auto syncConfig = m_transactionSync->config();
@@ -142,6 +142,9 @@ public:
 
 protected:
     virtual bool checkExistsInGroup(bcos::protocol::TxSubmitCallback _txSubmitCallback);
+    // submit the txs accumulated by asyncSubmit in batch
+    virtual void scheduleSubmitPendingTxs();
+    virtual void submitPendingTxs();
     virtual void getTxsFromLocalLedger(bcos::crypto::HashListPtr _txsHash,
         bcos::crypto::HashListPtr _missedTxs,
         std::function<void(Error::Ptr, bcos::protocol::TransactionsPtr)> _onBlockFilled);
@@ -169,6 +172,11 @@ private:
     ThreadPool::Ptr m_filler;
     ThreadPool::Ptr m_txsResultNotifier;
     std::atomic_bool m_running = {false};
+
+    // the txs received from the sdk that wait to be verified and submitted in batch
+    TxSubmitRequests m_pendingTxs;
+    mutable Mutex x_pendingTxs;
+    size_t c_maxSubmitBatchSize = 1000;
 };
 }  // namespace txpool
 }  // namespace bcos
@@ -27,10 +27,22 @@
 #include <bcos-framework/interfaces/protocol/BlockFactory.h>
 #include <bcos-framework/interfaces/protocol/TransactionMetaData.h>
 #include <bcos-framework/interfaces/protocol/TransactionSubmitResultFactory.h>
+#include <map>
+#include <string_view>
 namespace bcos
 {
 namespace txpool
 {
+// the order of sealing the txs of the txpool
+enum class TxsSealOrder : uint8_t
+{
+    // seal the txs in the order of importing
+    ImportTime = 0,
+    // seal the txs of the higher priority senders first, the txs with the same priority are sealed
+    // in the order of importing
+    Priority = 1,
+};
+
 class TxPoolConfig
 {
 public:
@@ -73,6 +85,30 @@ public:
     std::shared_ptr<bcos::ledger::LedgerInterface> ledger() { return m_ledger; }
     int64_t blockLimit() const { return m_blockLimit; }
 
+    void setTxsSealOrder(TxsSealOrder _txsSealOrder) { m_txsSealOrder = _txsSealOrder; }
+    TxsSealOrder txsSealOrder() const { return m_txsSealOrder; }
+
+    // Note: the sender is the address bytes, the txs of unknown senders are in priority 0
+    void setSenderPriority(std::string const& _sender, uint8_t _priority)
+    {
+        WriteGuard l(x_senderPriority);
+        m_senderPriority[_sender] = _priority;
+    }
+    uint8_t senderPriority(std::string_view _sender) const
+    {
+        ReadGuard l(x_senderPriority);
+        if (m_senderPriority.empty())
+        {
+            return 0;
+        }
+        auto it = m_senderPriority.find(_sender);
+        if (it == m_senderPriority.end())
+        {
+            return 0;
+        }
+        return it->second;
+    }
+
 private:
     TxValidatorInterface::Ptr m_txValidator;
     bcos::protocol::TransactionSubmitResultFactory::Ptr m_txResultFactory;
@@ -81,6 +117,9 @@ private:
     NonceCheckerInterface::Ptr m_txPoolNonceChecker;
     size_t m_poolLimit = 15000;
     int64_t m_blockLimit = 1000;
+    std::atomic<TxsSealOrder> m_txsSealOrder = {TxsSealOrder::ImportTime};
+    std::map<std::string, uint8_t, std::less<>> m_senderPriority;
+    mutable SharedMutex x_senderPriority;
 };
 }  // namespace txpool
 }  // namespace bcos
\ No newline at end of file
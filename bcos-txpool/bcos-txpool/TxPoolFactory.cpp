@@ -50,7 +50,7 @@ TxPoolFactory::TxPoolFactory(NodeIDPtr _nodeId, CryptoSuite::Ptr _cryptoSuite,
 
 
 TxPool::Ptr TxPoolFactory::createTxPool(size_t _notifyWorkerNum, size_t _verifierWorkerNum,
-    int64_t _txsExpirationTime, bool _preStoreTxs)
+    int64_t _txsExpirationTime, bool _preStoreTxs, size_t _shardsNum)
 {
     TXPOOL_LOG(INFO) << LOG_DESC("create transaction validator");
     auto txpoolNonceChecker = std::make_shared<TxPoolNonceChecker>();
@@ -63,7 +63,7 @@ TxPool::Ptr TxPoolFactory::createTxPool(size_t _notifyWorkerNum, size_t _verifie
 
     TXPOOL_LOG(INFO) << LOG_DESC("create transaction storage");
     auto txpoolStorage = std::make_shared<MemoryStorage>(
-        txpoolConfig, _notifyWorkerNum, _txsExpirationTime, _preStoreTxs);
+        txpoolConfig, _notifyWorkerNum, _txsExpirationTime, _preStoreTxs, _shardsNum);
 
     auto syncMsgFactory = std::make_shared<TxsSyncMsgFactoryImpl>();
     TXPOOL_LOG(INFO) << LOG_DESC("create sync config");
@@ -253,6 +253,25 @@ size_t TransactionSync::onGetMissedTxsFromLedger(std::set<HashType>& _missedTxs,
                         << LOG_KV("msg", _error->errorMessage());
         return _missedTxs.size();
     }
+    // the txs of the ledger are shared with the other readers, import the copies of them since
+    // importing sets the batch and the known nodes of the txs
+    auto txFactory = m_config->blockFactory()->transactionFactory();
+    auto fetchedTxs = std::make_shared<Transactions>(_fetchedTxs->size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, _fetchedTxs->size()),
+        [&](const tbb::blocked_range<size_t>& _r) {
+            for (size_t i = _r.begin(); i < _r.end(); i++)
+            {
+                auto const& tx = (*_fetchedTxs)[i];
+                // keep the recovered sender instead of recovering it again
+                auto sender = tx->sender();
+                (*fetchedTxs)[i] = txFactory->createTransaction(tx->encode(), false);
+                if (!sender.empty())
+                {
+                    (*fetchedTxs)[i]->forceSender(bytes(sender.begin(), sender.end()));
+                }
+            }
+        });
+    _fetchedTxs = std::move(fetchedTxs);
     // import and verify the transactions
     auto ret = this->importDownloadedTxs(m_config->nodeID(), _fetchedTxs, _verifiedProposal);
     if (!ret)
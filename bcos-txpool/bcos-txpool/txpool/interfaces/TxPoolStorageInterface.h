@@ -29,6 +29,10 @@ namespace bcos
 {
 namespace txpool
 {
+// the encoded tx and the callback of the tx submitted from the sdk
+using TxSubmitRequest = std::pair<bytesPointer, bcos::protocol::TxSubmitCallback>;
+using TxSubmitRequests = std::vector<TxSubmitRequest>;
+
 class TxPoolStorageInterface
 {
 public:
@@ -38,6 +42,8 @@ public:
 
     virtual bcos::protocol::TransactionStatus submitTransaction(
         bytesPointer _txData, bcos::protocol::TxSubmitCallback _txSubmitCallback = nullptr) = 0;
+    // decode and verify the signature of the txs in parallel, and then submit them in order
+    virtual void batchSubmitTransaction(TxSubmitRequests const& _requests) = 0;
 
     virtual bcos::protocol::TransactionStatus insert(bcos::protocol::Transaction::ConstPtr _tx) = 0;
     virtual void batchInsert(bcos::protocol::Transactions const& _txs) = 0;
@@ -19,7 +19,9 @@
  * @date 2021-05-07
  */
 #include "bcos-txpool/txpool/storage/MemoryStorage.h"
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_invoke.h>
+#include <algorithm>
 #include <memory>
 #include <tuple>
 
@@ -29,12 +31,18 @@ using namespace bcos::crypto;
 using namespace bcos::protocol;
 
 MemoryStorage::MemoryStorage(TxPoolConfig::Ptr _config, size_t _notifyWorkerNum,
-    int64_t _txsExpirationTime, bool _preStoreTxs)
+    int64_t _txsExpirationTime, bool _preStoreTxs, size_t _shardsNum)
   : m_config(_config), m_txsExpirationTime(_txsExpirationTime), m_preStoreTxs(_preStoreTxs)
 {
     m_notifier = std::make_shared<ThreadPool>("txNotifier", _notifyWorkerNum);
     m_worker = std::make_shared<ThreadPool>("txpoolWorker", 1);
     m_blockNumberUpdatedTime = utcTime();
+    m_txsLatencyStat = std::make_shared<TxsLatencyStat>();
+    _shardsNum = std::max(_shardsNum, (size_t)1);
+    for (size_t i = 0; i < _shardsNum; i++)
+    {
+        m_shards.emplace_back(std::make_shared<TxsShard>(m_txsExpirationTime));
+    }
     // Trigger a transaction cleanup operation every 3s
     m_cleanUpTimer = std::make_shared<Timer>(3000);
     m_cleanUpTimer->registerTimeoutHandler(
@@ -42,7 +50,8 @@ MemoryStorage::MemoryStorage(TxPoolConfig::Ptr _config, size_t _notifyWorkerNum,
     TXPOOL_LOG(INFO) << LOG_DESC("init MemoryStorage of txpool")
                      << LOG_KV("txNotifierWorkerNum", _notifyWorkerNum)
                      << LOG_KV("txsExpriationTime", m_txsExpirationTime)
-                     << LOG_KV("preStoreTxs", m_preStoreTxs);
+                     << LOG_KV("preStoreTxs", m_preStoreTxs) << LOG_KV("shardsNum", _shardsNum)
+                     << LOG_KV("sealOrder", (int)m_config->txsSealOrder());
 }
 
 void MemoryStorage::start()
@@ -92,10 +101,86 @@ TransactionStatus MemoryStorage::submitTransaction(
     }
 }
 
+void MemoryStorage::batchSubmitTransaction(TxSubmitRequests const& _requests)
+{
+    auto recordT = utcTime();
+    Transactions txs(_requests.size());
+    // decode the txs in parallel
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, _requests.size()),
+        [&](tbb::blocked_range<size_t> const& _range) {
+            for (auto i = _range.begin(); i < _range.end(); i++)
+            {
+                try
+                {
+                    auto tx =
+                        m_config->txFactory()->createTransaction(ref(*(_requests[i].first)), false);
+                    tx->setImportTime(utcTime());
+                    txs[i] = tx;
+                }
+                catch (std::exception const& e)
+                {
+                    TXPOOL_LOG(WARNING) << LOG_DESC("Invalid transaction for decode exception")
+                                        << LOG_KV("error", boost::diagnostic_information(e));
+                }
+            }
+        });
+    batchVerifySignature(txs);
+    auto verifyT = utcTime() - recordT;
+    recordT = utcTime();
+    // submit the txs in order, the signature of the valid txs will not be verified again
+    size_t successCount = 0;
+    for (size_t i = 0; i < txs.size(); i++)
+    {
+        auto const& tx = txs[i];
+        auto const& txSubmitCallback = _requests[i].second;
+        if (!tx)
+        {
+            notifyInvalidReceipt(HashType(), TransactionStatus::Malform, txSubmitCallback);
+            continue;
+        }
+        auto result = verifyAndSubmitTransaction(tx, txSubmitCallback, true, true);
+        if (result != TransactionStatus::None)
+        {
+            notifyInvalidReceipt(tx->hash(), result, txSubmitCallback);
+            continue;
+        }
+        successCount++;
+    }
+    TXPOOL_LOG(DEBUG) << LOG_DESC("batchSubmitTransaction") << LOG_KV("totalTxs", txs.size())
+                      << LOG_KV("submittedTxs", successCount) << LOG_KV("verifyT", verifyT)
+                      << LOG_KV("submitT", (utcTime() - recordT));
+}
+
+void MemoryStorage::batchVerifySignature(Transactions const& _txs)
+{
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, _txs.size()),
+        [&](tbb::blocked_range<size_t> const& _range) {
+            for (auto i = _range.begin(); i < _range.end(); i++)
+            {
+                auto const& tx = _txs[i];
+                if (!tx || tx->invalid())
+                {
+                    continue;
+                }
+                try
+                {
+                    tx->verify();
+                }
+                catch (std::exception const& e)
+                {
+                    tx->setInvalid(true);
+                    TXPOOL_LOG(WARNING) << LOG_DESC("verify signature for tx failed")
+                                        << LOG_KV("reason", boost::diagnostic_information(e))
+                                        << LOG_KV("hash", tx->hash().abridged());
+                }
+            }
+        });
+}
+
 TransactionStatus MemoryStorage::txpoolStorageCheck(Transaction::ConstPtr _tx)
 {
     auto txHash = _tx->hash();
-    if (m_txsTable.count(txHash))
+    if (shard(txHash)->txsTable.count(txHash))
     {
         return TransactionStatus::AlreadyInTxPool;
     }
@@ -108,11 +193,12 @@ TransactionStatus MemoryStorage::enforceSubmitTransaction(Transaction::Ptr _tx)
     auto txHash = _tx->hash();
     // the transaction has already onChain, reject it
     auto result = m_config->txValidator()->submittedToChain(_tx);
+    auto const& txsShard = shard(txHash);
     if (result == TransactionStatus::NonceCheckFail)
     {
-        if (m_txsTable.count(txHash))
+        if (txsShard->txsTable.count(txHash))
         {
-            auto tx = m_txsTable.at(txHash);
+            auto tx = txsShard->txsTable.at(txHash);
             TXPOOL_LOG(WARNING) << LOG_DESC("enforce to seal failed for nonce check failed: ")
                                 << tx->hash().abridged() << LOG_KV("batchId", tx->batchId())
                                 << LOG_KV("batchHash", tx->batchHash().abridged())
@@ -121,15 +207,15 @@ TransactionStatus MemoryStorage::enforceSubmitTransaction(Transaction::Ptr _tx)
         }
         return TransactionStatus::NonceCheckFail;
     }
-    if (m_txsTable.count(txHash) && m_txsTable[txHash])
+    if (auto tx = getTxWithoutLock(txHash))
     {
-        auto tx = m_txsTable[txHash];
         if (!tx->sealed() || tx->batchHash() == HashType())
         {
             if (!tx->sealed())
             {
                 m_sealedTxsSize++;
                 tx->setSealed(true);
+                txsShard->unsealedTxs.markSealed(txHash);
             }
             tx->setBatchId(_tx->batchId());
             tx->setBatchHash(_tx->batchHash());
@@ -154,7 +240,7 @@ TransactionStatus MemoryStorage::enforceSubmitTransaction(Transaction::Ptr _tx)
     auto status = insertWithoutLock(_tx);
     if (status != TransactionStatus::None)
     {
-        auto tx = m_txsTable.at(_tx->hash());
+        auto tx = txsShard->txsTable.at(_tx->hash());
         TXPOOL_LOG(WARNING) << LOG_DESC("insertWithoutLock failed for already has the tx")
                             << LOG_KV("hash", tx->hash().abridged())
                             << LOG_KV("status", tx->sealed());
@@ -162,6 +248,7 @@ TransactionStatus MemoryStorage::enforceSubmitTransaction(Transaction::Ptr _tx)
         {
             tx->setSealed(true);
             m_sealedTxsSize++;
+            txsShard->unsealedTxs.markSealed(txHash);
         }
     }
     else
@@ -169,6 +256,7 @@ TransactionStatus MemoryStorage::enforceSubmitTransaction(Transaction::Ptr _tx)
         // avoid the sealed txs be sealed again
         _tx->setSealed(true);
         m_sealedTxsSize++;
+        txsShard->unsealedTxs.markSealed(txHash);
     }
     return TransactionStatus::None;
 }
@@ -177,13 +265,13 @@ TransactionStatus MemoryStorage::verifyAndSubmitTransaction(
     Transaction::Ptr _tx, TxSubmitCallback _txSubmitCallback, bool _checkPoolLimit, bool _lock)
 {
     // start stat the tps when receive first new tx from the sdk
-    if (m_tpsStatstartTime.load() == 0 && m_txsTable.size() == 0)
+    if (m_tpsStatstartTime.load() == 0 && m_txsSize == 0)
     {
         m_tpsStatstartTime = utcTime();
     }
     // Note: In order to ensure that transactions can reach all nodes, transactions from P2P are not
     // restricted
-    if (_checkPoolLimit && m_txsTable.size() >= m_config->poolLimit())
+    if (_checkPoolLimit && m_txsSize >= m_config->poolLimit())
     {
         return TransactionStatus::TxPoolIsFull;
     }
@@ -232,22 +320,27 @@ void MemoryStorage::notifyInvalidReceipt(
 
 TransactionStatus MemoryStorage::insert(Transaction::ConstPtr _tx)
 {
-    ReadGuard l(x_txpoolMutex);
+    ReadGuard l(shard(_tx->hash())->x_txsTable);
     return insertWithoutLock(_tx);
 }
 
+// Note: must hold the lock of the shard of the tx
 TransactionStatus MemoryStorage::insertWithoutLock(Transaction::ConstPtr _tx)
 {
+    auto const& txsShard = shard(_tx->hash());
     // check again to ensure the same transaction not be imported many times
-    if (m_txsTable.count(_tx->hash()))
+    if (txsShard->txsTable.count(_tx->hash()))
     {
         return TransactionStatus::AlreadyInTxPool;
     }
-    auto result = m_txsTable.insert(std::make_pair(_tx->hash(), _tx));
+    auto result = txsShard->txsTable.insert(std::make_pair(_tx->hash(), _tx));
     if (!result.second)
     {
         return TransactionStatus::AlreadyInTxPool;
     }
+    m_txsSize++;
+    txsShard->unsealedTxs.insert(_tx, sealOrderKey(_tx, m_txsSeq++));
+    txsShard->expirationWheel.insert(_tx);
     m_onReady();
     if (m_preStoreTxs)
     {
@@ -320,18 +413,45 @@ void MemoryStorage::batchInsert(Transactions const& _txs)
     }
 }
 
+uint64_t MemoryStorage::sealOrderKey(Transaction::ConstPtr const& _tx, uint64_t _seq) const
+{
+    if (m_config->txsSealOrder() != TxsSealOrder::Priority)
+    {
+        return _seq;
+    }
+    // the highest 8 bits is the reversed priority, and the rest is the import sequence
+    uint64_t reversedPriority = UINT8_MAX - m_config->senderPriority(_tx->sender());
+    return (reversedPriority << 56) | (_seq & (((uint64_t)1 << 56) - 1));
+}
+
+Transaction::ConstPtr MemoryStorage::getTxWithoutLock(HashType const& _txHash) const
+{
+    auto const& txsShard = shard(_txHash);
+    auto it = txsShard->txsTable.find(_txHash);
+    if (it == txsShard->txsTable.end())
+    {
+        return nullptr;
+    }
+    return it->second;
+}
+
+// Note: must hold the write lock of the shard of the tx
 Transaction::ConstPtr MemoryStorage::removeWithoutLock(HashType const& _txHash)
 {
-    if (!m_txsTable.count(_txHash))
+    auto const& txsShard = shard(_txHash);
+    if (!txsShard->txsTable.count(_txHash))
     {
         return nullptr;
     }
-    auto tx = m_txsTable.at(_txHash);
+    auto tx = txsShard->txsTable.at(_txHash);
     if (tx && tx->sealed())
     {
         m_sealedTxsSize--;
     }
-    m_txsTable.unsafe_erase(_txHash);
+    txsShard->txsTable.unsafe_erase(_txHash);
+    m_txsSize--;
+    txsShard->unsealedTxs.remove(_txHash);
+    txsShard->expirationWheel.remove(_txHash);
 #if FISCO_DEBUG
     // TODO: remove this, now just for bug tracing
     TXPOOL_LOG(DEBUG) << LOG_DESC("remove tx: ") << tx->hash().abridged()
@@ -343,8 +463,11 @@ Transaction::ConstPtr MemoryStorage::removeWithoutLock(HashType const& _txHash)
 
 Transaction::ConstPtr MemoryStorage::remove(HashType const& _txHash)
 {
-    WriteGuard l(x_txpoolMutex);
-    auto tx = removeWithoutLock(_txHash);
+    Transaction::ConstPtr tx = nullptr;
+    {
+        WriteGuard l(shard(_txHash)->x_txsTable);
+        tx = removeWithoutLock(_txHash);
+    }
     notifyUnsealedTxsSize();
     return tx;
 }
@@ -414,22 +537,27 @@ void MemoryStorage::printPendingTxs()
     {
         return;
     }
-    if (unSealedTxsSize() > 0 || m_txsTable.size() == 0)
+    if (unSealedTxsSize() > 0 || m_txsSize == 0)
     {
         return;
     }
     TXPOOL_LOG(DEBUG) << LOG_DESC("printPendingTxs for some txs unhandle")
-                      << LOG_KV("pendingSize", m_txsTable.size());
-    for (auto item : m_txsTable)
+                      << LOG_KV("pendingSize", m_txsSize);
+    for (auto const& txsShard : m_shards)
     {
-        auto tx = item.second;
-        if (!tx)
+        ReadGuard l(txsShard->x_txsTable);
+        for (auto item : txsShard->txsTable)
         {
-            continue;
+            auto tx = item.second;
+            if (!tx)
+            {
+                continue;
+            }
+            TXPOOL_LOG(DEBUG) << LOG_KV("hash", tx->hash().abridged())
+                              << LOG_KV("id", tx->batchId())
+                              << LOG_KV("hash", tx->batchHash().abridged())
+                              << LOG_KV("seal", tx->sealed());
         }
-        TXPOOL_LOG(DEBUG) << LOG_KV("hash", tx->hash().abridged()) << LOG_KV("id", tx->batchId())
-                          << LOG_KV("hash", tx->batchHash().abridged())
-                          << LOG_KV("seal", tx->sealed());
     }
     TXPOOL_LOG(DEBUG) << LOG_DESC("printPendingTxs for some txs unhandle finish");
     m_printed = true;
@@ -443,21 +571,36 @@ void MemoryStorage::batchRemove(BlockNumber _batchId, TransactionSubmitResults c
     size_t succCount = 0;
     NonceListPtr nonceList = std::make_shared<NonceList>();
     {
+        // group the txs by shard, so that every shard is only locked once
+        std::vector<std::vector<TransactionSubmitResult::Ptr>> shardTxsResult(m_shards.size());
+        for (auto const& txResult : _txsResult)
+        {
+            shardTxsResult[shardIndex(txResult->txHash())].emplace_back(txResult);
+        }
         // batch remove
-        WriteGuard l(x_txpoolMutex);
-        lockT = utcTime() - startT;
-        for (auto txResult : _txsResult)
+        for (size_t i = 0; i < m_shards.size(); i++)
         {
-            auto tx = removeSubmittedTxWithoutLock(txResult);
-
-            if (!tx && txResult->nonce() != NonceType(-1))
+            if (shardTxsResult[i].empty())
             {
-                nonceList->emplace_back(txResult->nonce());
+                continue;
             }
-            else if (tx)
+            auto lockStartT = utcTime();
+            WriteGuard l(m_shards[i]->x_txsTable);
+            lockT += (utcTime() - lockStartT);
+            for (auto const& txResult : shardTxsResult[i])
             {
-                succCount++;
-                nonceList->emplace_back(tx->nonce());
+                auto tx = removeSubmittedTxWithoutLock(txResult);
+
+                if (!tx && txResult->nonce() != NonceType(-1))
+                {
+                    nonceList->emplace_back(txResult->nonce());
+                }
+                else if (tx)
+                {
+                    succCount++;
+                    nonceList->emplace_back(tx->nonce());
+                    recordTxLatency(tx, TxsLatencyStat::Stage::Commit);
+                }
             }
         }
         // Note: must update the blockNumber after the txs removed
@@ -467,7 +610,7 @@ void MemoryStorage::batchRemove(BlockNumber _batchId, TransactionSubmitResults c
         }
         m_onChainTxsCount += _txsResult.size();
         // stop stat the tps when there has no pending txs
-        if (m_tpsStatstartTime.load() > 0 && m_txsTable.size() == 0)
+        if (m_tpsStatstartTime.load() > 0 && m_txsSize == 0)
         {
             auto totalTime = (utcTime() - m_tpsStatstartTime);
             if (totalTime > 0)
@@ -500,17 +643,17 @@ void MemoryStorage::batchRemove(BlockNumber _batchId, TransactionSubmitResults c
 
 TransactionsPtr MemoryStorage::fetchTxs(HashList& _missedTxs, HashList const& _txs)
 {
-    ReadGuard l(x_txpoolMutex);
     auto fetchedTxs = std::make_shared<Transactions>();
     _missedTxs.clear();
     for (auto const& hash : _txs)
     {
-        if (!m_txsTable.count(hash))
+        ReadGuard l(shard(hash)->x_txsTable);
+        auto tx = getTxWithoutLock(hash);
+        if (!tx)
         {
             _missedTxs.emplace_back(hash);
             continue;
         }
-        auto tx = m_txsTable[hash];
         fetchedTxs->emplace_back(std::const_pointer_cast<Transaction>(tx));
     }
     return fetchedTxs;
@@ -518,26 +661,29 @@ TransactionsPtr MemoryStorage::fetchTxs(HashList& _missedTxs, HashList const& _t
 
 ConstTransactionsPtr MemoryStorage::fetchNewTxs(size_t _txsLimit)
 {
-    ReadGuard l(x_txpoolMutex);
     auto fetchedTxs = std::make_shared<ConstTransactions>();
-    for (auto const& it : m_txsTable)
+    for (auto const& txsShard : m_shards)
     {
-        auto tx = it.second;
-        // Note: When inserting data into tbb::concurrent_unordered_map while traversing, it.second
-        // will occasionally be a null pointer.
-        if (!tx)
-        {
-            continue;
-        }
-        if (tx->synced())
-        {
-            continue;
-        }
-        tx->setSynced(true);
-        fetchedTxs->emplace_back(tx);
-        if (fetchedTxs->size() >= _txsLimit)
+        ReadGuard l(txsShard->x_txsTable);
+        for (auto const& it : txsShard->txsTable)
         {
-            break;
+            auto tx = it.second;
+            // Note: When inserting data into tbb::concurrent_unordered_map while traversing,
+            // it.second will occasionally be a null pointer.
+            if (!tx)
+            {
+                continue;
+            }
+            if (tx->synced())
+            {
+                continue;
+            }
+            tx->setSynced(true);
+            fetchedTxs->emplace_back(tx);
+            if (fetchedTxs->size() >= _txsLimit)
+            {
+                return fetchedTxs;
+            }
         }
     }
     return fetchedTxs;
@@ -546,107 +692,63 @@ ConstTransactionsPtr MemoryStorage::fetchNewTxs(size_t _txsLimit)
 void MemoryStorage::batchFetchTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList, size_t _txsLimit,
     TxsHashSetPtr _avoidTxs, bool _avoidDuplicate)
 {
-    TXPOOL_LOG(INFO) << LOG_DESC("begin batchFetchTxs") << LOG_KV("pendingTxs", m_txsTable.size())
+    TXPOOL_LOG(INFO) << LOG_DESC("begin batchFetchTxs") << LOG_KV("pendingTxs", m_txsSize)
                      << LOG_KV("limit", _txsLimit);
-    auto blockFactory = m_config->blockFactory();
     auto recordT = utcTime();
     auto startT = utcTime();
-    ReadGuard l(x_txpoolMutex);
+    // Note: the invalid txs should not be taken out when fetching
+    ReadGuard invalidTxsLock(x_invalidTxs);
     auto lockT = utcTime() - startT;
     startT = utcTime();
-    int64_t currentTime = (int64_t)utcTime();
+    // the expired txs should not be sealed
+    auto currentTime = utcTime();
+    auto expiredTxs = markExpiredTxs(currentTime);
     size_t traverseCount = 0;
-    for (auto const& it : m_txsTable)
+    if (_avoidDuplicate)
     {
-        traverseCount++;
-        auto tx = it.second;
-        // Note: When inserting data into tbb::concurrent_unordered_map while traversing,
-        // it.second will occasionally be a null pointer.
-        if (!tx)
-        {
-            continue;
-        }
-        // only seal the txs have been stored to the backend
-        if (m_preStoreTxs && !tx->storeToBackend())
-        {
-            continue;
-        }
-        auto txHash = tx->hash();
-        if (m_invalidTxs.count(txHash))
-        {
-            continue;
-        }
-        // the transaction has already been sealed for newer proposal
-        if (_avoidDuplicate && tx->sealed())
-        {
-            continue;
-        }
-        if (currentTime > (tx->importTime() + m_txsExpirationTime))
-        {
-            // add to m_invalidTxs to be deleted
-            m_invalidTxs.insert(txHash);
-            m_invalidTxs.insert(tx->nonce());
-            continue;
-        }
-        /// check nonce again when obtain transactions
-        // since the invalid nonce has already been checked before the txs import into the
-        // txPool the txs with duplicated nonce here are already-committed, but have not been
-        // dropped
-        auto result = m_config->txValidator()->submittedToChain(tx);
-        if (result == TransactionStatus::NonceCheckFail)
-        {
-            // in case of the same tx notified more than once
-            auto transaction = std::const_pointer_cast<Transaction>(tx);
-            transaction->takeSubmitCallback();
-            // add to m_invalidTxs to be deleted
-            m_invalidTxs.insert(txHash);
-            m_invalidTxs.insert(tx->nonce());
-            continue;
-        }
-        // blockLimit expired
-        if (result == TransactionStatus::BlockLimitCheckFail)
-        {
-            m_invalidTxs.insert(txHash);
-            m_invalidNonces.insert(tx->nonce());
-            continue;
-        }
-        if (_avoidTxs && _avoidTxs->count(txHash))
-        {
-            continue;
-        }
-        auto txMetaData = m_config->blockFactory()->createTransactionMetaData();
-
-        txMetaData->setHash(tx->hash());
-        txMetaData->setTo(std::string(tx->to()));
-        txMetaData->setAttribute(tx->attribute());
-        if (tx->systemTx())
-        {
-            _sysTxsList->appendTransactionMetaData(txMetaData);
-        }
-        else
-        {
-            _txsList->appendTransactionMetaData(txMetaData);
-        }
-        if (!tx->sealed())
-        {
-            m_sealedTxsSize++;
-        }
-#if FISCO_DEBUG
-        // TODO: remove this, now just for bug tracing
-        TXPOOL_LOG(INFO) << LOG_DESC("fetch ") << tx->hash().abridged()
-                         << LOG_KV("sealed", tx->sealed()) << LOG_KV("batchId", tx->batchId())
-                         << LOG_KV("batchHash", tx->batchHash().abridged())
-                         << LOG_KV("txPointer", tx);
-#endif
-        tx->setSealed(true);
-        tx->setBatchId(-1);
-        tx->setBatchHash(HashType());
-        if ((_txsList->transactionsMetaDataSize() + _sysTxsList->transactionsMetaDataSize()) >=
-            _txsLimit)
+        // only traverse the unsealed txs
+        auto batchSize = std::max(c_minFetchBatchSize, (_txsLimit * 2) / m_shards.size());
+        traverseCount = traverseUnsealedTxs(
+            [&](Transaction::ConstPtr const& _tx) {
+                return fetchTx(_tx, _txsList, _sysTxsList, _txsLimit, _avoidTxs, _avoidDuplicate,
+                    currentTime);
+            },
+            batchSize);
+    }
+    else
+    {
+        // the sealed txs should also be fetched, traverse the whole txpool
+        bool stop = false;
+        for (auto it = m_shards.begin(); !stop && it != m_shards.end(); it++)
         {
-            break;
+            auto const& txsShard = *it;
+            // Note: the txs of the shard should not be removed when fetching
+            ReadGuard l(txsShard->x_txsTable);
+            for (auto const& item : txsShard->txsTable)
+            {
+                traverseCount++;
+                auto tx = item.second;
+                // Note: When inserting data into tbb::concurrent_unordered_map while traversing,
+                // it.second will occasionally be a null pointer.
+                if (!tx)
+                {
+                    continue;
+                }
+                auto result = fetchTx(tx, _txsList, _sysTxsList, _txsLimit, _avoidTxs,
+                    _avoidDuplicate, currentTime);
+                if (result == UnsealedTxsIndex::VisitResult::Stop)
+                {
+                    stop = true;
+                    break;
+                }
+                if (result == UnsealedTxsIndex::VisitResult::Remove)
+                {
+                    txsShard->unsealedTxs.markSealed(tx->hash());
+                }
+            }
         }
     }
+    m_fetchTraverseCount = traverseCount;
     auto fetchTxsT = utcTime() - startT;
     notifyUnsealedTxsSize();
     removeInvalidTxs();
@@ -654,9 +756,161 @@ void MemoryStorage::batchFetchTxs(Block::Ptr _txsList, Block::Ptr _sysTxsList, s
                      << LOG_KV("timecost", (utcTime() - recordT))
                      << LOG_KV("txsSize", _txsList->transactionsMetaDataSize())
                      << LOG_KV("sysTxsSize", _sysTxsList->transactionsMetaDataSize())
-                     << LOG_KV("pendingTxs", m_txsTable.size()) << LOG_KV("limit", _txsLimit)
+                     << LOG_KV("pendingTxs", m_txsSize) << LOG_KV("limit", _txsLimit)
                      << LOG_KV("fetchTxsT", fetchTxsT) << LOG_KV("lockT", lockT)
-                     << LOG_KV("traverseCount", traverseCount);
+                     << LOG_KV("traverseCount", traverseCount) << LOG_KV("expiredTxs", expiredTxs);
+}
+
+size_t MemoryStorage::traverseUnsealedTxs(
+    UnsealedTxsIndex::Visitor const& _visitor, size_t _batchSize)
+{
+    _batchSize = std::max(_batchSize, (size_t)1);
+    size_t traverseCount = 0;
+    uint64_t fromSeq = 0;
+    while (true)
+    {
+        // fetch a batch of unsealed txs from every shard, the txs of all the shards before the
+        // upperBound have been fetched, and can be merged in the import order
+        std::vector<std::pair<size_t, UnsealedTxsIndex::SealableTx>> candidates;
+        auto upperBound = std::numeric_limits<uint64_t>::max();
+        for (size_t i = 0; i < m_shards.size(); i++)
+        {
+            std::vector<UnsealedTxsIndex::SealableTx> shardTxs;
+            if (m_shards[i]->unsealedTxs.fetch(fromSeq, _batchSize, shardTxs))
+            {
+                upperBound = std::min(upperBound, shardTxs.back().first);
+            }
+            for (auto& sealableTx : shardTxs)
+            {
+                candidates.emplace_back(i, std::move(sealableTx));
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [](auto const& _lhs, auto const& _rhs) {
+            return _lhs.second.first < _rhs.second.first;
+        });
+        for (auto const& candidate : candidates)
+        {
+            auto const& sealableTx = candidate.second;
+            if (sealableTx.first > upperBound)
+            {
+                break;
+            }
+            traverseCount++;
+            // Note: only lock the shard of the tx, the tx should not be removed when visiting
+            auto const& txsShard = m_shards[candidate.first];
+            auto txHash = sealableTx.second->hash();
+            ReadGuard l(txsShard->x_txsTable);
+            if (!txsShard->txsTable.count(txHash))
+            {
+                continue;
+            }
+            auto result = _visitor(sealableTx.second);
+            if (result == UnsealedTxsIndex::VisitResult::Stop)
+            {
+                return traverseCount;
+            }
+            if (result == UnsealedTxsIndex::VisitResult::Remove)
+            {
+                txsShard->unsealedTxs.markSealed(txHash);
+            }
+        }
+        // all the unsealed txs have been traversed
+        if (upperBound == std::numeric_limits<uint64_t>::max())
+        {
+            break;
+        }
+        fromSeq = upperBound + 1;
+    }
+    return traverseCount;
+}
+
+UnsealedTxsIndex::VisitResult MemoryStorage::fetchTx(Transaction::ConstPtr const& _tx,
+    Block::Ptr _txsList, Block::Ptr _sysTxsList, size_t _txsLimit, TxsHashSetPtr _avoidTxs,
+    bool _avoidDuplicate, int64_t _currentTime)
+{
+    if ((_txsList->transactionsMetaDataSize() + _sysTxsList->transactionsMetaDataSize()) >=
+        _txsLimit)
+    {
+        return UnsealedTxsIndex::VisitResult::Stop;
+    }
+    // only seal the txs have been stored to the backend
+    if (m_preStoreTxs && !_tx->storeToBackend())
+    {
+        return UnsealedTxsIndex::VisitResult::Keep;
+    }
+    auto txHash = _tx->hash();
+    if (m_invalidTxs.count(txHash))
+    {
+        return UnsealedTxsIndex::VisitResult::Keep;
+    }
+    // the transaction has already been sealed for newer proposal
+    if (_avoidDuplicate && _tx->sealed())
+    {
+        return UnsealedTxsIndex::VisitResult::Remove;
+    }
+    // the wheel only pops the buckets before the current one, check the exact expiration time
+    if (_currentTime > (_tx->importTime() + m_txsExpirationTime))
+    {
+        m_invalidTxs.insert(txHash);
+        m_invalidNonces.insert(_tx->nonce());
+        m_expiredTxsCount++;
+        return UnsealedTxsIndex::VisitResult::Keep;
+    }
+    /// check nonce again when obtain transactions
+    // since the invalid nonce has already been checked before the txs import into the
+    // txPool the txs with duplicated nonce here are already-committed, but have not been
+    // dropped
+    auto result = m_config->txValidator()->submittedToChain(_tx);
+    if (result == TransactionStatus::NonceCheckFail)
+    {
+        // in case of the same tx notified more than once
+        auto transaction = std::const_pointer_cast<Transaction>(_tx);
+        transaction->takeSubmitCallback();
+        // add to m_invalidTxs to be deleted
+        m_invalidTxs.insert(txHash);
+        m_invalidTxs.insert(_tx->nonce());
+        return UnsealedTxsIndex::VisitResult::Keep;
+    }
+    // blockLimit expired
+    if (result == TransactionStatus::BlockLimitCheckFail)
+    {
+        m_invalidTxs.insert(txHash);
+        m_invalidNonces.insert(_tx->nonce());
+        return UnsealedTxsIndex::VisitResult::Keep;
+    }
+    if (_avoidTxs && _avoidTxs->count(txHash))
+    {
+        return UnsealedTxsIndex::VisitResult::Keep;
+    }
+    auto txMetaData = m_config->blockFactory()->createTransactionMetaData();
+
+    txMetaData->setHash(txHash);
+    txMetaData->setTo(std::string(_tx->to()));
+    txMetaData->setAttribute(_tx->attribute());
+    if (_tx->systemTx())
+    {
+        _sysTxsList->appendTransactionMetaData(txMetaData);
+    }
+    else
+    {
+        _txsList->appendTransactionMetaData(txMetaData);
+    }
+    if (!_tx->sealed())
+    {
+        m_sealedTxsSize++;
+        recordTxLatency(_tx, TxsLatencyStat::Stage::Seal);
+    }
+#if FISCO_DEBUG
+    // TODO: remove this, now just for bug tracing
+    TXPOOL_LOG(INFO) << LOG_DESC("fetch ") << _tx->hash().abridged()
+                     << LOG_KV("sealed", _tx->sealed()) << LOG_KV("batchId", _tx->batchId())
+                     << LOG_KV("batchHash", _tx->batchHash().abridged())
+                     << LOG_KV("txPointer", _tx);
+#endif
+    _tx->setSealed(true);
+    _tx->setBatchId(-1);
+    _tx->setBatchHash(HashType());
+    return UnsealedTxsIndex::VisitResult::Remove;
 }
 
 void MemoryStorage::removeInvalidTxs()
@@ -670,34 +924,54 @@ void MemoryStorage::removeInvalidTxs()
             {
                 return;
             }
-            if (memoryStorage->m_invalidTxs.size() == 0)
+            // take the invalid txs out, so that the shards can be locked one by one
+            HashList invalidTxs;
+            NonceList invalidNonces;
             {
-                return;
+                WriteGuard l(memoryStorage->x_invalidTxs);
+                if (memoryStorage->m_invalidTxs.size() == 0)
+                {
+                    return;
+                }
+                invalidTxs.assign(
+                    memoryStorage->m_invalidTxs.begin(), memoryStorage->m_invalidTxs.end());
+                invalidNonces.assign(
+                    memoryStorage->m_invalidNonces.begin(), memoryStorage->m_invalidNonces.end());
+                memoryStorage->m_invalidTxs.clear();
+                memoryStorage->m_invalidNonces.clear();
             }
-            WriteGuard l(memoryStorage->x_txpoolMutex);
             tbb::parallel_invoke(
-                [memoryStorage]() {
+                [memoryStorage, &invalidTxs]() {
                     // remove invalid txs
-                    for (auto const& txHash : memoryStorage->m_invalidTxs)
+                    auto shardTxs = memoryStorage->groupByShard(
+                        invalidTxs.size(), [&invalidTxs](size_t _i) { return invalidTxs[_i]; });
+                    for (size_t i = 0; i < shardTxs.size(); i++)
                     {
-                        auto txResult =
-                            memoryStorage->m_config->txResultFactory()->createTxSubmitResult();
-                        txResult->setTxHash(txHash);
-                        txResult->setStatus((uint32_t)TransactionStatus::BlockLimitCheckFail);
+                        if (shardTxs[i].empty())
+                        {
+                            continue;
+                        }
+                        WriteGuard l(memoryStorage->m_shards[i]->x_txsTable);
+                        for (auto index : shardTxs[i])
+                        {
+                            auto txResult =
+                                memoryStorage->m_config->txResultFactory()->createTxSubmitResult();
+                            txResult->setTxHash(invalidTxs[index]);
+                            txResult->setStatus((uint32_t)TransactionStatus::BlockLimitCheckFail);
 
-                        memoryStorage->removeSubmittedTxWithoutLock(txResult);
+                            if (memoryStorage->removeSubmittedTxWithoutLock(txResult))
+                            {
+                                memoryStorage->m_evictedTxsCount++;
+                            }
+                        }
                     }
                     memoryStorage->notifyUnsealedTxsSize();
                 },
-                [memoryStorage]() {
+                [memoryStorage, &invalidNonces]() {
                     // remove invalid nonce
-                    memoryStorage->m_config->txPoolNonceChecker()->batchRemove(
-                        memoryStorage->m_invalidNonces);
+                    memoryStorage->m_config->txPoolNonceChecker()->batchRemove(invalidNonces);
                 });
-            TXPOOL_LOG(DEBUG) << LOG_DESC("removeInvalidTxs")
-                              << LOG_KV("size", memoryStorage->m_invalidTxs.size());
-            memoryStorage->m_invalidTxs.clear();
-            memoryStorage->m_invalidNonces.clear();
+            TXPOOL_LOG(DEBUG) << LOG_DESC("removeInvalidTxs") << LOG_KV("size", invalidTxs.size());
         }
         catch (std::exception const& e)
         {
@@ -709,8 +983,16 @@ void MemoryStorage::removeInvalidTxs()
 
 void MemoryStorage::clear()
 {
-    WriteGuard l(x_txpoolMutex);
-    m_txsTable.clear();
+    // Note: lock the invalid txs before the shards, the same as batchFetchTxs
+    WriteGuard invalidTxsLock(x_invalidTxs);
+    auto locks = lockShards<WriteGuard>();
+    for (auto const& txsShard : m_shards)
+    {
+        txsShard->txsTable.clear();
+        txsShard->unsealedTxs.clear();
+        txsShard->expirationWheel.clear();
+    }
+    m_txsSize = 0;
     m_invalidTxs.clear();
     m_invalidNonces.clear();
     m_missedTxs.clear();
@@ -719,25 +1001,33 @@ void MemoryStorage::clear()
 
 HashListPtr MemoryStorage::filterUnknownTxs(HashList const& _txsHashList, NodeIDPtr _peer)
 {
-    ReadGuard l(x_txpoolMutex);
-    for (auto txHash : _txsHashList)
+    std::vector<bool> knownTxs(_txsHashList.size(), false);
+    auto shardTxs = groupByShard(
+        _txsHashList.size(), [&_txsHashList](size_t _i) { return _txsHashList[_i]; });
+    for (size_t i = 0; i < shardTxs.size(); i++)
     {
-        if (!m_txsTable.count(txHash))
+        if (shardTxs[i].empty())
         {
             continue;
         }
-        auto tx = m_txsTable[txHash];
-        if (!tx)
+        ReadGuard l(m_shards[i]->x_txsTable);
+        for (auto index : shardTxs[i])
         {
-            continue;
+            auto tx = getTxWithoutLock(_txsHashList[index]);
+            if (!tx)
+            {
+                continue;
+            }
+            tx->appendKnownNode(_peer);
+            knownTxs[index] = true;
         }
-        tx->appendKnownNode(_peer);
     }
     auto unknownTxsList = std::make_shared<HashList>();
     UpgradableGuard missedTxsLock(x_missedTxs);
-    for (auto const& txHash : _txsHashList)
+    for (size_t i = 0; i < _txsHashList.size(); i++)
     {
-        if (m_txsTable.count(txHash))
+        auto const& txHash = _txsHashList[i];
+        if (knownTxs[i])
         {
             continue;
         }
@@ -758,96 +1048,124 @@ HashListPtr MemoryStorage::filterUnknownTxs(HashList const& _txsHashList, NodeID
 
 void MemoryStorage::batchMarkTxs(
     HashList const& _txsHashList, BlockNumber _batchId, HashType const& _batchHash, bool _sealFlag)
-{
-    if (_sealFlag)
-    {
-        ReadGuard l(x_txpoolMutex);
-        batchMarkTxsWithoutLock(_txsHashList, _batchId, _batchHash, _sealFlag);
-        return;
-    }
-    // Note: setting flag to false is pessimistic, use writeLock here in case of the same txs has
-    // been sealed twice
-    WriteGuard l(x_txpoolMutex);
-    batchMarkTxsWithoutLock(_txsHashList, _batchId, _batchHash, _sealFlag);
-    return;
-}
-
-void MemoryStorage::batchMarkTxsWithoutLock(
-    HashList const& _txsHashList, BlockNumber _batchId, HashType const& _batchHash, bool _sealFlag)
 {
     auto recordT = utcTime();
-    auto startT = utcTime();
     ssize_t successCount = 0;
-    for (auto txHash : _txsHashList)
+    auto shardTxs = groupByShard(
+        _txsHashList.size(), [&_txsHashList](size_t _i) { return _txsHashList[_i]; });
+    for (size_t i = 0; i < shardTxs.size(); i++)
     {
-        if (!m_txsTable.count(txHash))
-        {
-            TXPOOL_LOG(TRACE) << LOG_DESC("batchMarkTxs: missing transaction")
-                              << LOG_KV("tx", txHash.abridged()) << LOG_KV("sealFlag", _sealFlag);
-            continue;
-        }
-        auto tx = m_txsTable[txHash];
-        if (!tx)
+        if (shardTxs[i].empty())
         {
             continue;
         }
-        // the tx has already been re-sealed, can not enforce unseal
-        if ((tx->batchId() != _batchId || tx->batchHash() != _batchHash) && tx->sealed() &&
-            !_sealFlag)
-        {
-            continue;
-        }
-        if (_sealFlag && !tx->sealed())
-        {
-            m_sealedTxsSize++;
-        }
-        if (!_sealFlag && tx->sealed())
-        {
-            m_sealedTxsSize--;
-        }
-        tx->setSealed(_sealFlag);
-        successCount += 1;
-        // set the block information for the transaction
+        auto markShardTxs = [&]() {
+            for (auto index : shardTxs[i])
+            {
+                if (markTxWithoutLock(_txsHashList[index], _batchId, _batchHash, _sealFlag))
+                {
+                    successCount += 1;
+                }
+            }
+        };
         if (_sealFlag)
         {
-            tx->setBatchId(_batchId);
-            tx->setBatchHash(_batchHash);
+            ReadGuard l(m_shards[i]->x_txsTable);
+            markShardTxs();
+            continue;
         }
-#if FISCO_DEBUG
-        // TODO: remove this, now just for bug tracing
-        TXPOOL_LOG(DEBUG) << LOG_DESC("mark ") << tx->hash().abridged() << ":" << _sealFlag
-                          << LOG_KV("index", tx->batchId())
-                          << LOG_KV("hash", tx->batchHash().abridged()) << LOG_KV("txPointer", tx);
-#endif
+        // Note: setting flag to false is pessimistic, use writeLock here in case of the same txs
+        // has been sealed twice
+        WriteGuard l(m_shards[i]->x_txsTable);
+        markShardTxs();
     }
     TXPOOL_LOG(DEBUG) << LOG_DESC("batchMarkTxs ") << LOG_KV("txsSize", _txsHashList.size())
                       << LOG_KV("batchId", _batchId) << LOG_KV("hash", _batchHash.abridged())
                       << LOG_KV("flag", _sealFlag) << LOG_KV("succ", successCount)
-                      << LOG_KV("timecost", utcTime() - recordT)
-                      << LOG_KV("markT", (utcTime() - startT));
+                      << LOG_KV("timecost", utcTime() - recordT);
     notifyUnsealedTxsSize();
 }
 
+bool MemoryStorage::markTxWithoutLock(
+    HashType const& _txHash, BlockNumber _batchId, HashType const& _batchHash, bool _sealFlag)
+{
+    auto const& txsShard = shard(_txHash);
+    auto tx = getTxWithoutLock(_txHash);
+    if (!tx)
+    {
+        TXPOOL_LOG(TRACE) << LOG_DESC("batchMarkTxs: missing transaction")
+                          << LOG_KV("tx", _txHash.abridged()) << LOG_KV("sealFlag", _sealFlag);
+        return false;
+    }
+    // the tx has already been re-sealed, can not enforce unseal
+    if ((tx->batchId() != _batchId || tx->batchHash() != _batchHash) && tx->sealed() &&
+        !_sealFlag)
+    {
+        return false;
+    }
+    if (_sealFlag && !tx->sealed())
+    {
+        m_sealedTxsSize++;
+    }
+    if (!_sealFlag && tx->sealed())
+    {
+        m_sealedTxsSize--;
+    }
+    tx->setSealed(_sealFlag);
+    if (_sealFlag)
+    {
+        txsShard->unsealedTxs.markSealed(_txHash);
+    }
+    else
+    {
+        txsShard->unsealedTxs.markUnsealed(tx);
+    }
+    // set the block information for the transaction
+    if (_sealFlag)
+    {
+        tx->setBatchId(_batchId);
+        tx->setBatchHash(_batchHash);
+    }
+#if FISCO_DEBUG
+    // TODO: remove this, now just for bug tracing
+    TXPOOL_LOG(DEBUG) << LOG_DESC("mark ") << tx->hash().abridged() << ":" << _sealFlag
+                      << LOG_KV("index", tx->batchId())
+                      << LOG_KV("hash", tx->batchHash().abridged()) << LOG_KV("txPointer", tx);
+#endif
+    return true;
+}
+
 void MemoryStorage::batchMarkAllTxs(bool _sealFlag)
 {
-    ReadGuard l(x_txpoolMutex);
-    for (auto item : m_txsTable)
+    size_t markedTxs = 0;
+    for (auto const& txsShard : m_shards)
     {
-        auto tx = item.second;
-        if (!tx)
+        ReadGuard l(txsShard->x_txsTable);
+        for (auto item : txsShard->txsTable)
         {
-            continue;
-        }
-        tx->setSealed(_sealFlag);
-        if (!_sealFlag)
-        {
-            tx->setBatchId(-1);
-            tx->setBatchHash(HashType());
+            auto tx = item.second;
+            if (!tx)
+            {
+                continue;
+            }
+            markedTxs++;
+            tx->setSealed(_sealFlag);
+            if (!_sealFlag)
+            {
+                tx->setBatchId(-1);
+                tx->setBatchHash(HashType());
+                txsShard->unsealedTxs.markUnsealed(tx);
+            }
+            else
+            {
+                txsShard->unsealedTxs.markSealed(item.first);
+            }
         }
     }
+    // Note: the shards are locked one by one, only count the txs marked here
     if (_sealFlag)
     {
-        m_sealedTxsSize = m_txsTable.size();
+        m_sealedTxsSize = markedTxs;
     }
     else
     {
@@ -858,18 +1176,18 @@ void MemoryStorage::batchMarkAllTxs(bool _sealFlag)
 
 size_t MemoryStorage::unSealedTxsSize()
 {
-    ReadGuard l(x_txpoolMutex);
     return unSealedTxsSizeWithoutLock();
 }
 
 size_t MemoryStorage::unSealedTxsSizeWithoutLock()
 {
-    if (m_txsTable.size() < m_sealedTxsSize)
+    size_t txsSize = m_txsSize;
+    if (txsSize < m_sealedTxsSize)
     {
-        m_sealedTxsSize = m_txsTable.size();
+        m_sealedTxsSize = txsSize;
         return 0;
     }
-    return (m_txsTable.size() - m_sealedTxsSize);
+    return (txsSize - m_sealedTxsSize);
 }
 
 void MemoryStorage::notifyUnsealedTxsSize(size_t _retryTime)
@@ -908,15 +1226,31 @@ std::shared_ptr<HashList> MemoryStorage::batchVerifyProposal(Block::Ptr _block)
     auto batchHash = (_block && _block->blockHeader()) ? _block->blockHeader()->hash() :
                                                          bcos::crypto::HashType();
     auto startT = utcTime();
-    ReadGuard l(x_txpoolMutex);
-    auto lockT = utcTime() - startT;
-    startT = utcTime();
+    int64_t lockT = 0;
+    std::vector<bool> missedFlags(txsSize, false);
+    auto shardTxs =
+        groupByShard(txsSize, [&_block](size_t _i) { return _block->transactionHash(_i); });
+    for (size_t i = 0; i < shardTxs.size(); i++)
+    {
+        if (shardTxs[i].empty())
+        {
+            continue;
+        }
+        auto lockStartT = utcTime();
+        ReadGuard l(m_shards[i]->x_txsTable);
+        lockT += (utcTime() - lockStartT);
+        for (auto index : shardTxs[i])
+        {
+            auto txHash = _block->transactionHash(index);
+            missedFlags[index] = !m_shards[i]->txsTable.count(txHash);
+        }
+    }
+    // keep the missed txs in the order of the proposal
     for (size_t i = 0; i < txsSize; i++)
     {
-        auto txHash = _block->transactionHash(i);
-        if (!(m_txsTable.count(txHash)))
+        if (missedFlags[i])
         {
-            missedTxs->emplace_back(txHash);
+            missedTxs->emplace_back(_block->transactionHash(i));
         }
     }
     TXPOOL_LOG(INFO) << LOG_DESC("batchVerifyProposal") << LOG_KV("consNum", batchId)
@@ -927,12 +1261,22 @@ std::shared_ptr<HashList> MemoryStorage::batchVerifyProposal(Block::Ptr _block)
 
 bool MemoryStorage::batchVerifyProposal(std::shared_ptr<HashList> _txsHashList)
 {
-    ReadGuard l(x_txpoolMutex);
-    for (auto const& txHash : *_txsHashList)
+    auto const& txsHashList = *_txsHashList;
+    auto shardTxs = groupByShard(
+        txsHashList.size(), [&txsHashList](size_t _i) { return txsHashList[_i]; });
+    for (size_t i = 0; i < shardTxs.size(); i++)
     {
-        if (!(m_txsTable.count(txHash)))
+        if (shardTxs[i].empty())
         {
-            return false;
+            continue;
+        }
+        ReadGuard l(m_shards[i]->x_txsTable);
+        for (auto index : shardTxs[i])
+        {
+            if (!m_shards[i]->txsTable.count(txsHashList[index]))
+            {
+                return false;
+            }
         }
     }
     return true;
@@ -941,22 +1285,41 @@ bool MemoryStorage::batchVerifyProposal(std::shared_ptr<HashList> _txsHashList)
 HashListPtr MemoryStorage::getAllTxsHash()
 {
     auto txsHash = std::make_shared<HashList>();
-    ReadGuard l(x_txpoolMutex);
-    for (auto const& it : m_txsTable)
+    for (auto const& txsShard : m_shards)
     {
-        auto tx = it.second;
-        if (!tx)
+        ReadGuard l(txsShard->x_txsTable);
+        for (auto const& it : txsShard->txsTable)
         {
-            continue;
+            auto tx = it.second;
+            if (!tx)
+            {
+                continue;
+            }
+            txsHash->emplace_back(it.first);
         }
-        txsHash->emplace_back(it.first);
     }
     return txsHash;
 }
 
+void MemoryStorage::recordTxLatency(Transaction::ConstPtr const& _tx, TxsLatencyStat::Stage _stage)
+{
+    // the import time of the txs from the old version peers may be unknown
+    if (_tx->importTime() <= 0)
+    {
+        return;
+    }
+    m_txsLatencyStat->record(
+        m_config->senderPriority(_tx->sender()), _stage, utcTime() - _tx->importTime());
+}
+
 void MemoryStorage::cleanUpExpiredTransactions()
 {
     m_cleanUpTimer->restart();
+    if (utcTime() - m_latencyReportTime >= c_latencyReportInterval)
+    {
+        m_latencyReportTime = utcTime();
+        m_txsLatencyStat->report();
+    }
 
     // Note: In order to minimize the impact of cleanUp on performance,
     // the normal consensus node does not clear expired txs in m_clearUpTimer, but clears
@@ -965,45 +1328,53 @@ void MemoryStorage::cleanUpExpiredTransactions()
     {
         return;
     }
-    ReadGuard l(x_txpoolMutex);
-    if (m_txsTable.size() == 0)
+    if (m_txsSize == 0)
     {
         return;
     }
-    size_t traversedTxsNum = 0;
-    size_t erasedTxs = 0;
-    int64_t currentTime = utcTime();
-    for (auto it = m_txsTable.begin();
-         traversedTxsNum <= c_maxTraverseTxsNum && it != m_txsTable.end(); it++)
-    {
-        auto tx = it->second;
-        if (m_invalidTxs.count(tx->hash()))
-        {
-            continue;
-        }
-        if (tx->sealed() && tx->batchId() >= m_blockNumber)
-        {
-            continue;
-        }
-        // the txs expired or not
-        if (currentTime > (tx->importTime() + m_txsExpirationTime))
-        {
-            m_invalidTxs.insert(tx->hash());
-            m_invalidNonces.insert(tx->nonce());
-            erasedTxs++;
-        }
-        traversedTxsNum++;
-    }
-    TXPOOL_LOG(INFO) << LOG_DESC("cleanUpExpiredTransactions")
-                     << LOG_KV("pendingTxs", m_txsTable.size()) << LOG_KV("erasedTxs", erasedTxs);
+    ReadGuard l(x_invalidTxs);
+    auto erasedTxs = markExpiredTxs(utcTime());
+    TXPOOL_LOG(INFO) << METRIC << LOG_DESC("cleanUpExpiredTransactions")
+                     << LOG_KV("pendingTxs", m_txsSize) << LOG_KV("erasedTxs", erasedTxs)
+                     << LOG_KV("expiredTxsCount", m_expiredTxsCount)
+                     << LOG_KV("evictedTxsCount", m_evictedTxsCount);
     removeInvalidTxs();
 }
 
+// Note: must hold the read lock of the invalid txs
+size_t MemoryStorage::markExpiredTxs(int64_t _currentTime)
+{
+    size_t expiredTxs = 0;
+    for (auto const& txsShard : m_shards)
+    {
+        ReadGuard l(txsShard->x_txsTable);
+        expiredTxs += txsShard->expirationWheel.popExpired(
+            _currentTime, [this](HashType const& _txHash) {
+                auto tx = getTxWithoutLock(_txHash);
+                // the tx has been removed or will be removed, not counted as expired
+                if (!tx || m_invalidTxs.count(_txHash))
+                {
+                    return TxsTimingWheel::ExpiredResult::Dropped;
+                }
+                // the tx has been sealed into the proposal that has not been committed
+                if (tx->sealed() && tx->batchId() >= m_blockNumber)
+                {
+                    return TxsTimingWheel::ExpiredResult::Delayed;
+                }
+                m_invalidTxs.insert(_txHash);
+                m_invalidNonces.insert(tx->nonce());
+                return TxsTimingWheel::ExpiredResult::Expired;
+            });
+    }
+    m_expiredTxsCount += expiredTxs;
+    return expiredTxs;
+}
 
 void MemoryStorage::batchImportTxs(TransactionsPtr _txs)
 {
     auto recordT = utcTime();
-    ReadGuard l(x_txpoolMutex);
+    // the txs are imported in order after the signatures verified in parallel
+    batchVerifySignature(*_txs);
     size_t successCount = 0;
     for (auto const& tx : *_txs)
     {
@@ -1012,7 +1383,7 @@ void MemoryStorage::batchImportTxs(TransactionsPtr _txs)
             continue;
         }
         // not checkLimit when receive txs from p2p
-        auto ret = verifyAndSubmitTransaction(tx, nullptr, false, false);
+        auto ret = verifyAndSubmitTransaction(tx, nullptr, false, true);
         if (ret != TransactionStatus::None)
         {
             continue;
@@ -1027,30 +1398,43 @@ void MemoryStorage::batchImportTxs(TransactionsPtr _txs)
 bool MemoryStorage::batchVerifyAndSubmitTransaction(
     bcos::protocol::BlockHeader::Ptr _header, TransactionsPtr _txs)
 {
-    // use writeGuard here in case of the transaction status will be modified by other
-    // interfaces
     auto recordT = utcTime();
-    // use writeGuard here in case of the transaction status will be modified by other
-    // interfaces
-    WriteGuard l(x_txpoolMutex);
-    auto lockT = utcTime() - recordT;
-    recordT = utcTime();
-    for (auto const& tx : *_txs)
+    int64_t lockT = 0;
+    auto const& txs = *_txs;
+    auto shardTxs = groupByShard(txs.size(), [&txs](size_t _i) {
+        // the invalid txs are skipped
+        return txs[_i] ? txs[_i]->hash() : HashType();
+    });
+    for (size_t i = 0; i < shardTxs.size(); i++)
     {
-        if (!tx || tx->invalid())
+        if (shardTxs[i].empty())
         {
             continue;
         }
-        auto result = enforceSubmitTransaction(tx);
-        if (result != TransactionStatus::None)
+        // use writeGuard here in case of the transaction status will be modified by other
+        // interfaces
+        auto lockStartT = utcTime();
+        WriteGuard l(m_shards[i]->x_txsTable);
+        lockT += (utcTime() - lockStartT);
+        for (auto index : shardTxs[i])
         {
-            TXPOOL_LOG(WARNING) << LOG_BADGE("batchSubmitTransaction: verify proposal failed")
-                                << LOG_KV("tx", tx->hash().abridged()) << LOG_KV("result", result)
-                                << LOG_KV("txBatchID", tx->batchId())
-                                << LOG_KV("txBatchHash", tx->batchHash().abridged())
-                                << LOG_KV("consIndex", _header->number())
-                                << LOG_KV("propHash", _header->hash().abridged());
-            return false;
+            auto const& tx = txs[index];
+            if (!tx || tx->invalid())
+            {
+                continue;
+            }
+            auto result = enforceSubmitTransaction(tx);
+            if (result != TransactionStatus::None)
+            {
+                TXPOOL_LOG(WARNING)
+                    << LOG_BADGE("batchSubmitTransaction: verify proposal failed")
+                    << LOG_KV("tx", tx->hash().abridged()) << LOG_KV("result", result)
+                    << LOG_KV("txBatchID", tx->batchId())
+                    << LOG_KV("txBatchHash", tx->batchHash().abridged())
+                    << LOG_KV("consIndex", _header->number())
+                    << LOG_KV("propHash", _header->hash().abridged());
+                return false;
+            }
         }
     }
     notifyUnsealedTxsSize();
@@ -20,11 +20,15 @@
  */
 #pragma once
 #include "bcos-txpool/TxPoolConfig.h"
+#include "bcos-txpool/txpool/storage/TxsLatencyStat.h"
+#include "bcos-txpool/txpool/storage/TxsTimingWheel.h"
+#include "bcos-txpool/txpool/storage/UnsealedTxsIndex.h"
 #include <bcos-utilities/ThreadPool.h>
 #include <bcos-utilities/Timer.h>
 #include <tbb/concurrent_unordered_map.h>
 #define TBB_PREVIEW_CONCURRENT_ORDERED_CONTAINERS 1
 #include <tbb/concurrent_set.h>
+#include <limits>
 namespace bcos
 {
 namespace txpool
@@ -35,11 +39,13 @@ class MemoryStorage : public TxPoolStorageInterface,
 public:
     // the default txsExpirationTime is 10 minutes
     explicit MemoryStorage(TxPoolConfig::Ptr _config, size_t _notifyWorkerNum = 2,
-        int64_t _txsExpirationTime = 10 * 60 * 1000, bool _preStoreTxs = false);
+        int64_t _txsExpirationTime = 10 * 60 * 1000, bool _preStoreTxs = false,
+        size_t _shardsNum = 16);
     ~MemoryStorage() override {}
 
     bcos::protocol::TransactionStatus submitTransaction(bytesPointer _txData,
         bcos::protocol::TxSubmitCallback _txSubmitCallback = nullptr) override;
+    void batchSubmitTransaction(TxSubmitRequests const& _requests) override;
 
     bcos::protocol::TransactionStatus insert(bcos::protocol::Transaction::ConstPtr _tx) override;
     void batchInsert(bcos::protocol::Transactions const& _txs) override;
@@ -59,14 +65,11 @@ public:
 
     bool exist(bcos::crypto::HashType const& _txHash) override
     {
-        ReadGuard l(x_txpoolMutex);
-        return m_txsTable.count(_txHash);
-    }
-    size_t size() const override
-    {
-        ReadGuard l(x_txpoolMutex);
-        return m_txsTable.size();
+        auto const& txsShard = shard(_txHash);
+        ReadGuard l(txsShard->x_txsTable);
+        return txsShard->txsTable.count(_txHash);
     }
+    size_t size() const override { return m_txsSize; }
     void clear() override;
 
     bcos::crypto::HashListPtr filterUnknownTxs(
@@ -96,7 +99,79 @@ public:
 
     bool preStoreTxs() const override { return m_preStoreTxs; }
 
+    // the number of txs visited by the latest batchFetchTxs
+    size_t fetchTraverseCount() const { return m_fetchTraverseCount; }
+    // the number of the expired txs found by the expiration wheel
+    uint64_t expiredTxsCount() const { return m_expiredTxsCount; }
+    // the number of the invalid txs evicted from the txpool
+    uint64_t evictedTxsCount() const { return m_evictedTxsCount; }
+    size_t shardsNum() const { return m_shards.size(); }
+    TxsLatencyStat::Ptr txsLatencyStat() const { return m_txsLatencyStat; }
+
 protected:
+    // the txs are sharded by the txHash, and every shard is protected by its own lock
+    struct TxsShard
+    {
+        using Ptr = std::shared_ptr<TxsShard>;
+        explicit TxsShard(int64_t _txsExpirationTime) : expirationWheel(_txsExpirationTime) {}
+
+        tbb::concurrent_unordered_map<bcos::crypto::HashType,
+            bcos::protocol::Transaction::ConstPtr, std::hash<bcos::crypto::HashType>>
+            txsTable;
+        // the unsealed txs ordered by the import sequence
+        UnsealedTxsIndex unsealedTxs;
+        // the txs bucketed by the expiration time
+        TxsTimingWheel expirationWheel;
+        // Note: insert and query the txsTable with the read lock, erase with the write lock
+        mutable SharedMutex x_txsTable;
+    };
+
+    size_t shardIndex(bcos::crypto::HashType const& _txHash) const
+    {
+        // Note: use the tail of the txHash to avoid correlation with the hasher of the txsTable
+        uint64_t shardKey = 0;
+        memcpy(&shardKey, _txHash.data() + bcos::crypto::HashType::size - sizeof(shardKey),
+            sizeof(shardKey));
+        return shardKey % m_shards.size();
+    }
+    TxsShard::Ptr const& shard(bcos::crypto::HashType const& _txHash) const
+    {
+        return m_shards[shardIndex(_txHash)];
+    }
+    // lock all the shards in order
+    template <typename Lock>
+    std::vector<Lock> lockShards() const
+    {
+        std::vector<Lock> locks;
+        locks.reserve(m_shards.size());
+        for (auto const& txsShard : m_shards)
+        {
+            locks.emplace_back(txsShard->x_txsTable);
+        }
+        return locks;
+    }
+    // group the indexes of the txs by the shard of the txHash, so that every shard is only locked
+    // once by the batch operations
+    template <typename HashGetter>
+    std::vector<std::vector<size_t>> groupByShard(size_t _txsSize, HashGetter const& _hash) const
+    {
+        std::vector<std::vector<size_t>> shardTxs(m_shards.size());
+        for (size_t i = 0; i < _txsSize; i++)
+        {
+            shardTxs[shardIndex(_hash(i))].emplace_back(i);
+        }
+        return shardTxs;
+    }
+    // the key of the tx in the unsealed txs index, the txs with smaller key are sealed first
+    uint64_t sealOrderKey(bcos::protocol::Transaction::ConstPtr const& _tx, uint64_t _seq) const;
+    void recordTxLatency(
+        bcos::protocol::Transaction::ConstPtr const& _tx, TxsLatencyStat::Stage _stage);
+    // merge the unsealed txs of all the shards in the seal order
+    size_t traverseUnsealedTxs(UnsealedTxsIndex::Visitor const& _visitor, size_t _batchSize);
+
+    bcos::protocol::Transaction::ConstPtr getTxWithoutLock(
+        bcos::crypto::HashType const& _txHash) const;
+
     bcos::protocol::TransactionStatus insertWithoutLock(bcos::protocol::Transaction::ConstPtr _tx);
     bcos::protocol::TransactionStatus enforceSubmitTransaction(
         bcos::protocol::Transaction::Ptr _tx);
@@ -104,6 +179,8 @@ protected:
         bcos::protocol::Transaction::Ptr _tx, bcos::protocol::TxSubmitCallback _txSubmitCallback,
         bool _checkPoolLimit, bool _lock);
     size_t unSealedTxsSizeWithoutLock();
+    // recover the sender of the txs in parallel, the invalid txs will be marked
+    void batchVerifySignature(bcos::protocol::Transactions const& _txs);
     bcos::protocol::TransactionStatus txpoolStorageCheck(bcos::protocol::Transaction::ConstPtr _tx);
 
     virtual bcos::protocol::Transaction::ConstPtr removeWithoutLock(
@@ -124,30 +201,47 @@ protected:
 
     virtual void notifyUnsealedTxsSize(size_t _retryTime = 0);
     virtual void cleanUpExpiredTransactions();
+    // mark the expired txs as invalid, return the number of the expired txs
+    // Note: must hold the read lock of the invalid txs
+    virtual size_t markExpiredTxs(int64_t _currentTime);
 
-    virtual void batchMarkTxsWithoutLock(bcos::crypto::HashList const& _txsHashList,
+    // Note: must hold the lock of the shard of the tx, return true if the tx is marked
+    virtual bool markTxWithoutLock(bcos::crypto::HashType const& _txHash,
         bcos::protocol::BlockNumber _batchId, bcos::crypto::HashType const& _batchHash,
         bool _sealFlag);
 
+    // check the given tx can be sealed or not, and append the sealable tx to the block
+    virtual UnsealedTxsIndex::VisitResult fetchTx(bcos::protocol::Transaction::ConstPtr const& _tx,
+        bcos::protocol::Block::Ptr _txsList, bcos::protocol::Block::Ptr _sysTxsList,
+        size_t _txsLimit, TxsHashSetPtr _avoidTxs, bool _avoidDuplicate, int64_t _currentTime);
+
 protected:
     TxPoolConfig::Ptr m_config;
     ThreadPool::Ptr m_notifier;
     ThreadPool::Ptr m_worker;
 
-    tbb::concurrent_unordered_map<bcos::crypto::HashType, bcos::protocol::Transaction::ConstPtr,
-        std::hash<bcos::crypto::HashType>>
-        m_txsTable;
-
-    mutable SharedMutex x_txpoolMutex;
+    std::vector<TxsShard::Ptr> m_shards;
+    std::atomic<size_t> m_txsSize = {0};
+    // the import sequence of the txs
+    std::atomic<uint64_t> m_txsSeq = {0};
+    TxsLatencyStat::Ptr m_txsLatencyStat;
+    std::atomic<int64_t> m_latencyReportTime = {0};
+    // report the latency of the txs every 10s
+    int64_t c_latencyReportInterval = 10000;
 
     tbb::concurrent_set<bcos::crypto::HashType> m_invalidTxs;
     tbb::concurrent_set<bcos::protocol::NonceType> m_invalidNonces;
+    // Note: insert and query the invalid txs with the read lock, take them out with the write lock
+    mutable SharedMutex x_invalidTxs;
 
     tbb::concurrent_set<bcos::crypto::HashType> m_missedTxs;
     mutable SharedMutex x_missedTxs;
     std::atomic<size_t> m_sealedTxsSize = {0};
+    std::atomic<size_t> m_fetchTraverseCount = {0};
 
     size_t c_maxRetryTime = 3;
+    // the minimum number of the unsealed txs fetched from every shard in one round
+    size_t c_minFetchBatchSize = 64;
 
     std::atomic<bcos::protocol::BlockNumber> m_blockNumber = {0};
     std::atomic_bool m_printed = {false};
@@ -157,9 +251,8 @@ protected:
     int64_t m_txsExpirationTime = 10 * 60 * 1000;
     // timer to clear up the expired txs in-period
     std::shared_ptr<Timer> m_cleanUpTimer;
-    // Maximum number of transactions traversed by m_cleanUpTimer,
-    // The limit set here is to minimize the impact of the cleanup operation on txpool performance
-    uint64_t c_maxTraverseTxsNum = 10000;
+    std::atomic<uint64_t> m_expiredTxsCount = {0};
+    std::atomic<uint64_t> m_evictedTxsCount = {0};
 
     // for tps stat
     std::atomic<int64_t> m_tpsStatstartTime = {0};
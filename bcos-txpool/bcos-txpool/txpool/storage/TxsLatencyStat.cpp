@@ -0,0 +1,117 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief latency histograms of the txs of every priority class
+ * @file TxsLatencyStat.cpp
+ * @date 2022-07-11
+ */
+#include "bcos-txpool/txpool/storage/TxsLatencyStat.h"
+#include <bcos-framework/interfaces/txpool/TxPoolTypeDef.h>
+
+using namespace bcos;
+using namespace bcos::txpool;
+
+void LatencyHistogram::record(int64_t _latency)
+{
+    // bucket i records the latency in [2^(i-1), 2^i)
+    size_t bucket = 0;
+    while (_latency > 0 && bucket < c_bucketsNum - 1)
+    {
+        _latency >>= 1;
+        bucket++;
+    }
+    m_buckets[bucket]++;
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::take()
+{
+    Snapshot snapshot;
+    for (size_t i = 0; i < c_bucketsNum; i++)
+    {
+        snapshot.buckets[i] = m_buckets[i].exchange(0);
+        snapshot.count += snapshot.buckets[i];
+    }
+    return snapshot;
+}
+
+int64_t LatencyHistogram::Snapshot::percentile(double _percent) const
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    auto expectedCount = (uint64_t)(count * _percent / 100);
+    uint64_t currentCount = 0;
+    for (size_t i = 0; i < c_bucketsNum; i++)
+    {
+        currentCount += buckets[i];
+        if (currentCount > expectedCount)
+        {
+            return ((int64_t)1 << i);
+        }
+    }
+    return ((int64_t)1 << (c_bucketsNum - 1));
+}
+
+TxsLatencyStat::ClassLatency::Ptr TxsLatencyStat::classLatency(uint8_t _priority)
+{
+    {
+        ReadGuard l(x_classLatency);
+        auto it = m_classLatency.find(_priority);
+        if (it != m_classLatency.end())
+        {
+            return it->second;
+        }
+    }
+    WriteGuard l(x_classLatency);
+    auto& latency = m_classLatency[_priority];
+    if (!latency)
+    {
+        latency = std::make_shared<ClassLatency>();
+    }
+    return latency;
+}
+
+void TxsLatencyStat::record(uint8_t _priority, Stage _stage, int64_t _latency)
+{
+    auto latency = classLatency(_priority);
+    if (_stage == Stage::Seal)
+    {
+        latency->sealLatency.record(_latency);
+        return;
+    }
+    latency->commitLatency.record(_latency);
+}
+
+void TxsLatencyStat::report()
+{
+    ReadGuard l(x_classLatency);
+    for (auto const& it : m_classLatency)
+    {
+        auto sealLatency = it.second->sealLatency.take();
+        auto commitLatency = it.second->commitLatency.take();
+        if (sealLatency.count == 0 && commitLatency.count == 0)
+        {
+            continue;
+        }
+        TXPOOL_LOG(INFO) << METRIC << LOG_DESC("txsLatency") << LOG_KV("priority", (int)it.first)
+                         << LOG_KV("sealedTxs", sealLatency.count)
+                         << LOG_KV("sealP50(ms)", sealLatency.percentile(50))
+                         << LOG_KV("sealP99(ms)", sealLatency.percentile(99))
+                         << LOG_KV("committedTxs", commitLatency.count)
+                         << LOG_KV("commitP50(ms)", commitLatency.percentile(50))
+                         << LOG_KV("commitP99(ms)", commitLatency.percentile(99));
+    }
+}
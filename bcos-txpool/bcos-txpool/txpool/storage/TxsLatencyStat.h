@@ -0,0 +1,93 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief latency histograms of the txs of every priority class
+ * @file TxsLatencyStat.h
+ * @date 2022-07-11
+ */
+#pragma once
+#include <bcos-utilities/Common.h>
+#include <array>
+#include <atomic>
+#include <map>
+
+namespace bcos
+{
+namespace txpool
+{
+// histogram with power-of-two buckets in milliseconds
+class LatencyHistogram
+{
+public:
+    static constexpr size_t c_bucketsNum = 32;
+    // the latencies taken out of the histogram
+    struct Snapshot
+    {
+        std::array<uint64_t, c_bucketsNum> buckets = {};
+        uint64_t count = 0;
+        // the upper bound of the bucket that contains the given percentile, in milliseconds
+        int64_t percentile(double _percent) const;
+    };
+
+    LatencyHistogram()
+    {
+        for (auto& bucket : m_buckets)
+        {
+            bucket = 0;
+        }
+    }
+
+    void record(int64_t _latency);
+    // take the recorded latencies out and reset every bucket with one atomic exchange, so that
+    // every latency recorded concurrently is taken exactly once
+    Snapshot take();
+
+private:
+    std::array<std::atomic<uint64_t>, c_bucketsNum> m_buckets;
+};
+
+class TxsLatencyStat
+{
+public:
+    using Ptr = std::shared_ptr<TxsLatencyStat>;
+    enum class Stage : uint8_t
+    {
+        // from import to seal
+        Seal = 0,
+        // from import to commit
+        Commit = 1,
+    };
+    TxsLatencyStat() = default;
+    virtual ~TxsLatencyStat() {}
+
+    void record(uint8_t _priority, Stage _stage, int64_t _latency);
+    // print the latency of every priority class since the last report, and reset the histograms
+    void report();
+
+private:
+    struct ClassLatency
+    {
+        using Ptr = std::shared_ptr<ClassLatency>;
+        LatencyHistogram sealLatency;
+        LatencyHistogram commitLatency;
+    };
+    ClassLatency::Ptr classLatency(uint8_t _priority);
+
+private:
+    std::map<uint8_t, ClassLatency::Ptr> m_classLatency;
+    mutable SharedMutex x_classLatency;
+};
+}  // namespace txpool
+}  // namespace bcos
@@ -0,0 +1,109 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief time-bucketed expiration index of the txs in the txpool
+ * @file TxsTimingWheel.cpp
+ * @date 2022-07-04
+ */
+#include "bcos-txpool/txpool/storage/TxsTimingWheel.h"
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::crypto;
+using namespace bcos::protocol;
+
+void TxsTimingWheel::insert(Transaction::ConstPtr const& _tx)
+{
+    auto bucket = (_tx->importTime() + m_expirationTime) / m_granularity;
+    Guard l(x_buckets);
+    insertWithoutLock(_tx->hash(), bucket);
+}
+
+void TxsTimingWheel::insertWithoutLock(HashType const& _txHash, int64_t _bucket)
+{
+    auto result = m_txsBucket.insert(std::make_pair(_txHash, _bucket));
+    if (!result.second)
+    {
+        return;
+    }
+    m_buckets[_bucket].insert(_txHash);
+}
+
+void TxsTimingWheel::remove(HashType const& _txHash)
+{
+    Guard l(x_buckets);
+    auto it = m_txsBucket.find(_txHash);
+    if (it == m_txsBucket.end())
+    {
+        return;
+    }
+    auto bucketIt = m_buckets.find(it->second);
+    if (bucketIt != m_buckets.end())
+    {
+        bucketIt->second.erase(_txHash);
+        if (bucketIt->second.empty())
+        {
+            m_buckets.erase(bucketIt);
+        }
+    }
+    m_txsBucket.erase(it);
+}
+
+size_t TxsTimingWheel::popExpired(int64_t _currentTime, ExpiredHandler const& _handler)
+{
+    Guard l(x_buckets);
+    // the bucket of _currentTime may contain the unexpired txs, only pop the buckets before it
+    auto currentBucket = _currentTime / m_granularity;
+    size_t expiredTxs = 0;
+    std::vector<HashType> delayedTxs;
+    for (auto it = m_buckets.begin(); it != m_buckets.end() && it->first < currentBucket;)
+    {
+        for (auto const& txHash : it->second)
+        {
+            auto result = _handler(txHash);
+            if (result == ExpiredResult::Delayed)
+            {
+                delayedTxs.emplace_back(txHash);
+                continue;
+            }
+            if (result == ExpiredResult::Expired)
+            {
+                expiredTxs++;
+            }
+            m_txsBucket.erase(txHash);
+        }
+        it = m_buckets.erase(it);
+    }
+    // the delayed txs will be checked again in the next bucket
+    for (auto const& txHash : delayedTxs)
+    {
+        m_txsBucket.erase(txHash);
+        insertWithoutLock(txHash, currentBucket);
+    }
+    return expiredTxs;
+}
+
+void TxsTimingWheel::clear()
+{
+    Guard l(x_buckets);
+    m_buckets.clear();
+    m_txsBucket.clear();
+}
+
+size_t TxsTimingWheel::size() const
+{
+    Guard l(x_buckets);
+    return m_txsBucket.size();
+}
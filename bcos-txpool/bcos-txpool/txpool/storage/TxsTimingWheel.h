@@ -0,0 +1,82 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief time-bucketed expiration index of the txs in the txpool
+ * @file TxsTimingWheel.h
+ * @date 2022-07-04
+ */
+#pragma once
+#include <bcos-framework/interfaces/protocol/Transaction.h>
+#include <bcos-utilities/Common.h>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace bcos
+{
+namespace txpool
+{
+/**
+ * the txs are bucketed by the expiration deadline (importTime + expirationTime), every bucket
+ * covers _granularity milliseconds, so popping the expired txs only visits the expired buckets
+ */
+class TxsTimingWheel
+{
+public:
+    using Ptr = std::shared_ptr<TxsTimingWheel>;
+    enum class ExpiredResult : int8_t
+    {
+        // the tx expires, drop it from the wheel
+        Expired = 0,
+        // the tx has been removed or marked invalid already, drop it without counting
+        Dropped = 1,
+        // keep the tx and check it again later
+        Delayed = 2,
+    };
+    using ExpiredHandler = std::function<ExpiredResult(bcos::crypto::HashType const&)>;
+
+    TxsTimingWheel(int64_t _expirationTime, int64_t _granularity = 1000)
+      : m_expirationTime(_expirationTime), m_granularity(std::max(_granularity, (int64_t)1))
+    {}
+    virtual ~TxsTimingWheel() {}
+
+    void insert(bcos::protocol::Transaction::ConstPtr const& _tx);
+    void remove(bcos::crypto::HashType const& _txHash);
+    // pop the txs of the expired buckets, return the number of the expired txs
+    size_t popExpired(int64_t _currentTime, ExpiredHandler const& _handler);
+
+    void clear();
+    size_t size() const;
+
+    int64_t expirationTime() const { return m_expirationTime; }
+    int64_t granularity() const { return m_granularity; }
+
+private:
+    void insertWithoutLock(bcos::crypto::HashType const& _txHash, int64_t _bucket);
+
+private:
+    int64_t m_expirationTime;
+    int64_t m_granularity;
+    // bucket => txs expire in the bucket
+    std::map<int64_t, std::unordered_set<bcos::crypto::HashType, std::hash<bcos::crypto::HashType>>>
+        m_buckets;
+    // txHash => bucket
+    std::unordered_map<bcos::crypto::HashType, int64_t, std::hash<bcos::crypto::HashType>>
+        m_txsBucket;
+    mutable Mutex x_buckets;
+};
+}  // namespace txpool
+}  // namespace bcos
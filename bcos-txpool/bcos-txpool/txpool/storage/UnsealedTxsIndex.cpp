@@ -0,0 +1,103 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief ordered index of the unsealed transactions of the txpool
+ * @file UnsealedTxsIndex.cpp
+ * @date 2022-07-01
+ */
+#include "bcos-txpool/txpool/storage/UnsealedTxsIndex.h"
+
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::crypto;
+using namespace bcos::protocol;
+
+void UnsealedTxsIndex::insert(Transaction::ConstPtr const& _tx, uint64_t _seq)
+{
+    Guard l(x_index);
+    auto result = m_txsSeq.insert(std::make_pair(_tx->hash(), _seq));
+    if (!result.second)
+    {
+        return;
+    }
+    if (!_tx->sealed())
+    {
+        m_sealableTxs[_seq] = _tx;
+    }
+}
+
+void UnsealedTxsIndex::remove(HashType const& _txHash)
+{
+    Guard l(x_index);
+    auto it = m_txsSeq.find(_txHash);
+    if (it == m_txsSeq.end())
+    {
+        return;
+    }
+    m_sealableTxs.erase(it->second);
+    m_txsSeq.erase(it);
+}
+
+void UnsealedTxsIndex::markSealed(HashType const& _txHash)
+{
+    Guard l(x_index);
+    auto it = m_txsSeq.find(_txHash);
+    if (it == m_txsSeq.end())
+    {
+        return;
+    }
+    m_sealableTxs.erase(it->second);
+}
+
+void UnsealedTxsIndex::markUnsealed(Transaction::ConstPtr const& _tx)
+{
+    Guard l(x_index);
+    auto it = m_txsSeq.find(_tx->hash());
+    if (it == m_txsSeq.end())
+    {
+        return;
+    }
+    m_sealableTxs[it->second] = _tx;
+}
+
+bool UnsealedTxsIndex::fetch(uint64_t _fromSeq, size_t _limit, std::vector<SealableTx>& _txs) const
+{
+    Guard l(x_index);
+    auto it = m_sealableTxs.lower_bound(_fromSeq);
+    for (; it != m_sealableTxs.end() && _txs.size() < _limit; it++)
+    {
+        _txs.emplace_back(it->first, it->second);
+    }
+    return (it != m_sealableTxs.end());
+}
+
+void UnsealedTxsIndex::clear()
+{
+    Guard l(x_index);
+    m_sealableTxs.clear();
+    m_txsSeq.clear();
+}
+
+size_t UnsealedTxsIndex::sealableSize() const
+{
+    Guard l(x_index);
+    return m_sealableTxs.size();
+}
+
+size_t UnsealedTxsIndex::size() const
+{
+    Guard l(x_index);
+    return m_txsSeq.size();
+}
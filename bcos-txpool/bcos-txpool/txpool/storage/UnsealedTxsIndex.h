@@ -0,0 +1,84 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief ordered index of the unsealed transactions of the txpool
+ * @file UnsealedTxsIndex.h
+ * @date 2022-07-01
+ */
+#pragma once
+#include <bcos-framework/interfaces/protocol/Transaction.h>
+#include <bcos-utilities/Common.h>
+#include <functional>
+#include <map>
+#include <unordered_map>
+
+namespace bcos
+{
+namespace txpool
+{
+/**
+ * the index records the import sequence of all the txs in the txpool(shard), and keeps the txs
+ * that can be sealed ordered by the import sequence, so that fetching N txs only visits the
+ * unsealed txs instead of traversing the whole txpool
+ */
+class UnsealedTxsIndex
+{
+public:
+    using Ptr = std::shared_ptr<UnsealedTxsIndex>;
+    enum class VisitResult : int8_t
+    {
+        // keep the tx sealable and visit the next one
+        Keep = 0,
+        // remove the tx from the sealable txs and visit the next one
+        Remove = 1,
+        // stop the traversal
+        Stop = 2,
+    };
+    using Visitor = std::function<VisitResult(bcos::protocol::Transaction::ConstPtr const&)>;
+    // import sequence => sealable tx
+    using SealableTx = std::pair<uint64_t, bcos::protocol::Transaction::ConstPtr>;
+
+    UnsealedTxsIndex() = default;
+    virtual ~UnsealedTxsIndex() {}
+
+    // insert the tx with the given import sequence, the tx is sealable if it has not been sealed
+    void insert(bcos::protocol::Transaction::ConstPtr const& _tx, uint64_t _seq);
+    // remove the tx from the index
+    void remove(bcos::crypto::HashType const& _txHash);
+    // the tx has been sealed, remove it from the sealable txs
+    void markSealed(bcos::crypto::HashType const& _txHash);
+    // the tx has been unsealed, re-add it to the sealable txs with the origin import sequence
+    void markUnsealed(bcos::protocol::Transaction::ConstPtr const& _tx);
+
+    // copy at most _limit sealable txs whose import sequence is not less than _fromSeq,
+    // return true if there are more sealable txs after the copied ones
+    bool fetch(uint64_t _fromSeq, size_t _limit, std::vector<SealableTx>& _txs) const;
+
+    void clear();
+    // the number of the sealable txs
+    size_t sealableSize() const;
+    // the number of all the indexed txs
+    size_t size() const;
+
+private:
+    // import sequence => sealable tx
+    std::map<uint64_t, bcos::protocol::Transaction::ConstPtr> m_sealableTxs;
+    // txHash => import sequence, contains all the txs of the txpool
+    std::unordered_map<bcos::crypto::HashType, uint64_t, std::hash<bcos::crypto::HashType>>
+        m_txsSeq;
+    mutable Mutex x_index;
+};
+}  // namespace txpool
+}  // namespace bcos
@@ -92,8 +92,11 @@ void LedgerNonceChecker::batchInsert(BlockNumber _batchId, NonceListPtr _nonceLi
     }
     auto nonceList = m_blockNonceCache[batchToBeRemoved];
     m_blockNonceCache.erase(batchToBeRemoved);
+    // the nonces of the expired block are removed from the nonce filter together
     batchRemove(*nonceList);
     NONCECHECKER_LOG(DEBUG) << LOG_DESC("batchInsert: remove expired nonce")
                             << LOG_KV("batchToBeRemoved", batchToBeRemoved)
-                            << LOG_KV("nonceSize", nonceList->size());
+                            << LOG_KV("nonceSize", nonceList->size())
+                            << LOG_KV("filteredChecks", filteredChecks())
+                            << LOG_KV("exactChecks", exactChecks());
 }
\ No newline at end of file
@@ -32,7 +32,10 @@ public:
     LedgerNonceChecker(
         std::shared_ptr<std::map<int64_t, bcos::protocol::NonceListPtr> > _initialNonces,
         bcos::protocol::BlockNumber _blockNumber, int64_t _blockLimit)
-      : TxPoolNonceChecker(), m_blockNumber(_blockNumber), m_blockLimit(_blockLimit)
+      : TxPoolNonceChecker(std::max(
+            c_defaultExpectedNonces, (size_t)std::max(_blockLimit, (int64_t)1) * c_blockNonces)),
+        m_blockNumber(_blockNumber),
+        m_blockLimit(_blockLimit)
     {
         if (_initialNonces)
         {
@@ -51,6 +54,8 @@ protected:
     virtual void initNonceCache(std::map<int64_t, bcos::protocol::NonceListPtr> _initialNonces);
 
 private:
+    // the expected number of the nonces of every block, used to size the nonce filter
+    static constexpr size_t c_blockNonces = 1000;
     std::atomic<bcos::protocol::BlockNumber> m_blockNumber = {0};
     int64_t m_blockLimit;
 
@@ -0,0 +1,83 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief counting bloom filter for the nonces
+ * @file NonceBloomFilter.cpp
+ * @date 2022-07-08
+ */
+#include "NonceBloomFilter.h"
+
+using namespace bcos;
+using namespace bcos::protocol;
+using namespace bcos::txpool;
+
+NonceBloomFilter::NonceBloomFilter(size_t _expectedNonces, size_t _hashNum)
+  : m_hashNum(std::max(_hashNum, (size_t)1))
+{
+    // 8 counters for every nonce, the false positive rate is about 2.4% with 4 hashes
+    size_t countersNum = 1;
+    while (countersNum < std::max(_expectedNonces, (size_t)1) * 8)
+    {
+        countersNum <<= 1;
+    }
+    m_countersMask = countersNum - 1;
+    m_counters.reset(new std::atomic<uint8_t>[countersNum]);
+    clear();
+}
+
+void NonceBloomFilter::insert(NonceType const& _nonce)
+{
+    forEachCounter(_nonce, [](std::atomic<uint8_t>& _counter) {
+        auto count = _counter.load();
+        while (count < c_maxCount && !_counter.compare_exchange_weak(count, count + 1))
+        {
+        }
+        return true;
+    });
+}
+
+void NonceBloomFilter::remove(NonceType const& _nonce)
+{
+    forEachCounter(_nonce, [](std::atomic<uint8_t>& _counter) {
+        auto count = _counter.load();
+        // the saturated counter may be shared by more nonces than it can record
+        while (count > 0 && count < c_maxCount &&
+               !_counter.compare_exchange_weak(count, count - 1))
+        {
+        }
+        return true;
+    });
+}
+
+bool NonceBloomFilter::mayContain(NonceType const& _nonce) const
+{
+    bool contain = true;
+    forEachCounter(_nonce, [&contain](std::atomic<uint8_t> const& _counter) {
+        if (_counter.load() == 0)
+        {
+            contain = false;
+        }
+        return contain;
+    });
+    return contain;
+}
+
+void NonceBloomFilter::clear()
+{
+    for (size_t i = 0; i <= m_countersMask; i++)
+    {
+        m_counters[i].store(0);
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief counting bloom filter for the nonces
+ * @file NonceBloomFilter.h
+ * @date 2022-07-08
+ */
+#pragma once
+#include <bcos-framework/interfaces/protocol/ProtocolTypeDef.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace bcos
+{
+namespace txpool
+{
+/**
+ * lock-free counting bloom filter with saturating 8-bit counters, used to answer "the nonce is
+ * new" without querying the locked nonce set; the nonce may exist only when mayContain is true
+ */
+class NonceBloomFilter
+{
+public:
+    using Ptr = std::shared_ptr<NonceBloomFilter>;
+    NonceBloomFilter(size_t _expectedNonces, size_t _hashNum = 4);
+    virtual ~NonceBloomFilter() {}
+
+    void insert(bcos::protocol::NonceType const& _nonce);
+    // Note: only remove the nonce that has been inserted
+    void remove(bcos::protocol::NonceType const& _nonce);
+    bool mayContain(bcos::protocol::NonceType const& _nonce) const;
+    void clear();
+
+    size_t countersNum() const { return m_countersMask + 1; }
+    size_t hashNum() const { return m_hashNum; }
+
+private:
+    template <typename Handler>
+    void forEachCounter(bcos::protocol::NonceType const& _nonce, Handler&& _handler) const
+    {
+        // double hashing: the i-th counter is (h1 + i * h2)
+        auto hash = std::hash<bcos::protocol::NonceType>()(_nonce);
+        uint64_t h1 = mix(hash);
+        uint64_t h2 = mix(h1) | 1;
+        for (size_t i = 0; i < m_hashNum; i++)
+        {
+            if (!_handler(m_counters[(h1 + i * h2) & m_countersMask]))
+            {
+                return;
+            }
+        }
+    }
+    static uint64_t mix(uint64_t _value)
+    {
+        // the finalizer of splitmix64
+        _value += 0x9e3779b97f4a7c15ULL;
+        _value = (_value ^ (_value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        _value = (_value ^ (_value >> 27)) * 0x94d049bb133111ebULL;
+        return _value ^ (_value >> 31);
+    }
+
+private:
+    // the counter will not be changed any more once saturated
+    static constexpr uint8_t c_maxCount = UINT8_MAX;
+    size_t m_hashNum;
+    size_t m_countersMask;
+    std::unique_ptr<std::atomic<uint8_t>[]> m_counters;
+};
+}  // namespace txpool
+}  // namespace bcos
@@ -26,6 +26,12 @@ using namespace bcos::txpool;
 
 bool TxPoolNonceChecker::exists(NonceType const& _nonce)
 {
+    if (!m_nonceFilter.mayContain(_nonce))
+    {
+        m_filteredChecks++;
+        return false;
+    }
+    m_exactChecks++;
     ReadGuard l(x_nonceCache);
     if (m_nonceCache.count(_nonce))
     {
@@ -36,15 +42,26 @@ bool TxPoolNonceChecker::exists(NonceType const& _nonce)
 
 TransactionStatus TxPoolNonceChecker::checkNonce(Transaction::ConstPtr _tx, bool _shouldUpdate)
 {
-    ReadGuard l(x_nonceCache);
     auto nonce = _tx->nonce();
+    // the nonce is new, no need to query the nonceCache
+    if (!m_nonceFilter.mayContain(nonce))
+    {
+        m_filteredChecks++;
+        if (_shouldUpdate)
+        {
+            insert(nonce);
+        }
+        return TransactionStatus::None;
+    }
+    m_exactChecks++;
+    ReadGuard l(x_nonceCache);
     if (m_nonceCache.count(nonce))
     {
         return TransactionStatus::NonceCheckFail;
     }
     if (_shouldUpdate)
     {
-        m_nonceCache.insert(nonce);
+        insertWithoutLock(nonce);
     }
     return TransactionStatus::None;
 }
@@ -52,7 +69,15 @@ TransactionStatus TxPoolNonceChecker::checkNonce(Transaction::ConstPtr _tx, bool
 void TxPoolNonceChecker::insert(NonceType const& _nonce)
 {
     ReadGuard l(x_nonceCache);
-    m_nonceCache.insert(_nonce);
+    insertWithoutLock(_nonce);
+}
+
+void TxPoolNonceChecker::insertWithoutLock(NonceType const& _nonce)
+{
+    if (m_nonceCache.insert(_nonce).second)
+    {
+        m_nonceFilter.insert(_nonce);
+    }
 }
 
 void TxPoolNonceChecker::batchInsert(BlockNumber, NonceListPtr _nonceList)
@@ -60,7 +85,7 @@ void TxPoolNonceChecker::batchInsert(BlockNumber, NonceListPtr _nonceList)
     ReadGuard l(x_nonceCache);
     for (auto const& nonce : *_nonceList)
     {
-        m_nonceCache.insert(nonce);
+        insertWithoutLock(nonce);
     }
 }
 
@@ -69,6 +94,7 @@ void TxPoolNonceChecker::remove(NonceType const& _nonce)
     if (m_nonceCache.count(_nonce))
     {
         m_nonceCache.unsafe_erase(_nonce);
+        m_nonceFilter.remove(_nonce);
     }
 }
 
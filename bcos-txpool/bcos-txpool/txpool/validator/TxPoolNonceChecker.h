@@ -20,6 +20,7 @@
  */
 #pragma once
 #include "bcos-txpool/txpool/interfaces/NonceCheckerInterface.h"
+#include "bcos-txpool/txpool/validator/NonceBloomFilter.h"
 #include <tbb/concurrent_unordered_set.h>
 namespace bcos
 {
@@ -28,7 +29,9 @@ namespace txpool
 class TxPoolNonceChecker : public NonceCheckerInterface
 {
 public:
-    TxPoolNonceChecker() = default;
+    explicit TxPoolNonceChecker(size_t _expectedNonces = c_defaultExpectedNonces)
+      : m_nonceFilter(_expectedNonces)
+    {}
     bcos::protocol::TransactionStatus checkNonce(
         bcos::protocol::Transaction::ConstPtr _tx, bool _shouldUpdate = false) override;
     void batchInsert(
@@ -39,11 +42,24 @@ public:
 
     void insert(bcos::protocol::NonceType const& _nonce) override;
 
+    // the number of the checks answered by the filter without accessing the nonceCache
+    uint64_t filteredChecks() const { return m_filteredChecks; }
+    // the number of the checks that query the nonceCache
+    uint64_t exactChecks() const { return m_exactChecks; }
+
+    static constexpr size_t c_defaultExpectedNonces = 1 << 18;
+
 protected:
     void remove(bcos::protocol::NonceType const& _nonce) override;
+    void insertWithoutLock(bcos::protocol::NonceType const& _nonce);
 
     tbb::concurrent_unordered_set<bcos::protocol::NonceType> m_nonceCache;
     mutable SharedMutex x_nonceCache;
+    // Note: the nonce is inserted into the filter after inserted into the nonceCache, and removed
+    // from the filter after removed from the nonceCache
+    NonceBloomFilter m_nonceFilter;
+    std::atomic<uint64_t> m_filteredChecks = {0};
+    std::atomic<uint64_t> m_exactChecks = {0};
 };
 }  // namespace txpool
 }  // namespace bcos
\ No newline at end of file
@@ -79,9 +79,106 @@ void testSubmitAndRemoveTransaction(bcos::crypto::CryptoSuite::Ptr _cryptoSuite,
     faker.reset();
 }
 
+using StorageCreator = std::function<TxPoolStorageInterface::Ptr(TxPoolConfig::Ptr)>;
+// submit txs from multiple threads while sealing and removing them concurrently
+void testConcurrentSubmitSealAndRemove(bcos::crypto::CryptoSuite::Ptr _cryptoSuite, size_t _count,
+    size_t _threadNum, std::string const& _storageName, StorageCreator const& _createStorage)
+{
+    auto signatureImpl = _cryptoSuite->signatureImpl();
+    auto keyPair = signatureImpl->generateKeyPair();
+    std::string groupId = "group_test_for_txpool";
+    std::string chainId = "chain_test_for_txpool";
+    int64_t blockLimit = 1000;
+    auto fakeGateWay = std::make_shared<FakeGateWay>();
+    auto faker = std::make_shared<TxPoolFixture>(
+        keyPair->publicKey(), _cryptoSuite, groupId, chainId, blockLimit, fakeGateWay);
+    faker->init();
+    faker->appendSealer(faker->nodeID());
+    auto ledger = faker->ledger();
+    auto txpool = faker->txpool();
+    auto txpoolConfig = txpool->txpoolConfig();
+    txpoolConfig->setPoolLimit(_count + 1000);
+    auto memoryStorage = _createStorage(txpoolConfig);
+    txpool->setTxPoolStorage(memoryStorage);
+
+    // generate the txs in advance to exclude the signature cost
+    std::vector<Transaction::Ptr> txs(_count);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, _count), [&](auto const& _range) {
+        for (auto i = _range.begin(); i < _range.end(); i++)
+        {
+            txs[i] = fakeTransaction(_cryptoSuite, 1000 + i,
+                ledger->blockNumber() + blockLimit - 4, faker->chainId(), faker->groupId());
+        }
+    });
+
+    size_t batchSize = 100;
+    size_t txsLimit = 1000;
+    std::atomic<size_t> removedTxs = {0};
+    std::atomic_bool submitFinished = {false};
+    auto startT = utcTime();
+    // the sealer: fetch the unsealed txs and remove them as committed
+    std::thread sealer([&]() {
+        auto blockNumber = ledger->blockNumber();
+        while (removedTxs < _count)
+        {
+            auto txsList = txpoolConfig->blockFactory()->createBlock();
+            auto sysTxsList = txpoolConfig->blockFactory()->createBlock();
+            memoryStorage->batchFetchTxs(
+                txsList, sysTxsList, txsLimit, std::make_shared<TxsHashSet>(), true);
+            auto fetchedTxs = txsList->transactionsMetaDataSize();
+            if (fetchedTxs == 0)
+            {
+                if (submitFinished && memoryStorage->size() == 0)
+                {
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+            TransactionSubmitResults txsResult;
+            for (size_t i = 0; i < fetchedTxs; i++)
+            {
+                auto result = std::make_shared<TransactionSubmitResultImpl>();
+                result->setTxHash(txsList->transactionMetaData(i)->hash());
+                txsResult.emplace_back(result);
+            }
+            memoryStorage->batchRemove(++blockNumber, txsResult);
+            removedTxs += fetchedTxs;
+        }
+    });
+    // the submitters: import the txs concurrently
+    std::vector<std::thread> submitters;
+    for (size_t threadIndex = 0; threadIndex < _threadNum; threadIndex++)
+    {
+        submitters.emplace_back([&, threadIndex]() {
+            for (size_t offset = threadIndex * batchSize; offset < _count;
+                 offset += _threadNum * batchSize)
+            {
+                auto txsBatch = std::make_shared<Transactions>(txs.begin() + offset,
+                    txs.begin() + std::min(offset + batchSize, _count));
+                memoryStorage->batchImportTxs(txsBatch);
+            }
+        });
+    }
+    for (auto& submitter : submitters)
+    {
+        submitter.join();
+    }
+    auto submitT = utcTime() - startT;
+    submitFinished = true;
+    sealer.join();
+    auto totalT = std::max(utcTime() - startT, (int64_t)1);
+    std::cout << "### concurrent submit/seal/remove, storage: " << _storageName
+              << ", threadNum: " << _threadNum << ", txs: " << _count
+              << ", removedTxs: " << removedTxs << ", submitT(ms): " << submitT
+              << ", totalT(ms): " << totalT << ", tps: " << (removedTxs * 1000 / totalT)
+              << std::endl;
+    faker.reset();
+}
+
 void Usage(std::string const& _appName)
 {
-    std::cout << _appName << " count" << std::endl;
+    std::cout << _appName << " count [threadNum] [shardsNum]" << std::endl;
 }
 
 int main(int argc, char* argv[])
@@ -92,9 +189,29 @@ int main(int argc, char* argv[])
         return -1;
     }
     size_t count = atoi(argv[1]);
+    size_t threadNum = std::thread::hardware_concurrency();
+    if (argc > 2)
+    {
+        threadNum = std::max(atoi(argv[2]), 1);
+    }
+    size_t shardsNum = 16;
+    if (argc > 3)
+    {
+        shardsNum = std::max(atoi(argv[3]), 1);
+    }
     auto hashImpl = std::make_shared<Keccak256>();
     auto signatureImpl = std::make_shared<Secp256k1Crypto>();
     auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
     testSubmitAndRemoveTransaction(cryptoSuite, count);
+    // compare the unsharded txpool storage (txpool.shards_num=1) with the sharded one
+    for (auto storageShardsNum : std::vector<size_t>{1, shardsNum})
+    {
+        testConcurrentSubmitSealAndRemove(cryptoSuite, count, threadNum,
+            "shards(" + std::to_string(storageShardsNum) + ")",
+            [storageShardsNum](TxPoolConfig::Ptr _config) {
+                return std::make_shared<MemoryStorage>(
+                    _config, 2, 10 * 60 * 1000, false, storageShardsNum);
+            });
+    }
     getchar();
 }
\ No newline at end of file
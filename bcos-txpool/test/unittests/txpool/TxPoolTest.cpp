@@ -19,6 +19,7 @@
  * @date 2021-05-26
  */
 #include "interfaces/crypto/KeyPairInterface.h"
+#include "bcos-txpool/txpool/validator/LedgerNonceChecker.h"
 #include "test/unittests/txpool/TxPoolFixture.h"
 #include <bcos-crypto/hash/Keccak256.h>
 #include <bcos-crypto/hash/SM3.h>
@@ -199,6 +200,9 @@ void testAsyncSealTxs(TxPoolFixture::Ptr _faker, TxPoolInterface::Ptr _txpool,
             BOOST_CHECK(_error == nullptr);
             BOOST_CHECK(_txsMetaDataList->transactionsMetaDataSize() == (originTxsSize - txsLimit));
             BOOST_CHECK(_txpoolStorage->size() == originTxsSize);
+            // only the unsealed txs should be traversed
+            auto memoryStorage = std::dynamic_pointer_cast<MemoryStorage>(_txpoolStorage);
+            BOOST_CHECK(memoryStorage->fetchTraverseCount() == (originTxsSize - txsLimit));
             std::set<HashType> txsSet(sealedTxs->begin(), sealedTxs->end());
             for (size_t i = 0; i < _txsMetaDataList->transactionsMetaDataSize(); i++)
             {
@@ -561,6 +565,29 @@ void txPoolInitAndSubmitTransactionTest(bool _sm, CryptoSuite::Ptr _cryptoSuite)
     {
         std::this_thread::sleep_for(std::chrono::milliseconds(2));
     }
+
+    // case11: batch submit, the malformed and the duplicated txs should be rejected
+    txpoolConfig->setPoolLimit(importedTxNum + 1);
+    auto batchTx = fakeTransaction(_cryptoSuite, utcTime() + 3000000,
+        ledger->blockNumber() + blockLimit - 4, faker->chainId(), faker->groupId());
+    auto batchTxEncodedData = batchTx->encode();
+    auto batchTxData =
+        std::make_shared<bytes>(batchTxEncodedData.begin(), batchTxEncodedData.end());
+    std::vector<uint32_t> rejectedStatus;
+    auto rejectedCallback = [&](Error::Ptr, TransactionSubmitResult::Ptr _result) {
+        rejectedStatus.emplace_back(_result->status());
+    };
+    TxSubmitRequests requests;
+    requests.emplace_back(txData, rejectedCallback);
+    requests.emplace_back(batchTxData, nullptr);
+    requests.emplace_back(batchTxData, rejectedCallback);
+    txpoolStorage->batchSubmitTransaction(requests);
+    importedTxNum++;
+    BOOST_CHECK(txpoolStorage->size() == importedTxNum);
+    BOOST_CHECK(rejectedStatus.size() == 2);
+    BOOST_CHECK(rejectedStatus[0] == (uint32_t)TransactionStatus::Malform);
+    BOOST_CHECK(rejectedStatus[1] == (uint32_t)TransactionStatus::AlreadyInTxPool);
+
     std::cout << "#### testAsyncFillBlock" << std::endl;
     testAsyncFillBlock(faker, txpool, txpoolStorage, _cryptoSuite);
     std::cout << "#### testAsyncSealTxs" << std::endl;
@@ -583,6 +610,109 @@ BOOST_AUTO_TEST_CASE(testSMTxPoolInitAndSubmitTransaction)
     txPoolInitAndSubmitTransactionTest(true, cryptoSuite);
 }
 
+BOOST_AUTO_TEST_CASE(testNonceFilter)
+{
+    // the nonces in the txpool
+    TxPoolNonceChecker txpoolNonceChecker(1000);
+    auto nonceList = std::make_shared<NonceList>();
+    for (size_t i = 0; i < 1000; i++)
+    {
+        nonceList->emplace_back(NonceType(utcTime() + i));
+    }
+    txpoolNonceChecker.batchInsert(0, nonceList);
+    for (auto const& nonce : *nonceList)
+    {
+        BOOST_CHECK(txpoolNonceChecker.exists(nonce));
+    }
+    // most of the new nonces should be filtered without querying the nonceCache
+    size_t newNoncesNum = 1000;
+    for (size_t i = 0; i < newNoncesNum; i++)
+    {
+        BOOST_CHECK(!txpoolNonceChecker.exists(NonceType(utcTime() + 2000 + i)));
+    }
+    BOOST_CHECK(txpoolNonceChecker.filteredChecks() > newNoncesNum * 9 / 10);
+    txpoolNonceChecker.batchRemove(*nonceList);
+    for (auto const& nonce : *nonceList)
+    {
+        BOOST_CHECK(!txpoolNonceChecker.exists(nonce));
+    }
+
+    // the nonces of the expired block should be removed from the ledger nonce checker
+    int64_t blockLimit = 2;
+    LedgerNonceChecker ledgerNonceChecker(nullptr, 0, blockLimit);
+    std::vector<NonceListPtr> blockNonces;
+    for (int64_t blockNumber = 1; blockNumber <= blockLimit + 1; blockNumber++)
+    {
+        auto blockNonceList = std::make_shared<NonceList>();
+        for (size_t i = 0; i < 100; i++)
+        {
+            blockNonceList->emplace_back(NonceType(blockNumber * 1000 + i));
+        }
+        ledgerNonceChecker.batchInsert(blockNumber, blockNonceList);
+        blockNonces.emplace_back(blockNonceList);
+    }
+    for (auto const& nonce : *blockNonces[0])
+    {
+        BOOST_CHECK(!ledgerNonceChecker.exists(nonce));
+    }
+    for (size_t i = 1; i < blockNonces.size(); i++)
+    {
+        for (auto const& nonce : *blockNonces[i])
+        {
+            BOOST_CHECK(ledgerNonceChecker.exists(nonce));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testPrioritySealOrder)
+{
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+    auto keyPair = signatureImpl->generateKeyPair();
+    int64_t blockLimit = 10;
+    auto faker = std::make_shared<TxPoolFixture>(keyPair->publicKey(), cryptoSuite,
+        "group_test_for_txpool", "chain_test_for_txpool", blockLimit,
+        std::make_shared<FakeGateWay>());
+    faker->init();
+    auto txpoolConfig = faker->txpool()->txpoolConfig();
+    txpoolConfig->setTxsSealOrder(TxsSealOrder::Priority);
+    auto memoryStorage = std::make_shared<MemoryStorage>(txpoolConfig);
+
+    // every tx is sent by a different sender, the last 3 senders have higher priority
+    size_t txsNum = 10;
+    size_t priorityTxsNum = 3;
+    Transactions txs;
+    for (size_t i = 0; i < txsNum; i++)
+    {
+        auto tx = fakeTransaction(cryptoSuite, utcTime() + i,
+            faker->ledger()->blockNumber() + blockLimit - 4, faker->chainId(), faker->groupId());
+        if (i >= txsNum - priorityTxsNum)
+        {
+            txpoolConfig->setSenderPriority(std::string(tx->sender()), 10);
+        }
+        BOOST_CHECK(memoryStorage->insert(tx) == TransactionStatus::None);
+        txs.emplace_back(tx);
+    }
+    // the txs of the higher priority senders should be sealed first
+    auto blockFactory = txpoolConfig->blockFactory();
+    auto txsList = blockFactory->createBlock();
+    memoryStorage->batchFetchTxs(txsList, blockFactory->createBlock(), priorityTxsNum, nullptr);
+    BOOST_CHECK(txsList->transactionsMetaDataSize() == priorityTxsNum);
+    for (size_t i = 0; i < txsList->transactionsMetaDataSize(); i++)
+    {
+        BOOST_CHECK(txsList->transactionHash(i) == txs[txsNum - priorityTxsNum + i]->hash());
+    }
+    // the other txs are sealed in the order of importing
+    txsList = blockFactory->createBlock();
+    memoryStorage->batchFetchTxs(txsList, blockFactory->createBlock(), txsNum, nullptr);
+    BOOST_CHECK(txsList->transactionsMetaDataSize() == txsNum - priorityTxsNum);
+    for (size_t i = 0; i < txsList->transactionsMetaDataSize(); i++)
+    {
+        BOOST_CHECK(txsList->transactionHash(i) == txs[i]->hash());
+    }
+}
+
 BOOST_AUTO_TEST_CASE(fillWithSubmit)
 {
     // auto hashImpl = std::make_shared<SM3>();
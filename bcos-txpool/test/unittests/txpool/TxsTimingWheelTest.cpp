@@ -0,0 +1,166 @@
+/**
+ *  Copyright (C) 2021 FISCO BCOS.
+ *  SPDX-License-Identifier: Apache-2.0
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ * @brief unit test for the expiration wheel of the txpool
+ * @file TxsTimingWheelTest.cpp
+ * @date 2022-07-04
+ */
+#include "bcos-txpool/txpool/storage/TxsTimingWheel.h"
+#include "test/unittests/txpool/TxPoolFixture.h"
+#include <bcos-crypto/hash/Keccak256.h>
+#include <bcos-crypto/interfaces/crypto/CryptoSuite.h>
+#include <bcos-crypto/signature/secp256k1/Secp256k1Crypto.h>
+#include <bcos-protocol/testutils/protocol/FakeTransaction.h>
+#include <bcos-utilities/testutils/TestPromptFixture.h>
+#include <boost/test/unit_test.hpp>
+#include <chrono>
+#include <thread>
+using namespace bcos;
+using namespace bcos::txpool;
+using namespace bcos::protocol;
+using namespace bcos::crypto;
+
+namespace bcos
+{
+namespace test
+{
+BOOST_FIXTURE_TEST_SUITE(TxsTimingWheelTest, TestPromptFixture)
+
+Transaction::Ptr fakeTimedTransaction(CryptoSuite::Ptr _cryptoSuite, int64_t _importTime)
+{
+    auto tx = fakeTransaction(_cryptoSuite, utcTime() + _importTime);
+    tx->setImportTime(_importTime);
+    return tx;
+}
+
+BOOST_AUTO_TEST_CASE(popExpired)
+{
+    auto cryptoSuite = std::make_shared<CryptoSuite>(
+        std::make_shared<Keccak256>(), std::make_shared<Secp256k1Crypto>(), nullptr);
+    int64_t expirationTime = 10000;
+    TxsTimingWheel wheel(expirationTime, 1000);
+
+    // the txs expire at 10500, 11500 and 12500
+    std::vector<Transaction::Ptr> txs;
+    for (int64_t importTime = 500; importTime < 3000; importTime += 1000)
+    {
+        auto tx = fakeTimedTransaction(cryptoSuite, importTime);
+        wheel.insert(tx);
+        txs.emplace_back(tx);
+    }
+    // insert the same tx again
+    wheel.insert(txs[0]);
+    BOOST_CHECK_EQUAL(wheel.size(), 3);
+
+    std::vector<HashType> visitedTxs;
+    auto expire = [&visitedTxs](HashType const& _txHash) {
+        visitedTxs.emplace_back(_txHash);
+        return TxsTimingWheel::ExpiredResult::Expired;
+    };
+    // no bucket expires
+    BOOST_CHECK_EQUAL(wheel.popExpired(10999, expire), 0);
+    BOOST_CHECK(visitedTxs.empty());
+    // the bucket of the current time is not popped
+    BOOST_CHECK_EQUAL(wheel.popExpired(11000, expire), 1);
+    BOOST_CHECK_EQUAL(visitedTxs.size(), 1);
+    BOOST_CHECK(visitedTxs[0] == txs[0]->hash());
+    BOOST_CHECK_EQUAL(wheel.size(), 2);
+
+    // the removed tx is not visited
+    wheel.remove(txs[1]->hash());
+    wheel.remove(txs[1]->hash());
+    BOOST_CHECK_EQUAL(wheel.size(), 1);
+    visitedTxs.clear();
+    BOOST_CHECK_EQUAL(wheel.popExpired(13000, expire), 1);
+    BOOST_CHECK_EQUAL(visitedTxs.size(), 1);
+    BOOST_CHECK(visitedTxs[0] == txs[2]->hash());
+    BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(delayAndDrop)
+{
+    auto cryptoSuite = std::make_shared<CryptoSuite>(
+        std::make_shared<Keccak256>(), std::make_shared<Secp256k1Crypto>(), nullptr);
+    TxsTimingWheel wheel(10000, 1000);
+    auto sealedTx = fakeTimedTransaction(cryptoSuite, 0);
+    auto removedTx = fakeTimedTransaction(cryptoSuite, 0);
+    wheel.insert(sealedTx);
+    wheel.insert(removedTx);
+
+    // the sealed tx is delayed, and the removed tx is dropped without counting
+    auto delay = [&](HashType const& _txHash) {
+        if (_txHash == sealedTx->hash())
+        {
+            return TxsTimingWheel::ExpiredResult::Delayed;
+        }
+        return TxsTimingWheel::ExpiredResult::Dropped;
+    };
+    BOOST_CHECK_EQUAL(wheel.popExpired(12000, delay), 0);
+    BOOST_CHECK_EQUAL(wheel.size(), 1);
+
+    // the delayed tx is checked again after the current bucket
+    size_t visitedTxs = 0;
+    auto expire = [&visitedTxs](HashType const&) {
+        visitedTxs++;
+        return TxsTimingWheel::ExpiredResult::Expired;
+    };
+    BOOST_CHECK_EQUAL(wheel.popExpired(12999, expire), 0);
+    BOOST_CHECK_EQUAL(visitedTxs, 0);
+    BOOST_CHECK_EQUAL(wheel.popExpired(13000, expire), 1);
+    BOOST_CHECK_EQUAL(visitedTxs, 1);
+    BOOST_CHECK_EQUAL(wheel.size(), 0);
+
+    wheel.insert(sealedTx);
+    wheel.clear();
+    BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(fetchExpiredTxs)
+{
+    auto hashImpl = std::make_shared<Keccak256>();
+    auto signatureImpl = std::make_shared<Secp256k1Crypto>();
+    auto cryptoSuite = std::make_shared<CryptoSuite>(hashImpl, signatureImpl, nullptr);
+    auto keyPair = signatureImpl->generateKeyPair();
+    int64_t blockLimit = 10;
+    auto faker = std::make_shared<TxPoolFixture>(keyPair->publicKey(), cryptoSuite,
+        "group_test_for_txpool", "chain_test_for_txpool", blockLimit,
+        std::make_shared<FakeGateWay>());
+    faker->init();
+    auto txpoolConfig = faker->txpool()->txpoolConfig();
+    int64_t expirationTime = 10000;
+    auto memoryStorage = std::make_shared<MemoryStorage>(txpoolConfig, 2, expirationTime);
+
+    // the expired tx in the current bucket of the wheel should not be sealed
+    auto expiredTx = fakeTransaction(cryptoSuite, utcTime(),
+        faker->ledger()->blockNumber() + blockLimit - 4, faker->chainId(), faker->groupId());
+    auto tx = fakeTransaction(cryptoSuite, utcTime() + 1,
+        faker->ledger()->blockNumber() + blockLimit - 4, faker->chainId(), faker->groupId());
+    BOOST_CHECK(memoryStorage->insert(tx) == TransactionStatus::None);
+    auto deadline = (utcTime() / 1000) * 1000;
+    expiredTx->setImportTime(deadline - expirationTime);
+    BOOST_CHECK(memoryStorage->insert(expiredTx) == TransactionStatus::None);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+    auto blockFactory = txpoolConfig->blockFactory();
+    auto txsList = blockFactory->createBlock();
+    memoryStorage->batchFetchTxs(txsList, blockFactory->createBlock(), 10, nullptr);
+    BOOST_CHECK_EQUAL(txsList->transactionsMetaDataSize(), 1);
+    BOOST_CHECK(txsList->transactionHash(0) == tx->hash());
+    BOOST_CHECK_EQUAL(memoryStorage->expiredTxsCount(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+}  // namespace test
+}  // namespace bcos
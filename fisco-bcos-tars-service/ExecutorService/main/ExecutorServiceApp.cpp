@@ -129,6 +129,7 @@ void ExecutorServiceApp::createAndInitExecutor()
     auto executorFactory = std::make_shared<bcos::executor::TransactionExecutorFactory>(ledger, m_txpool, cache, storage,
         executionMessageFactory, m_protocolInitializer->cryptoSuite()->hashImpl(),
         m_nodeConfig->isWasm(), m_nodeConfig->isAuthCheck(), m_nodeConfig->keyPageSize(), "executor");
+    executorFactory->setOptimisticExecution(m_nodeConfig->optimisticExecution());
 
     m_executor = std::make_shared<bcos::initializer::ParallelExecutor>(executorFactory);
 
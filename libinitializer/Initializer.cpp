@@ -134,11 +134,21 @@ void Initializer::init(bcos::protocol::NodeArchitectureType _nodeArchType,
     if (boost::iequals(m_nodeConfig->storageType(), "RocksDB"))
     {
         // m_protocolInitializer->dataEncryption() will return nullptr when storage_security = false
-        storage = StorageInitializer::build(
-            storagePath, m_protocolInitializer->dataEncryption(), m_nodeConfig->keyPageSize());
+        bcos::storage::RocksDBOption option;
+        option.prefixBloom = m_nodeConfig->enableRocksDBPrefixBloom();
+        option.bloomBitsPerKey = m_nodeConfig->rocksDBBloomBitsPerKey();
+        option.blockCacheSize = m_nodeConfig->rocksDBBlockCacheSize();
+        option.pinL0FilterAndIndex = m_nodeConfig->pinRocksDBL0FilterAndIndex();
+        option.compressValue = m_nodeConfig->enableValueCompression();
+        option.compressThreshold = m_nodeConfig->valueCompressionThreshold();
+        option.compressLevel = m_nodeConfig->valueCompressionLevel();
+        storage = StorageInitializer::build(storagePath, m_protocolInitializer->dataEncryption(),
+            m_nodeConfig->keyPageSize(), option);
         schedulerStorage = storage;
+        // the consensus storage is small
+        option.blockCacheSize = std::min(option.blockCacheSize, (size_t)32 * 1024 * 1024);
         consensusStorage = StorageInitializer::build(
-            consensusStoragePath, m_protocolInitializer->dataEncryption());
+            consensusStoragePath, m_protocolInitializer->dataEncryption(), 0, option);
     }
     else if (boost::iequals(m_nodeConfig->storageType(), "TiKV"))
     {
@@ -225,6 +235,7 @@ void Initializer::init(bcos::protocol::NodeArchitectureType _nodeArchType,
             m_ledger, m_txpoolInitializer->txpool(), cache, storage, executionMessageFactory,
             m_protocolInitializer->cryptoSuite()->hashImpl(), m_nodeConfig->isWasm(),
             m_nodeConfig->isAuthCheck(), m_nodeConfig->keyPageSize(), executorName);
+        executorFactory->setOptimisticExecution(m_nodeConfig->optimisticExecution());
         auto parallelExecutor =
             std::make_shared<bcos::initializer::ParallelExecutor>(executorFactory);
         executorManager->addExecutor(executorName, parallelExecutor);
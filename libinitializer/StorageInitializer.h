@@ -26,6 +26,7 @@
 #include "boost/filesystem.hpp"
 #include <bcos-framework/interfaces/security/DataEncryptInterface.h>
 #include <bcos-framework/interfaces/storage/StorageInterface.h>
+#include <bcos-storage/src/RocksDBOptions.h>
 #include <bcos-storage/src/RocksDBStorage.h>
 #include <bcos-storage/src/TiKVStorage.h>
 #include <rocksdb/write_batch.h>
@@ -36,7 +37,8 @@ class StorageInitializer
 {
 public:
     static bcos::storage::TransactionalStorageInterface::Ptr build(
-        const std::string& _storagePath, const bcos::security::DataEncryptInterface::Ptr _dataEncrypt, size_t keyPageSize = 0)
+        const std::string& _storagePath, const bcos::security::DataEncryptInterface::Ptr _dataEncrypt, size_t keyPageSize = 0,
+        bcos::storage::RocksDBOption _option = bcos::storage::RocksDBOption())
     {
         // FIXME: use blobDB of RocksDB
         boost::filesystem::create_directories(_storagePath);
@@ -48,15 +50,29 @@ public:
         // options.OptimizeLevelStyleCompaction();
         // create the DB if it's not already present
         options.create_if_missing = true;
-        options.enable_blob_files = keyPageSize > 1 ? true : false;
-        // options.min_blob_size = 1024;
-
+        options.create_missing_column_families = true;
+        _option.enableBlobFiles = keyPageSize > 1 ? true : false;
+        auto columnFamilies = bcos::storage::createColumnFamilyDescriptors(options, _option);
+        std::vector<rocksdb::ColumnFamilyHandle*> handles;
 
         // open DB
-        rocksdb::Status s = rocksdb::DB::Open(options, _storagePath, &db);
+        rocksdb::Status s = rocksdb::DB::Open(options, _storagePath, columnFamilies, &handles, &db);
+        if (!s.ok())
+        {
+            throw std::runtime_error("open rocksdb failed: " + s.ToString());
+        }
 
-        return std::make_shared<bcos::storage::RocksDBStorage>(
-            std::unique_ptr<rocksdb::DB>(db), _dataEncrypt);
+        bcos::storage::ValueCompressor::Ptr valueCompressor = nullptr;
+        if (_option.compressValue)
+        {
+            valueCompressor = std::make_shared<bcos::storage::ValueCompressor>(
+                _option.compressThreshold, _option.compressLevel);
+        }
+        auto storage = std::make_shared<bcos::storage::RocksDBStorage>(
+            std::unique_ptr<rocksdb::DB>(db), _dataEncrypt, std::move(handles), valueCompressor);
+        // the node created before the column families are divided stores all data in default
+        storage->migrateColumnFamilies();
+        return storage;
     }
 
     static bcos::storage::TransactionalStorageInterface::Ptr build(
@@ -44,9 +44,19 @@ TxPoolInitializer::TxPoolInitializer(bcos::tool::NodeConfig::Ptr _nodeConfig,
         m_nodeConfig->blockLimit());
     // init the txpool
     m_txpool = txpoolFactory->createTxPool(m_nodeConfig->notifyWorkerNum(),
-        m_nodeConfig->verifierWorkerNum(), m_nodeConfig->txsExpirationTime(), _preStoreTxs);
+        m_nodeConfig->verifierWorkerNum(), m_nodeConfig->txsExpirationTime(), _preStoreTxs,
+        m_nodeConfig->txpoolShardsNum());
     auto txpoolConfig = m_txpool->txpoolConfig();
     txpoolConfig->setPoolLimit(m_nodeConfig->txpoolLimit());
+    if (m_nodeConfig->txsPrioritySealOrder())
+    {
+        txpoolConfig->setTxsSealOrder(bcos::txpool::TxsSealOrder::Priority);
+    }
+    for (auto const& it : m_nodeConfig->txsSenderPriority())
+    {
+        auto sender = fromHex(it.first);
+        txpoolConfig->setSenderPriority(std::string(sender.begin(), sender.end()), it.second);
+    }
 }
 
 void TxPoolInitializer::init(bcos::sealer::SealerInterface::Ptr _sealer)
@@ -1,10 +1,12 @@
 #include "bcos-crypto/hash/Keccak256.h"
 #include "bcos-framework/interfaces/storage/StorageInterface.h"
+#include "bcos-storage/src/RocksDBOptions.h"
 #include "bcos-storage/src/RocksDBStorage.h"
 #include "bcos-table/src/KeyPageStorage.h"
 #include "bcos-table/src/StateStorage.h"
 #include "bcos-table/src/StateStorageInterface.h"
 #include <boost/filesystem.hpp>
+#include <boost/format.hpp>
 #include <boost/log/core.hpp>
 #include <boost/log/expressions.hpp>
 #include <boost/log/trivial.hpp>
@@ -12,13 +14,126 @@
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <numeric>
 #include <ostream>
+#include <random>
+#include <thread>
 
 using namespace std;
 using namespace bcos;
 using namespace bcos::crypto;
 using namespace bcos::storage;
 
+// the latency of the point lookups and prefix scans of RocksDBStorage with the read option
+int readLatency(const std::string& dbPath, const RocksDBOption& option, int rows, int valueSize,
+    int reads)
+{
+    boost::filesystem::remove_all(dbPath);
+    boost::filesystem::create_directories(dbPath);
+    rocksdb::Options options;
+    options.create_if_missing = true;
+    options.create_missing_column_families = true;
+    auto columnFamilies = createColumnFamilyDescriptors(options, option);
+    std::vector<rocksdb::ColumnFamilyHandle*> handles;
+    rocksdb::DB* db;
+    auto s = rocksdb::DB::Open(options, dbPath, columnFamilies, &handles, &db);
+    if (!s.ok())
+    {
+        std::cout << "open db failed, " << s.ToString() << std::endl;
+        return -1;
+    }
+    auto rocksDBStorage = std::make_shared<bcos::storage::RocksDBStorage>(
+        std::unique_ptr<rocksdb::DB>(db), nullptr, handles);
+
+    // a large table and some small tables
+    auto keyOf = [](int i) { return (boost::format("%016x") % (i * 2654435761ULL)).str(); };
+    std::string largeTable = "/apps/large";
+    std::mt19937 random(0);
+    std::string value(valueSize, '0');
+    auto writeStart = std::chrono::system_clock::now();
+    const int batchSize = 100000;
+    for (int i = 0; i < rows; i += batchSize)
+    {
+        std::vector<std::string> keys;
+        std::vector<std::string> values;
+        for (int j = i; j < std::min(i + batchSize, rows); ++j)
+        {
+            keys.emplace_back(keyOf(j));
+            for (auto& c : value)
+            {
+                c = 'a' + random() % 26;
+            }
+            values.emplace_back(value);
+        }
+        rocksDBStorage->setRows(largeTable, std::move(keys), std::move(values));
+    }
+    const int smallTables = 100;
+    for (int t = 0; t < smallTables; ++t)
+    {
+        std::vector<std::string> keys;
+        std::vector<std::string> values;
+        for (int j = 0; j < 100; ++j)
+        {
+            keys.emplace_back(keyOf(j));
+            values.emplace_back(value);
+        }
+        rocksDBStorage->setRows(
+            "/apps/small_" + std::to_string(t), std::move(keys), std::move(values));
+    }
+    db->Flush(rocksdb::FlushOptions(), handles);
+    db->CompactRange(rocksdb::CompactRangeOptions(), handles[2], nullptr, nullptr);
+    auto writeEnd = std::chrono::system_clock::now();
+
+    auto measure = [&](const std::string& name, int count, auto&& read) {
+        std::vector<int64_t> latencies(count);
+        for (int i = 0; i < count; ++i)
+        {
+            auto start = std::chrono::steady_clock::now();
+            read(i);
+            latencies[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start)
+                               .count();
+        }
+        std::sort(latencies.begin(), latencies.end());
+        auto total = std::accumulate(latencies.begin(), latencies.end(), (int64_t)0);
+        std::cout << name << ": avg=" << total / count / 1000.0
+                  << "us|p50=" << latencies[count / 2] / 1000.0
+                  << "us|p99=" << latencies[count * 99 / 100] / 1000.0 << "us" << std::endl;
+    };
+    std::uniform_int_distribution<int> index(0, rows - 1);
+    bool failed = false;
+    measure("point get hit   ", reads, [&](int) {
+        rocksDBStorage->asyncGetRow(largeTable, keyOf(index(random)),
+            [&](Error::UniquePtr error, std::optional<Entry> entry) {
+                failed = failed || error || !entry;
+            });
+    });
+    measure("point get miss  ", reads, [&](int i) {
+        rocksDBStorage->asyncGetRow(largeTable, keyOf(rows + i),
+            [&](Error::UniquePtr error, std::optional<Entry> entry) {
+                failed = failed || error || entry;
+            });
+    });
+    measure("prefix scan     ", std::max(reads / 100, 1), [&](int i) {
+        rocksDBStorage->asyncGetPrimaryKeys("/apps/small_" + std::to_string(i % smallTables), {},
+            [&](Error::UniquePtr error, std::vector<std::string> keys) {
+                failed = failed || error || keys.size() != 100;
+            });
+    });
+    std::cout << "load " << rows << " rows: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(writeEnd - writeStart)
+                     .count()
+              << "ms" << std::endl;
+    rocksDBStorage.reset();
+    boost::filesystem::remove_all(dbPath);
+    if (failed)
+    {
+        std::cout << "read failed" << std::endl;
+        return -1;
+    }
+    return 0;
+}
+
 int main(int argc, const char* argv[])
 {
     boost::program_options::options_description main_options("Usage of Table benchmark");
@@ -30,7 +145,16 @@ int main(int argc, const char* argv[])
         "data set size")("onlyWrite,o", boost::program_options::value<bool>()->default_value(false),
         "only test write performance")("sorted,s",
         boost::program_options::value<bool>()->default_value(false), "use sorted data set")(
-        "db,d", boost::program_options::value<int>()->default_value(0), "init db keys count");
+        "db,d", boost::program_options::value<int>()->default_value(0), "init db keys count")(
+        "threads,n",
+        boost::program_options::value<int>()->default_value(std::thread::hardware_concurrency()),
+        "threads of the concurrent read write test")("readRatio,r",
+        boost::program_options::value<int>()->default_value(90),
+        "percent of the reads in the concurrent read write test")("readLatency,l",
+        boost::program_options::value<int>()->default_value(0),
+        "rows of the rocksdb read latency test, the test is skipped if 0")("valueSize,v",
+        boost::program_options::value<int>()->default_value(256),
+        "value size of the rocksdb read latency test");
     boost::program_options::variables_map vm;
     try
     {
@@ -54,11 +178,33 @@ int main(int argc, const char* argv[])
     bool onlyWrite = vm["onlyWrite"].as<bool>();
     bool sorted = vm["sorted"].as<bool>();
     int dbKeys = vm["db"].as<int>();
+    int threads = std::max(vm["threads"].as<int>(), 1);
+    int readRatio = std::clamp(vm["readRatio"].as<int>(), 0, 100);
 
     storageChainLength = storageChainLength > 0 ? storageChainLength : 1;
     // set log level
     boost::log::core::get()->set_filter(
         boost::log::trivial::severity >= boost::log::trivial::error);
+    int readLatencyRows = vm["readLatency"].as<int>();
+    if (readLatencyRows > 0)
+    {  // compare the default rocksdb options with the read tuning profile
+        auto valueSize = std::max(vm["valueSize"].as<int>(), 1);
+        auto reads = std::max(total, 100);
+        RocksDBOption defaultOption;
+        defaultOption.prefixBloom = false;
+        defaultOption.bloomBitsPerKey = 0;
+        defaultOption.blockCacheSize = 8 * 1024 * 1024;
+        defaultOption.pinL0FilterAndIndex = false;
+        std::cout << "rows=" << readLatencyRows << "|value size=" << valueSize
+                  << "|reads=" << reads << std::endl
+                  << "default options:" << std::endl;
+        if (readLatency("./testdata/readdb", defaultOption, readLatencyRows, valueSize, reads) != 0)
+        {
+            return -1;
+        }
+        std::cout << "read tuning profile:" << std::endl;
+        return readLatency("./testdata/readdb", RocksDBOption(), readLatencyRows, valueSize, reads);
+    }
 
 
     // prepare data set
@@ -345,4 +491,73 @@ int main(int argc, const char* argv[])
                      readWriteReadEnd - readWriteEnd)
                      .count()
               << "ms" << std::endl;
+    if (onlyWrite)
+    {
+        return 0;
+    }
+    // concurrent random read and write on the cache storage
+    table = Table(nullptr, nullptr);
+    storages.clear();
+    storage.reset();
+    auto cacheStorage = std::make_shared<LRUStateStorage>(rocksDBStorage);
+    table = cacheStorage->createTable("testConcurrentTable", "value");
+    if (!table)
+    {
+        std::cout << "create table failed" << std::endl;
+        return -1;
+    }
+    for (int i = 0; i < total; ++i)
+    {
+        auto entry = table->newEntry();
+        entry.set(valueSet[i]);
+        table->setRow(keySet[i], entry);
+    }
+    std::atomic<int64_t> reads = 0;
+    std::atomic<int64_t> writes = 0;
+    std::atomic<bool> failed = false;
+    auto opsPerThread = total / threads;
+    auto concurrentStart = std::chrono::system_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t]() {
+            std::mt19937 random(t);
+            std::uniform_int_distribution<int> keyIndex(0, total - 1);
+            std::uniform_int_distribution<int> percent(0, 99);
+            auto threadTable = *table;
+            for (int i = 0; i < opsPerThread && !failed; ++i)
+            {
+                auto index = keyIndex(random);
+                if (percent(random) < readRatio)
+                {
+                    if (!threadTable.getRow(keySet[index]))
+                    {
+                        failed = true;
+                    }
+                    ++reads;
+                    continue;
+                }
+                auto entry = threadTable.newEntry();
+                entry.set(valueSet[index]);
+                threadTable.setRow(keySet[index], std::move(entry));
+                ++writes;
+            }
+        });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    if (failed)
+    {
+        std::cout << "get row failed at concurrent read write" << std::endl;
+        return -1;
+    }
+    auto concurrentEnd = std::chrono::system_clock::now();
+    int64_t concurrentElapsed =
+        std::chrono::duration_cast<std::chrono::milliseconds>(concurrentEnd - concurrentStart)
+            .count();
+    std::cout << "concurrent rw   : " << concurrentElapsed << "ms|threads=" << threads
+              << "|reads=" << reads << "|writes=" << writes << "|ops/s="
+              << (reads + writes) * 1000 / std::max(concurrentElapsed, (int64_t)1) << std::endl;
 }
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include <bcos-crypto/encrypt/AESCrypto.h>
+#include <bcos-crypto/encrypt/SM4Crypto.h>
+#include <bcos-security/bcos-security/DataEncryption.h>
+#include <boost/program_options.hpp>
+#include <chrono>
+
+using namespace std;
+using namespace bcos;
+using namespace bcos::crypto;
+
+// the data encryption with a fixed data key instead of the one of the key center
+class BenchDataEncryption : public bcos::security::DataEncryption
+{
+public:
+    explicit BenchDataEncryption(bool _smCrypto) : DataEncryption(nullptr)
+    {
+        m_dataKey = std::string(32, 'k');
+        if (_smCrypto)
+        {
+            m_symmetricEncrypt = std::make_shared<SM4Crypto>();
+        }
+        else
+        {
+            m_symmetricEncrypt = std::make_shared<AESCrypto>();
+        }
+    }
+};
+
+int64_t elapsed(std::chrono::system_clock::time_point _start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now() - _start)
+        .count();
+}
+
+// the values encrypted and decrypted one by one and in batches, like the rows of a block
+void benchmark(bool _smCrypto, size_t _valuesSize, size_t _valueLength)
+{
+    BenchDataEncryption dataEncryption(_smCrypto);
+    std::vector<std::string> values(_valuesSize);
+    for (size_t i = 0; i < _valuesSize; ++i)
+    {
+        values[i] = std::to_string(i);
+        values[i].resize(_valueLength, 'v');
+    }
+
+    auto start = std::chrono::system_clock::now();
+    std::vector<std::string> encrypted(_valuesSize);
+    for (size_t i = 0; i < _valuesSize; ++i)
+    {
+        encrypted[i] = dataEncryption.encrypt(values[i]);
+    }
+    auto encrypt = elapsed(start);
+    start = std::chrono::system_clock::now();
+    std::vector<std::string> decrypted(_valuesSize);
+    for (size_t i = 0; i < _valuesSize; ++i)
+    {
+        decrypted[i] = dataEncryption.decrypt(encrypted[i]);
+    }
+    auto decrypt = elapsed(start);
+
+    auto batch = values;
+    start = std::chrono::system_clock::now();
+    dataEncryption.encryptBatch(batch);
+    auto encryptBatch = elapsed(start);
+    start = std::chrono::system_clock::now();
+    dataEncryption.decryptBatch(batch);
+    auto decryptBatch = elapsed(start);
+
+    bool same = (decrypted == values) && (batch == values);
+    std::cout << (_smCrypto ? "sm4" : "aes") << "|values=" << _valuesSize
+              << "|length=" << _valueLength << "|same=" << (same ? "true" : "false")
+              << std::endl
+              << "one by one : encrypt=" << encrypt / 1000.0 << "ms|decrypt=" << decrypt / 1000.0
+              << "ms" << std::endl
+              << "batch      : encrypt=" << encryptBatch / 1000.0
+              << "ms|decrypt=" << decryptBatch / 1000.0 << "ms" << std::endl;
+}
+
+int main(int argc, const char* argv[])
+{
+    boost::program_options::options_description main_options("Usage of encryption benchmark");
+    main_options.add_options()("help,h", "print help information")("values,v",
+        boost::program_options::value<std::vector<size_t>>()->multitoken()->default_value(
+            {10000, 100000}, "10000 100000"),
+        "values of every batch")("length,l",
+        boost::program_options::value<size_t>()->default_value(256), "length of every value")(
+        "sm,s", "use the sm4 encryption instead of the aes one");
+    boost::program_options::variables_map vm;
+    try
+    {
+        boost::program_options::store(
+            boost::program_options::parse_command_line(argc, argv, main_options), vm);
+    }
+    catch (...)
+    {
+        std::cout << "invalid parameters" << std::endl;
+        std::cout << main_options << std::endl;
+        exit(0);
+    }
+    if (vm.count("help"))
+    {
+        std::cout << main_options << std::endl;
+        exit(0);
+    }
+    auto length = std::max(vm["length"].as<size_t>(), (size_t)1);
+    for (auto valuesSize : vm["values"].as<std::vector<size_t>>())
+    {
+        if (valuesSize > 0)
+        {
+            benchmark(vm.count("sm") > 0, valuesSize, length);
+        }
+    }
+    return 0;
+}
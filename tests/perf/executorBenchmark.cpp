@@ -0,0 +1,395 @@
+#include "bcos-crypto/hash/Keccak256.h"
+#include "bcos-crypto/interfaces/crypto/CryptoSuite.h"
+#include "bcos-crypto/signature/secp256k1/Secp256k1Crypto.h"
+#include "bcos-executor/src/executor/TransactionExecutorFactory.h"
+#include "bcos-executor/src/vm/CodeCache.h"
+#include "bcos-framework/interfaces/executor/NativeExecutionMessage.h"
+#include "bcos-framework/interfaces/ledger/LedgerTypeDef.h"
+#include "bcos-ledger/src/libledger/Ledger.h"
+#include "bcos-protocol/protobuf/PBBlockFactory.h"
+#include "bcos-protocol/protobuf/PBBlockHeaderFactory.h"
+#include "bcos-protocol/protobuf/PBTransactionFactory.h"
+#include "bcos-protocol/protobuf/PBTransactionReceiptFactory.h"
+#include "bcos-storage/src/RocksDBStorage.h"
+#include "bcos-utilities/DataConvertUtility.h"
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <future>
+#include <optional>
+#include <random>
+#include <tuple>
+
+using namespace std;
+using namespace bcos;
+using namespace bcos::crypto;
+using namespace bcos::executor;
+using namespace bcos::protocol;
+using namespace bcos::ledger;
+using namespace bcos::storage;
+
+int64_t elapsed(std::chrono::system_clock::time_point _start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now() - _start)
+        .count();
+}
+
+BlockFactory::Ptr createBlockFactory()
+{
+    auto cryptoSuite = std::make_shared<CryptoSuite>(
+        std::make_shared<Keccak256>(), std::make_shared<Secp256k1Crypto>(), nullptr);
+    return std::make_shared<PBBlockFactory>(std::make_shared<PBBlockHeaderFactory>(cryptoSuite),
+        std::make_shared<PBTransactionFactory>(cryptoSuite),
+        std::make_shared<PBTransactionReceiptFactory>(cryptoSuite));
+}
+
+bool buildGenesis(BlockFactory::Ptr _blockFactory, std::shared_ptr<Ledger> _ledger)
+{
+    auto config = std::make_shared<LedgerConfig>();
+    config->setBlockNumber(0);
+    config->setBlockTxCountLimit(1000);
+    auto signImpl = _blockFactory->cryptoSuite()->signatureImpl();
+    consensus::ConsensusNodeList consensusNodeList;
+    consensusNodeList.emplace_back(
+        std::make_shared<consensus::ConsensusNode>(signImpl->generateKeyPair()->publicKey(), 1));
+    config->setConsensusNodeList(consensusNodeList);
+    return _ledger->buildGenesisBlock(config, 3000000000, "", RC4_VERSION_STR);
+}
+
+// the deploy code of a token whose every call is transfer(address to, uint256 amount):
+// balances[caller] -= amount; balances[to] += amount; the dead code after STOP stands for the
+// other functions of a real token contract and makes the code as large as required
+bytes tokenCode(size_t _codeSize)
+{
+    bytes runtime = {0x33, 0x54, 0x60, 0x24, 0x35, 0x90, 0x03, 0x33, 0x55, 0x60, 0x04, 0x35, 0x54,
+        0x60, 0x24, 0x35, 0x01, 0x60, 0x04, 0x35, 0x55, 0x00};
+    // JUMPDEST makes the jumpdest analysis scan the whole code
+    runtime.resize(std::max(_codeSize, runtime.size()), 0x5b);
+    // PUSH2 size DUP1 PUSH1 12 PUSH1 0 CODECOPY PUSH1 0 RETURN
+    bytes code = {0x61, (byte)(runtime.size() >> 8), (byte)(runtime.size() & 0xff), 0x80, 0x60,
+        0x0c, 0x60, 0x00, 0x39, 0x60, 0x00, 0xf3};
+    code.insert(code.end(), runtime.begin(), runtime.end());
+    return code;
+}
+
+ExecutionMessage::UniquePtr execute(
+    TransactionExecutor::Ptr _executor, ExecutionMessage::UniquePtr _message)
+{
+    std::promise<ExecutionMessage::UniquePtr> promise;
+    _executor->executeTransaction(std::move(_message),
+        [&promise](Error::UniquePtr&& _error, ExecutionMessage::UniquePtr&& _result) {
+            if (_error)
+            {
+                std::cout << "execute failed, " << _error->errorMessage() << std::endl;
+            }
+            promise.set_value(std::move(_result));
+        });
+    return promise.get_future().get();
+}
+
+ExecutionMessage::UniquePtr createMessage(int64_t _contextID, std::string const& _from,
+    std::string const& _to, bytes _data, bool _create)
+{
+    auto message = std::make_unique<NativeExecutionMessage>();
+    message->setType(ExecutionMessage::MESSAGE);
+    message->setContextID(_contextID);
+    message->setSeq(0);
+    message->setDepth(0);
+    message->setOrigin(_from);
+    message->setFrom(_from);
+    message->setTo(_to);
+    message->setStaticCall(false);
+    message->setGasAvailable(300000000);
+    message->setData(std::move(_data));
+    message->setCreate(_create);
+    return message;
+}
+
+std::string account(size_t _index)
+{
+    auto account = std::to_string(_index + 1);
+    return std::string(40 - account.size(), '0') + account;
+}
+
+struct Result
+{
+    int64_t time = 0;
+    size_t failed = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+};
+
+// the transfers between the random accounts, every call is a new context of the block
+Result transfers(TransactionExecutor::Ptr _executor, std::string const& _token,
+    std::vector<std::string> const& _accounts, size_t _calls, int64_t& _contextID)
+{
+    Result result;
+    auto& codeCache = CodeCache::instance();
+    auto hits = codeCache.hits();
+    auto misses = codeCache.misses();
+    std::mt19937 random(0);
+    auto start = std::chrono::system_clock::now();
+    for (size_t i = 0; i < _calls; ++i)
+    {
+        auto const& from = _accounts[random() % _accounts.size()];
+        auto const& to = _accounts[random() % _accounts.size()];
+        // transfer(address,uint256)
+        bytes data = {0xa9, 0x05, 0x9c, 0xbb};
+        data.resize(4 + 64, 0);
+        auto toBytes = fromHex(to);
+        std::copy(toBytes.begin(), toBytes.end(), data.begin() + 4 + 32 - toBytes.size());
+        data.back() = 1;
+        auto output =
+            execute(_executor, createMessage(_contextID++, from, _token, std::move(data), false));
+        if (!output || output->status() != 0)
+        {
+            ++result.failed;
+        }
+    }
+    result.time = elapsed(start);
+    result.hits = codeCache.hits() - hits;
+    result.misses = codeCache.misses() - misses;
+    return result;
+}
+
+void print(const std::string& _name, size_t _calls, Result const& _result)
+{
+    std::cout << _name << ": " << _result.time / 1000.0 << "ms|"
+              << _calls * 1000000.0 / std::max(_result.time, (int64_t)1)
+              << " calls/s|failed=" << _result.failed << "|codeCacheHits=" << _result.hits
+              << "|codeCacheMisses=" << _result.misses << std::endl;
+}
+
+struct Chain
+{
+    std::shared_ptr<RocksDBStorage> storage;
+    std::shared_ptr<Ledger> ledger;
+    TransactionExecutor::Ptr executor;
+    std::string token;
+    int64_t contextID = 0;
+};
+
+// open an empty RocksDB, build the genesis and deploy the token at block 1
+std::optional<Chain> createChain(
+    const std::string& _dbPath, size_t _codeSize, size_t _keyPageSize = 0)
+{
+    boost::filesystem::remove_all(_dbPath);
+    boost::filesystem::create_directories(_dbPath);
+    rocksdb::Options options;
+    options.create_if_missing = true;
+    rocksdb::DB* db;
+    auto s = rocksdb::DB::Open(options, _dbPath, &db);
+    if (!s.ok())
+    {
+        std::cout << "open db failed, " << s.ToString() << std::endl;
+        return std::nullopt;
+    }
+    Chain chain;
+    chain.storage = std::make_shared<RocksDBStorage>(std::unique_ptr<rocksdb::DB>(db), nullptr);
+    auto blockFactory = createBlockFactory();
+    chain.ledger = std::make_shared<Ledger>(blockFactory, chain.storage);
+    if (!buildGenesis(blockFactory, chain.ledger))
+    {
+        std::cout << "build genesis failed" << std::endl;
+        return std::nullopt;
+    }
+
+    chain.executor = TransactionExecutorFactory::build(chain.ledger, nullptr, nullptr,
+        chain.storage, std::make_shared<NativeExecutionMessageFactory>(),
+        blockFactory->cryptoSuite()->hashImpl(), false, false, _keyPageSize);
+    auto blockHeader = blockFactory->blockHeaderFactory()->createBlockHeader();
+    blockHeader->setNumber(1);
+    std::promise<Error::UniquePtr> nextPromise;
+    chain.executor->nextBlockHeader(0, blockHeader,
+        [&nextPromise](Error::UniquePtr _error) { nextPromise.set_value(std::move(_error)); });
+    if (auto error = nextPromise.get_future().get())
+    {
+        std::cout << "next block header failed, " << error->errorMessage() << std::endl;
+        return std::nullopt;
+    }
+
+    auto tokenAddress = std::string("ff6f30856ad3bae00b1169808488502786a13e3c");
+    auto deployed = execute(chain.executor,
+        createMessage(chain.contextID++, account(0), tokenAddress, tokenCode(_codeSize), true));
+    if (!deployed || deployed->status() != 0)
+    {
+        std::cout << "deploy the token failed" << std::endl;
+        return std::nullopt;
+    }
+    chain.token = std::string(deployed->newEVMContractAddress());
+    return chain;
+}
+
+// execute block 2 on the uncommitted state of block 1, like the pipelined scheduler
+bool nextBlock(Chain& _chain)
+{
+    auto blockHeader = createBlockFactory()->blockHeaderFactory()->createBlockHeader();
+    blockHeader->setNumber(2);
+    std::promise<Error::UniquePtr> nextPromise;
+    _chain.executor->nextBlockHeader(0, blockHeader,
+        [&nextPromise](Error::UniquePtr _error) { nextPromise.set_value(std::move(_error)); });
+    if (auto error = nextPromise.get_future().get())
+    {
+        std::cout << "next block header failed, " << error->errorMessage() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void releaseChain(Chain& _chain, const std::string& _dbPath)
+{
+    _chain.executor.reset();
+    _chain.ledger.reset();
+    _chain.storage.reset();
+    boost::filesystem::remove_all(_dbPath);
+}
+
+void codeCacheBenchmark(
+    const std::string& _dbPath, size_t _calls, size_t _accounts, size_t _codeSize)
+{
+    auto chain = createChain(_dbPath, _codeSize);
+    if (!chain)
+    {
+        return;
+    }
+    std::vector<std::string> accounts;
+    for (size_t i = 0; i < _accounts; ++i)
+    {
+        accounts.emplace_back(account(i));
+    }
+
+    // the code is read from the storage by every call without the code cache
+    auto& codeCache = CodeCache::instance();
+    codeCache.setCapacity(0);
+    auto uncached = transfers(chain->executor, chain->token, accounts, _calls, chain->contextID);
+    codeCache.setCapacity(64 * 1024 * 1024);
+    auto cached = transfers(chain->executor, chain->token, accounts, _calls, chain->contextID);
+
+    std::cout << "calls=" << _calls << "|accounts=" << _accounts << "|codeSize=" << _codeSize
+              << std::endl;
+    print("no code cache", _calls, uncached);
+    print("code cache   ", _calls, cached);
+    releaseChain(*chain, _dbPath);
+}
+
+// the transfers of a block sent to the executor in one DMC batch, the contended ones are all paid
+// by the same account, the uncontended ones touch disjoint accounts
+std::tuple<Result, crypto::HashType> dmcTransfers(const std::string& _dbPath, size_t _calls,
+    size_t _keyPageSize, bool _contended, bool _optimistic)
+{
+    auto chain = createChain(_dbPath, 64, _keyPageSize);
+    if (!chain)
+    {
+        return {};
+    }
+    chain->executor->setOptimisticExecution(_optimistic);
+    // the deploy creates the flow of the token in block 1, execute the batch in a new block
+    if (!nextBlock(*chain))
+    {
+        releaseChain(*chain, _dbPath);
+        return {};
+    }
+    std::vector<ExecutionMessage::UniquePtr> messages;
+    for (size_t i = 0; i < _calls; ++i)
+    {
+        auto from = _contended ? account(0) : account(2 * i);
+        auto to = _contended ? account(i + 1) : account(2 * i + 1);
+        // transfer(address,uint256)
+        bytes data = {0xa9, 0x05, 0x9c, 0xbb};
+        data.resize(4 + 64, 0);
+        auto toBytes = fromHex(to);
+        std::copy(toBytes.begin(), toBytes.end(), data.begin() + 4 + 32 - toBytes.size());
+        data.back() = 1;
+        messages.emplace_back(
+            createMessage(chain->contextID++, from, chain->token, std::move(data), false));
+    }
+
+    Result result;
+    auto start = std::chrono::system_clock::now();
+    std::promise<std::vector<ExecutionMessage::UniquePtr>> promise;
+    chain->executor->dmcExecuteTransactions(chain->token, messages,
+        [&promise](Error::UniquePtr _error, std::vector<ExecutionMessage::UniquePtr> _outputs) {
+            if (_error)
+            {
+                std::cout << "execute failed, " << _error->errorMessage() << std::endl;
+            }
+            promise.set_value(std::move(_outputs));
+        });
+    auto outputs = promise.get_future().get();
+    result.time = elapsed(start);
+    result.failed = _calls - outputs.size();
+    for (auto& output : outputs)
+    {
+        if (output->type() != ExecutionMessage::FINISHED || output->status() != 0)
+        {
+            ++result.failed;
+        }
+    }
+
+    std::promise<crypto::HashType> hashPromise;
+    chain->executor->getHash(2, [&hashPromise](Error::UniquePtr, crypto::HashType _hash) {
+        hashPromise.set_value(_hash);
+    });
+    auto hash = hashPromise.get_future().get();
+    releaseChain(*chain, _dbPath);
+    return {result, hash};
+}
+
+// the block state is a StateStorage without the key pages, or a KeyPageStorage
+void optimisticBenchmark(const std::string& _dbPath, size_t _calls)
+{
+    std::cout << "calls=" << _calls << std::endl;
+    for (size_t keyPageSize : {0, 10240})
+    {
+        for (auto contended : {false, true})
+        {
+            auto [dmc, dmcHash] = dmcTransfers(_dbPath, _calls, keyPageSize, contended, false);
+            auto [optimistic, optimisticHash] =
+                dmcTransfers(_dbPath, _calls, keyPageSize, contended, true);
+            auto name = std::string(keyPageSize > 0 ? "keyPage " : "state   ") +
+                        (contended ? "contended  " : "uncontended");
+            print(name + " dmc       ", _calls, dmc);
+            print(name + " optimistic", _calls, optimistic);
+            std::cout << name << " same state: " << (dmcHash == optimisticHash ? "true" : "false")
+                      << std::endl;
+        }
+    }
+}
+
+int main(int argc, const char* argv[])
+{
+    boost::program_options::options_description main_options("Usage of executor benchmark");
+    main_options.add_options()("help,h", "print help information")("path,p",
+        boost::program_options::value<std::string>()->default_value("benchmark/executor/"),
+        "[RocksDB path]")("calls,n", boost::program_options::value<size_t>()->default_value(20000),
+        "token transfers")("accounts,a",
+        boost::program_options::value<size_t>()->default_value(1000), "token holders")(
+        "code,c", boost::program_options::value<size_t>()->default_value(8192),
+        "code size of the token")("batch,b",
+        boost::program_options::value<size_t>()->default_value(5000),
+        "token transfers of the DMC batch");
+    boost::program_options::variables_map vm;
+    try
+    {
+        boost::program_options::store(
+            boost::program_options::parse_command_line(argc, argv, main_options), vm);
+    }
+    catch (...)
+    {
+        std::cout << "invalid parameters" << std::endl;
+        std::cout << main_options << std::endl;
+        exit(0);
+    }
+    if (vm.count("help"))
+    {
+        std::cout << main_options << std::endl;
+        exit(0);
+    }
+    // the code size is limited by the max code size of the VM schedule
+    auto codeSize = std::min(vm["code"].as<size_t>(), (size_t)24576);
+    codeCacheBenchmark(vm["path"].as<std::string>(), vm["calls"].as<size_t>(),
+        std::max(vm["accounts"].as<size_t>(), (size_t)1), codeSize);
+    optimisticBenchmark(vm["path"].as<std::string>(), vm["batch"].as<size_t>());
+    return 0;
+}
@@ -0,0 +1,390 @@
+#include "bcos-scheduler/src/GraphKeyLocks.h"
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/depth_first_search.hpp>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <random>
+#include <variant>
+
+using namespace std;
+using namespace bcos;
+using namespace bcos::scheduler;
+
+namespace legacy
+{
+// the key locks kept in one graph of the key and context vertexes, the lookups scanned all the
+// edges before the locks were indexed by contract and by context
+class GraphKeyLocks
+{
+public:
+    using KeyLock = std::tuple<std::string, std::string>;
+    using KeyLockView = std::tuple<std::string_view, std::string_view>;
+
+    struct Vertex : public std::variant<ContextID, KeyLock>
+    {
+        using std::variant<ContextID, KeyLock>::variant;
+
+        bool operator==(const KeyLockView& rhs) const
+        {
+            if (index() != 1)
+            {
+                return false;
+            }
+            auto view = std::make_tuple(std::string_view(std::get<0>(std::get<1>(*this))),
+                std::string_view(std::get<1>(std::get<1>(*this))));
+            return view == rhs;
+        }
+    };
+
+    bool acquireKeyLock(
+        std::string_view contract, std::string_view key, ContextID contextID, Seq seq)
+    {
+        auto keyVertex = touchKeyLock(std::make_tuple(contract, key));
+        auto contextVertex = touchContext(contextID);
+        auto range = boost::out_edges(keyVertex, m_graph);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            auto vertex = boost::get(VertexPropertyTag(), boost::target(*it, m_graph));
+            if (std::get<0>(*vertex) != contextID)
+            {
+                addEdge(contextVertex, keyVertex, seq);
+                return false;
+            }
+        }
+        boost::remove_edge(contextVertex, keyVertex, m_graph);
+        addEdge(keyVertex, contextVertex, seq);
+        return true;
+    }
+
+    std::vector<std::string> getKeyLocksNotHoldingByContext(
+        std::string_view contract, ContextID excludeContextID) const
+    {
+        std::set<std::string> uniqueKeyLocks;
+        auto range = boost::edges(m_graph);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            auto sourceVertex = boost::get(VertexPropertyTag(), boost::source(*it, m_graph));
+            auto targetVertex = boost::get(VertexPropertyTag(), boost::target(*it, m_graph));
+            if (targetVertex->index() == 0 && std::get<0>(*targetVertex) != excludeContextID &&
+                sourceVertex->index() == 1 && std::get<0>(std::get<1>(*sourceVertex)) == contract)
+            {
+                uniqueKeyLocks.emplace(std::get<1>(std::get<1>(*sourceVertex)));
+            }
+        }
+        return std::vector<std::string>(uniqueKeyLocks.begin(), uniqueKeyLocks.end());
+    }
+
+    void releaseKeyLocks(ContextID contextID, Seq seq)
+    {
+        if (m_vertexes.count(Vertex(contextID)) == 0)
+        {
+            return;
+        }
+        auto vertex = touchContext(contextID);
+        auto edgeRemoveFunc = [seq, graph = &m_graph](auto range) mutable -> bool {
+            size_t total = 0;
+            size_t removed = 0;
+            for (auto next = range.first; range.first != range.second; range.first = next)
+            {
+                ++total;
+                ++next;
+                if (boost::get(EdgePropertyTag(), *range.first) == seq)
+                {
+                    ++removed;
+                    boost::remove_edge(*range.first, *graph);
+                }
+            }
+            return total == removed;
+        };
+        auto clearedIn = edgeRemoveFunc(boost::in_edges(vertex, m_graph));
+        auto clearedOut = edgeRemoveFunc(boost::out_edges(vertex, m_graph));
+        if (clearedIn && clearedOut)
+        {
+            boost::remove_vertex(vertex, m_graph);
+            m_vertexes.erase(contextID);
+        }
+    }
+
+    bool detectDeadLock(ContextID contextID);
+
+private:
+    struct VertexIterator
+    {
+        using kind = boost::vertex_property_tag;
+    };
+    using VertexProperty = boost::property<VertexIterator, const Vertex*>;
+    struct EdgeSeq
+    {
+        using kind = boost::edge_property_tag;
+    };
+    using EdgeProperty = boost::property<EdgeSeq, int64_t>;
+    using Graph = boost::adjacency_list<boost::multisetS, boost::multisetS, boost::bidirectionalS,
+        VertexProperty, EdgeProperty>;
+    using VertexPropertyTag = boost::property_map<Graph, VertexIterator>::const_type;
+    using EdgePropertyTag = boost::property_map<Graph, EdgeSeq>::const_type;
+    using VertexID = Graph::vertex_descriptor;
+    using EdgeID = Graph::edge_descriptor;
+
+    VertexID touchContext(ContextID contextID)
+    {
+        auto [it, inserted] = m_vertexes.emplace(Vertex(contextID), VertexID());
+        if (inserted)
+        {
+            it->second = boost::add_vertex(&(it->first), m_graph);
+        }
+        return it->second;
+    }
+
+    VertexID touchKeyLock(KeyLockView keyLockView)
+    {
+        auto it = m_vertexes.lower_bound(keyLockView);
+        if (it != m_vertexes.end() && it->first == keyLockView)
+        {
+            return it->second;
+        }
+        auto inserted = m_vertexes.emplace_hint(it,
+            Vertex(std::make_tuple(
+                std::string(std::get<0>(keyLockView)), std::string(std::get<1>(keyLockView)))),
+            VertexID());
+        inserted->second = boost::add_vertex(&(inserted->first), m_graph);
+        return inserted->second;
+    }
+
+    void addEdge(VertexID source, VertexID target, Seq seq)
+    {
+        auto range = boost::edge_range(source, target, m_graph);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (boost::get(EdgePropertyTag(), *it) == seq)
+            {
+                return;
+            }
+        }
+        boost::add_edge(source, target, seq, m_graph);
+    }
+
+    Graph m_graph;
+    std::map<Vertex, VertexID, std::less<>> m_vertexes;
+};
+
+inline bool operator<(const GraphKeyLocks::Vertex& lhs, const GraphKeyLocks::KeyLockView& rhs)
+{
+    if (lhs.index() != 1)
+    {
+        return true;
+    }
+    auto view = std::make_tuple(std::string_view(std::get<0>(std::get<1>(lhs))),
+        std::string_view(std::get<1>(std::get<1>(lhs))));
+    return view < rhs;
+}
+
+inline bool operator<(const GraphKeyLocks::KeyLockView& lhs, const GraphKeyLocks::Vertex& rhs)
+{
+    if (rhs.index() != 1)
+    {
+        return false;
+    }
+    auto view = std::make_tuple(std::string_view(std::get<0>(std::get<1>(rhs))),
+        std::string_view(std::get<1>(std::get<1>(rhs))));
+    return lhs < view;
+}
+
+bool GraphKeyLocks::detectDeadLock(ContextID contextID)
+{
+    struct GraphVisitor : public boost::default_dfs_visitor
+    {
+        GraphVisitor(bool& backEdge) : m_backEdge(backEdge) {}
+        void back_edge(EdgeID, const Graph&) const { m_backEdge = true; }
+        bool& m_backEdge;
+    };
+    auto it = m_vertexes.find(Vertex(contextID));
+    if (it == m_vertexes.end() || boost::in_degree(it->second, m_graph) == 0)
+    {
+        return false;
+    }
+    std::map<VertexID, boost::default_color_type> vertexColors;
+    bool hasDeadLock = false;
+    boost::depth_first_visit(m_graph, it->second, GraphVisitor(hasDeadLock),
+        boost::make_assoc_property_map(vertexColors),
+        [&hasDeadLock](VertexID, const Graph&) { return hasDeadLock; });
+    return hasDeadLock;
+}
+}  // namespace legacy
+
+struct Result
+{
+    int64_t acquire = 0;
+    int64_t lookup = 0;
+    int64_t release = 0;
+    int64_t detect = 0;
+    // the checksum of the acquired locks and the found keys, differs once the reverts differ
+    size_t checksum = 0;
+    size_t reverts = 0;
+};
+
+int64_t elapsed(std::chrono::system_clock::time_point _start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now() - _start)
+        .count();
+}
+
+// the legacy scheduler reverts the first locked context reaching a dead lock every round
+std::vector<ContextID> deadLockContexts(
+    legacy::GraphKeyLocks& _keyLocks, std::vector<ContextID> const& _locked)
+{
+    for (auto context : _locked)
+    {
+        if (_keyLocks.detectDeadLock(context))
+        {
+            return {context};
+        }
+    }
+    return {};
+}
+
+// the victims of all the dead locks are reverted in the same round
+std::vector<ContextID> deadLockContexts(
+    GraphKeyLocks& _keyLocks, std::vector<ContextID> const& _locked)
+{
+    std::vector<ContextID> contexts;
+    for (auto context : _locked)
+    {
+        if (_keyLocks.isDeadLockVictim(context))
+        {
+            contexts.push_back(context);
+        }
+    }
+    return contexts;
+}
+
+// the DMC rounds of a block: every context acquires the keys of its current call, the messages
+// sent to the executors query the locks of the other contexts, the contexts release the locks of
+// the finished calls and the locked contexts are checked for the dead locks
+template <class KeyLocks>
+Result dmcRounds(size_t _contexts, size_t _contracts, size_t _keys, size_t _keysPerCall,
+    size_t _rounds, size_t _holdRounds)
+{
+    KeyLocks keyLocks;
+    Result result;
+    std::mt19937 random(0);
+    std::vector<std::string> contracts;
+    for (size_t i = 0; i < _contracts; ++i)
+    {
+        contracts.emplace_back("contract" + std::to_string(i));
+    }
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < _keys; ++i)
+    {
+        keys.emplace_back("key" + std::to_string(i));
+    }
+    std::vector<ContextID> locked;
+    for (size_t round = 0; round < _rounds; ++round)
+    {
+        auto seq = (Seq)round;
+        locked.clear();
+        auto start = std::chrono::system_clock::now();
+        for (size_t context = 0; context < _contexts; ++context)
+        {
+            auto const& contract = contracts[random() % _contracts];
+            for (size_t i = 0; i < _keysPerCall; ++i)
+            {
+                if (!keyLocks.acquireKeyLock(contract, keys[random() % _keys], context, seq))
+                {
+                    locked.push_back(context);
+                    break;
+                }
+                result.checksum++;
+            }
+        }
+        result.acquire += elapsed(start);
+
+        start = std::chrono::system_clock::now();
+        for (size_t context = 0; context < _contexts; ++context)
+        {
+            auto const& contract = contracts[random() % _contracts];
+            result.checksum += keyLocks.getKeyLocksNotHoldingByContext(contract, context).size();
+        }
+        result.lookup += elapsed(start);
+
+        start = std::chrono::system_clock::now();
+        for (auto context : deadLockContexts(keyLocks, locked))
+        {
+            // revert the context like the scheduler does
+            result.reverts++;
+            for (Seq s = 0; s <= seq; ++s)
+            {
+                keyLocks.releaseKeyLocks(context, s);
+            }
+        }
+        result.detect += elapsed(start);
+
+        start = std::chrono::system_clock::now();
+        if (round >= _holdRounds)
+        {
+            for (size_t context = 0; context < _contexts; ++context)
+            {
+                keyLocks.releaseKeyLocks(context, (Seq)(round - _holdRounds));
+            }
+        }
+        result.release += elapsed(start);
+    }
+    return result;
+}
+
+void print(const std::string& _name, Result const& _result)
+{
+    std::cout << _name << ": total="
+              << (_result.acquire + _result.lookup + _result.release + _result.detect) / 1000.0
+              << "ms|acquire=" << _result.acquire / 1000.0
+              << "ms|lookup=" << _result.lookup / 1000.0
+              << "ms|release=" << _result.release / 1000.0
+              << "ms|detect=" << _result.detect / 1000.0 << "ms|reverts=" << _result.reverts
+              << std::endl;
+}
+
+int main(int argc, const char* argv[])
+{
+    boost::program_options::options_description main_options("Usage of key locks benchmark");
+    main_options.add_options()("help,h", "print help information")("contexts,t",
+        boost::program_options::value<size_t>()->default_value(1000), "transactions of the block")(
+        "contracts,c", boost::program_options::value<size_t>()->default_value(10), "contracts")(
+        "keys,k", boost::program_options::value<size_t>()->default_value(10000),
+        "keys of every contract")("call,l",
+        boost::program_options::value<size_t>()->default_value(4), "keys acquired by every call")(
+        "rounds,r", boost::program_options::value<size_t>()->default_value(20), "DMC rounds")(
+        "hold,d", boost::program_options::value<size_t>()->default_value(3),
+        "rounds a call holds its locks");
+    boost::program_options::variables_map vm;
+    try
+    {
+        boost::program_options::store(
+            boost::program_options::parse_command_line(argc, argv, main_options), vm);
+    }
+    catch (...)
+    {
+        std::cout << "invalid parameters" << std::endl;
+        std::cout << main_options << std::endl;
+        exit(0);
+    }
+    if (vm.count("help"))
+    {
+        std::cout << main_options << std::endl;
+        exit(0);
+    }
+    auto contexts = vm["contexts"].as<size_t>();
+    auto contracts = std::max(vm["contracts"].as<size_t>(), (size_t)1);
+    auto keys = std::max(vm["keys"].as<size_t>(), (size_t)1);
+    auto call = vm["call"].as<size_t>();
+    auto rounds = vm["rounds"].as<size_t>();
+    auto hold = vm["hold"].as<size_t>();
+
+    auto graph = dmcRounds<legacy::GraphKeyLocks>(contexts, contracts, keys, call, rounds, hold);
+    auto indexed = dmcRounds<GraphKeyLocks>(contexts, contracts, keys, call, rounds, hold);
+    std::cout << "contexts=" << contexts << "|contracts=" << contracts << "|keys=" << keys
+              << "|rounds=" << rounds
+              << "|same=" << (graph.checksum == indexed.checksum ? "true" : "false") << std::endl;
+    print("graph  ", graph);
+    print("indexed", indexed);
+    return 0;
+}
@@ -0,0 +1,188 @@
+#include "bcos-crypto/hash/Keccak256.h"
+#include "bcos-crypto/interfaces/crypto/CryptoSuite.h"
+#include "bcos-protocol/MerkleTree.h"
+#include <bcos-utilities/DataConvertUtility.h>
+#include <tbb/concurrent_unordered_map.h>
+#include <tbb/parallel_for.h>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <map>
+#include <mutex>
+
+using namespace std;
+using namespace bcos;
+using namespace bcos::crypto;
+using namespace bcos::protocol;
+
+namespace legacy
+{
+// the parent to children maps of the hex nodes, the ledger collected the proofs from them before
+// the merkle tree was stored in the hash array
+using Parent2ChildListMap = std::map<std::string, std::vector<std::string>>;
+using Child2ParentMap = tbb::concurrent_unordered_map<std::string, std::string>;
+const size_t c_width = 16;
+
+void calculateMerkleProof(CryptoSuite::Ptr const& _cryptoSuite, std::vector<bytes> _nodes,
+    Parent2ChildListMap& _parent2ChildList)
+{
+    std::mutex mapMutex;
+    while (_nodes.size() > 1)
+    {
+        std::vector<bytes> parents((_nodes.size() + c_width - 1) / c_width);
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, parents.size()),
+            [&](const tbb::blocked_range<size_t>& _r) {
+                for (size_t i = _r.begin(); i < _r.end(); ++i)
+                {
+                    bytes data;
+                    std::vector<bytes> children;
+                    auto end = std::min((i + 1) * c_width, _nodes.size());
+                    for (size_t j = i * c_width; j < end; ++j)
+                    {
+                        data.insert(data.end(), _nodes[j].begin(), _nodes[j].end());
+                        children.push_back(_nodes[j]);
+                    }
+                    parents[i] = _cryptoSuite->hash(data).asBytes();
+                    std::lock_guard<std::mutex> l(mapMutex);
+                    auto parent = *toHexString(parents[i]);
+                    for (auto const& child : children)
+                    {
+                        _parent2ChildList[parent].emplace_back(*toHexString(child));
+                    }
+                }
+            });
+        _nodes = std::move(parents);
+    }
+    _parent2ChildList[*toHexString(_cryptoSuite->hash(_nodes[0]).asBytes())].push_back(
+        *toHexString(_nodes[0]));
+}
+
+Child2ParentMap getChild2Parent(Parent2ChildListMap const& _parent2Child)
+{
+    Child2ParentMap child2Parent;
+    for (auto const& [parent, children] : _parent2Child)
+    {
+        for (auto const& child : children)
+        {
+            child2Parent.insert({child, parent});
+        }
+    }
+    return child2Parent;
+}
+
+bcos::ledger::MerkleProof makeMerkleProof(HashType const& _leaf,
+    Parent2ChildListMap const& _parent2Child, Child2ParentMap const& _child2Parent)
+{
+    bcos::ledger::MerkleProof proof;
+    std::string node = _leaf.hex();
+    for (auto it = _child2Parent.find(node); it != _child2Parent.end();
+         it = _child2Parent.find(node))
+    {
+        auto const& children = _parent2Child.at(it->second);
+        auto index = std::find(children.begin(), children.end(), node);
+        proof.emplace_back(std::vector<std::string>(children.begin(), index),
+            std::vector<std::string>(std::next(index), children.end()));
+        node = it->second;
+    }
+    return proof;
+}
+}  // namespace legacy
+
+int64_t elapsed(std::chrono::system_clock::time_point _start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now() - _start)
+        .count();
+}
+
+// the root and proof generation of the string map and the hash array merkle trees
+void benchmark(CryptoSuite::Ptr const& _cryptoSuite, size_t _leavesSize, size_t _proofs)
+{
+    std::vector<HashType> leaves(_leavesSize);
+    std::vector<bytes> leavesBytes(_leavesSize);
+    for (size_t i = 0; i < _leavesSize; ++i)
+    {
+        leaves[i] = _cryptoSuite->hash(std::to_string(i));
+        leavesBytes[i] = leaves[i].asBytes();
+    }
+    _proofs = std::min(_proofs, _leavesSize);
+    auto step = std::max(_leavesSize / _proofs, (size_t)1);
+
+    auto start = std::chrono::system_clock::now();
+    legacy::Parent2ChildListMap parent2Child;
+    legacy::calculateMerkleProof(_cryptoSuite, leavesBytes, parent2Child);
+    auto child2Parent = legacy::getChild2Parent(parent2Child);
+    auto legacyBuild = elapsed(start);
+    start = std::chrono::system_clock::now();
+    std::vector<bcos::ledger::MerkleProof> legacyProofs;
+    for (size_t i = 0; i < _proofs; ++i)
+    {
+        legacyProofs.emplace_back(
+            legacy::makeMerkleProof(leaves[i * step], parent2Child, child2Parent));
+    }
+    auto legacyProof = elapsed(start);
+
+    start = std::chrono::system_clock::now();
+    auto root = MerkleTree::calculateRoot(_cryptoSuite, leaves);
+    auto rootOnly = elapsed(start);
+    start = std::chrono::system_clock::now();
+    MerkleTree tree(_cryptoSuite, leaves);
+    auto build = elapsed(start);
+    start = std::chrono::system_clock::now();
+    std::vector<bcos::ledger::MerkleProofPtr> proofs;
+    for (size_t i = 0; i < _proofs; ++i)
+    {
+        proofs.emplace_back(tree.proof(leaves[i * step]));
+    }
+    auto proof = elapsed(start);
+
+    bool same = (root == tree.root());
+    for (size_t i = 0; i < _proofs; ++i)
+    {
+        same = same && proofs[i] && *proofs[i] == legacyProofs[i] &&
+               MerkleTree::verify(_cryptoSuite, *proofs[i], leaves[i * step], root);
+    }
+    std::cout << "leaves=" << _leavesSize << "|proofs=" << _proofs
+              << "|same=" << (same ? "true" : "false") << std::endl
+              << "string map : build=" << legacyBuild / 1000.0
+              << "ms|proof=" << legacyProof / 1000.0 << "ms" << std::endl
+              << "hash array : root=" << rootOnly / 1000.0 << "ms|build=" << build / 1000.0
+              << "ms|proof=" << proof / 1000.0 << "ms" << std::endl;
+}
+
+int main(int argc, const char* argv[])
+{
+    boost::program_options::options_description main_options("Usage of merkle benchmark");
+    main_options.add_options()("help,h", "print help information")("leaves,l",
+        boost::program_options::value<std::vector<size_t>>()->multitoken()->default_value(
+            {10000, 100000}, "10000 100000"),
+        "leaves of the merkle trees")("proofs,p",
+        boost::program_options::value<size_t>()->default_value(1000), "proofs of every tree");
+    boost::program_options::variables_map vm;
+    try
+    {
+        boost::program_options::store(
+            boost::program_options::parse_command_line(argc, argv, main_options), vm);
+    }
+    catch (...)
+    {
+        std::cout << "invalid parameters" << std::endl;
+        std::cout << main_options << std::endl;
+        exit(0);
+    }
+    if (vm.count("help"))
+    {
+        std::cout << main_options << std::endl;
+        exit(0);
+    }
+    auto cryptoSuite =
+        std::make_shared<CryptoSuite>(std::make_shared<Keccak256>(), nullptr, nullptr);
+    auto proofs = std::max(vm["proofs"].as<size_t>(), (size_t)1);
+    for (auto leavesSize : vm["leaves"].as<std::vector<size_t>>())
+    {
+        if (leavesSize > 0)
+        {
+            benchmark(cryptoSuite, leavesSize, proofs);
+        }
+    }
+    return 0;
+}
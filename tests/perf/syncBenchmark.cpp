@@ -0,0 +1,224 @@
+#include "bcos-crypto/hash/Keccak256.h"
+#include "bcos-crypto/interfaces/crypto/CryptoSuite.h"
+#include "bcos-crypto/signature/secp256k1/Secp256k1Crypto.h"
+#include "bcos-framework/interfaces/ledger/LedgerTypeDef.h"
+#include "bcos-ledger/src/libledger/Ledger.h"
+#include "bcos-protocol/protobuf/PBBlockFactory.h"
+#include "bcos-protocol/protobuf/PBBlockHeaderFactory.h"
+#include "bcos-protocol/protobuf/PBTransactionFactory.h"
+#include "bcos-protocol/protobuf/PBTransactionReceiptFactory.h"
+#include "bcos-storage/src/RocksDBStorage.h"
+#include "bcos-table/src/StateStorage.h"
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <future>
+
+using namespace std;
+using namespace bcos;
+using namespace bcos::crypto;
+using namespace bcos::protocol;
+using namespace bcos::ledger;
+using namespace bcos::storage;
+
+int64_t elapsed(std::chrono::system_clock::time_point _start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now() - _start)
+        .count();
+}
+
+BlockFactory::Ptr createBlockFactory()
+{
+    auto cryptoSuite = std::make_shared<CryptoSuite>(
+        std::make_shared<Keccak256>(), std::make_shared<Secp256k1Crypto>(), nullptr);
+    return std::make_shared<PBBlockFactory>(std::make_shared<PBBlockHeaderFactory>(cryptoSuite),
+        std::make_shared<PBTransactionFactory>(cryptoSuite),
+        std::make_shared<PBTransactionReceiptFactory>(cryptoSuite));
+}
+
+bool buildGenesis(BlockFactory::Ptr _blockFactory, std::shared_ptr<Ledger> _ledger)
+{
+    auto config = std::make_shared<LedgerConfig>();
+    config->setBlockNumber(0);
+    config->setBlockTxCountLimit(1000);
+    auto signImpl = _blockFactory->cryptoSuite()->signatureImpl();
+    consensus::ConsensusNodeList consensusNodeList;
+    consensusNodeList.emplace_back(
+        std::make_shared<consensus::ConsensusNode>(signImpl->generateKeyPair()->publicKey(), 1));
+    config->setConsensusNodeList(consensusNodeList);
+    return _ledger->buildGenesisBlock(config, 3000000000, "", RC4_VERSION_STR);
+}
+
+Block::Ptr fakeBlock(BlockFactory::Ptr _blockFactory, BlockNumber _number,
+    HashType const& _parentHash, size_t _txsNum)
+{
+    auto block = _blockFactory->createBlock();
+    auto header = _blockFactory->blockHeaderFactory()->createBlockHeader();
+    header->setNumber(_number);
+    header->setParentInfo(ParentInfoList{{_number - 1, _parentHash}});
+    block->setBlockHeader(header);
+    auto keyPair = _blockFactory->cryptoSuite()->signatureImpl()->generateKeyPair();
+    auto to = std::string(20, 'a');
+    auto input = asBytes(std::string(128, 'i'));
+    for (size_t i = 0; i < _txsNum; ++i)
+    {
+        auto tx = _blockFactory->transactionFactory()->createTransaction(0, to, input,
+            u256(_number * _txsNum + i), 1000, "chain0", "group0", utcTime(), keyPair);
+        auto receipt = _blockFactory->receiptFactory()->createReceipt(u256(21000), to,
+            std::make_shared<std::vector<LogEntry>>(), 0, bytes(64, 'o'), _number);
+        block->appendTransactionMetaData(
+            _blockFactory->createTransactionMetaData(tx->hash(), std::string()));
+        block->appendTransaction(std::move(tx));
+        block->appendReceipt(std::move(receipt));
+    }
+    return block;
+}
+
+// write the blocks into the rocksdb like the scheduler does
+bool writeBlocks(BlockFactory::Ptr _blockFactory, RocksDBStorage::Ptr _rocksDBStorage,
+    BlockNumber _blocks, size_t _txsNum)
+{
+    auto ledger = std::make_shared<Ledger>(_blockFactory, _rocksDBStorage);
+    if (!buildGenesis(_blockFactory, ledger))
+    {
+        std::cout << "build genesis failed" << std::endl;
+        return false;
+    }
+    HashType parentHash;
+    for (BlockNumber number = 1; number <= _blocks; ++number)
+    {
+        auto block = fakeBlock(_blockFactory, number, parentHash, _txsNum);
+        parentHash = block->blockHeader()->hash();
+        auto txsData = std::make_shared<std::vector<bytesConstPtr>>();
+        auto txsHash = std::make_shared<HashList>();
+        for (size_t i = 0; i < block->transactionsSize(); ++i)
+        {
+            auto tx = block->transaction(i);
+            auto data = tx->encode();
+            txsData->emplace_back(std::make_shared<bytes>(data.begin(), data.end()));
+            txsHash->emplace_back(tx->hash());
+        }
+        std::promise<Error::Ptr> storePromise;
+        ledger->asyncStoreTransactions(txsData, txsHash,
+            [&storePromise](Error::Ptr _error) { storePromise.set_value(std::move(_error)); });
+        auto error = storePromise.get_future().get();
+
+        auto stateStorage = std::make_shared<StateStorage>(_rocksDBStorage);
+        std::promise<Error::Ptr> prewritePromise;
+        ledger->asyncPrewriteBlock(stateStorage, nullptr, block,
+            [&prewritePromise](Error::Ptr&& _error) { prewritePromise.set_value(_error); });
+        error = error ? error : prewritePromise.get_future().get();
+        if (error)
+        {
+            std::cout << "write block " << number << " failed, " << error->errorMessage()
+                      << std::endl;
+            return false;
+        }
+        TwoPCParams params;
+        params.number = number;
+        _rocksDBStorage->asyncPrepare(params, *stateStorage, [](Error::Ptr, uint64_t) {});
+        _rocksDBStorage->asyncCommit(params, [](Error::Ptr, uint64_t) {});
+    }
+    return true;
+}
+
+// the time of serving the blocks to a syncing peer, block by block and by the range read
+void benchmark(const std::string& _dbPath, BlockNumber _blocks, size_t _txsNum)
+{
+    boost::filesystem::remove_all(_dbPath);
+    boost::filesystem::create_directories(_dbPath);
+    rocksdb::Options options;
+    options.create_if_missing = true;
+    rocksdb::DB* db;
+    auto s = rocksdb::DB::Open(options, _dbPath, &db);
+    if (!s.ok())
+    {
+        std::cout << "open db failed, " << s.ToString() << std::endl;
+        return;
+    }
+    auto rocksDBStorage =
+        std::make_shared<RocksDBStorage>(std::unique_ptr<rocksdb::DB>(db), nullptr);
+    auto blockFactory = createBlockFactory();
+    auto start = std::chrono::system_clock::now();
+    if (!writeBlocks(blockFactory, rocksDBStorage, _blocks, _txsNum))
+    {
+        return;
+    }
+    auto write = elapsed(start);
+    int32_t flag = HEADER | TRANSACTIONS;
+
+    // the new ledgers have empty caches, the blocks are read from the rocksdb
+    auto ledger = std::make_shared<Ledger>(blockFactory, rocksDBStorage);
+    start = std::chrono::system_clock::now();
+    size_t perNumberTxs = 0;
+    for (BlockNumber number = 1; number <= _blocks; ++number)
+    {
+        std::promise<Block::Ptr> promise;
+        ledger->asyncGetBlockDataByNumber(number, flag,
+            [&promise](Error::Ptr, Block::Ptr _block) { promise.set_value(std::move(_block)); });
+        auto block = promise.get_future().get();
+        perNumberTxs += block ? block->transactionsSize() : 0;
+    }
+    auto perNumber = elapsed(start);
+
+    ledger = std::make_shared<Ledger>(blockFactory, rocksDBStorage);
+    start = std::chrono::system_clock::now();
+    size_t rangeTxs = 0;
+    std::promise<void> promise;
+    ledger->asyncGetBlockDataByRange(
+        1, _blocks, flag, [&](Error::Ptr _error, BlocksPtr blocks, bool _finished) {
+            for (size_t i = 0; !_error && i < blocks->size(); ++i)
+            {
+                rangeTxs += blocks->at(i)->transactionsSize();
+            }
+            if (_finished)
+            {
+                promise.set_value();
+            }
+        });
+    promise.get_future().get();
+    auto range = elapsed(start);
+
+    auto expectedTxs = _blocks * _txsNum;
+    std::cout << "blocks=" << _blocks << "|txsPerBlock=" << _txsNum
+              << "|write=" << write / 1000.0 << "ms" << std::endl
+              << "per number : " << perNumber / 1000.0 << "ms|"
+              << _blocks * 1000000.0 / std::max(perNumber, (int64_t)1) << " blocks/s|txs="
+              << perNumberTxs << "/" << expectedTxs << std::endl
+              << "range      : " << range / 1000.0 << "ms|"
+              << _blocks * 1000000.0 / std::max(range, (int64_t)1) << " blocks/s|txs=" << rangeTxs
+              << "/" << expectedTxs << std::endl;
+    rocksDBStorage.reset();
+    boost::filesystem::remove_all(_dbPath);
+}
+
+int main(int argc, const char* argv[])
+{
+    boost::program_options::options_description main_options("Usage of sync benchmark");
+    main_options.add_options()("help,h", "print help information")("path,p",
+        boost::program_options::value<std::string>()->default_value("benchmark/sync/"),
+        "[RocksDB path]")("blocks,b", boost::program_options::value<int64_t>()->default_value(500),
+        "blocks to serve")("txs,t", boost::program_options::value<size_t>()->default_value(100),
+        "transactions of every block");
+    boost::program_options::variables_map vm;
+    try
+    {
+        boost::program_options::store(
+            boost::program_options::parse_command_line(argc, argv, main_options), vm);
+    }
+    catch (...)
+    {
+        std::cout << "invalid parameters" << std::endl;
+        std::cout << main_options << std::endl;
+        exit(0);
+    }
+    if (vm.count("help"))
+    {
+        std::cout << main_options << std::endl;
+        exit(0);
+    }
+    auto blocks = std::max(vm["blocks"].as<int64_t>(), (int64_t)1);
+    benchmark(vm["path"].as<std::string>(), blocks, vm["txs"].as<size_t>());
+    return 0;
+}
@@ -1095,6 +1095,19 @@ generate_common_ini() {
     enable_cache=true
     ; The granularity of the storage page, in bytes, must not be less than 4096 Bytes, the default is 10240 Bytes (10KB)
     key_page_size=${key_page_size}
+    ; the block cache of rocksdb shared by all column families, in MB
+    ;block_cache_size=512
+    ; the bits of the bloom filter of every key, 0 to disable the bloom filter
+    ;bloom_bits_per_key=10
+    ; filter the prefix scan of a table by the bloom filter of the table name
+    ;prefix_bloom=true
+    ; pin the index and filter blocks of the L0 files in the block cache
+    ;pin_l0_filter_and_index=true
+    ; compress the large values by zstd, only takes effect for the node created with it
+    ;compress_value=false
+    ; the values not smaller than the threshold are compressed, in bytes
+    ;compress_threshold=1024
+    ;compress_level=3
 
 [txpool]
     ; size of the txpool, default is 15000
@@ -1103,8 +1116,19 @@ generate_common_ini() {
     notify_worker_num=2
     ; txs verification threads num, default is the number of CPU cores
     ;verify_worker_num=2
+    ; the txs are sharded by the tx hash to reduce the lock contention, default is 16
+    ;shards_num=16
     ; txs expiration time, in seconds, default is 10 minutes
     txs_expiration_time = 600
+    ; the seal order of the txs, import_time or priority, default is import_time
+    ; seal_order = import_time
+    ; the priority of the senders, the txs of the higher priority senders are sealed first
+    ; priority_senders = address1:10,address2:5
+
+[executor]
+    ; execute the transactions of the contracts in parallel optimistically before the DMC
+    ; rounds, the results are the same as the serial execution
+    ;enable_optimistic_execution=false
 
 [log]
     enable=true